@@ -0,0 +1,34 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Base.h>
+#include <ply-runtime/time/CPUTimer.h>
+
+namespace ply {
+
+// Calls prepare() then run() numRuns times, timing only run(), and prints the fastest time.
+template <typename Prepare, typename Run>
+PLY_NO_INLINE void measure(StringWriter* sw, StringView name, u32 numRuns, const Prepare& prepare,
+                           const Run& run) {
+    CPUTimer::Converter converter;
+    float bestSeconds = Limits<float>::Max;
+    for (u32 i = 0; i < numRuns; i++) {
+        prepare();
+        CPUTimer::Point start = CPUTimer::get();
+        run();
+        bestSeconds = min(bestSeconds, converter.toSeconds(CPUTimer::get() - start));
+    }
+    sw->format("{}: {} ms\n", name, bestSeconds * 1000.f);
+    sw->flushMem();
+}
+
+void benchHash(StringWriter* sw);
+void benchNumbers(StringWriter* sw);
+void benchPersist(StringWriter* sw);
+void benchPylon(StringWriter* sw);
+void benchSort(StringWriter* sw);
+void benchStringView(StringWriter* sw);
+
+} // namespace ply
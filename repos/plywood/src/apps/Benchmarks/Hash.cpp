@@ -0,0 +1,42 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <Benchmark.h>
+#include <ply-runtime/container/Hash.h>
+#include <ply-runtime/algorithm/Random.h>
+
+namespace ply {
+
+void benchHash(StringWriter* sw) {
+    // Hash the same total number of bytes for each key length
+    static constexpr u32 TotalBytes = 64 << 20;
+    static constexpr u32 NumRuns = 5;
+
+    Buffer data = Buffer::allocate(TotalBytes);
+    Random r{1};
+    for (u32 i = 0; i < TotalBytes; i++) {
+        data.bytes[i] = r.next8();
+    }
+
+    for (u32 keyLength : {8, 16, 32, 100, 1024, 65536}) {
+        u32 numKeys = TotalBytes / keyLength;
+        u32 check = 0;
+        measure(sw, String::format("appendBuffer, {}-byte keys", keyLength), NumRuns, [] {}, [&] {
+            for (u32 i = 0; i < numKeys; i++) {
+                Hasher hasher;
+                hasher.appendBuffer(data.bytes + i * keyLength, keyLength);
+                check += hasher.result();
+            }
+        });
+        measure(sw, String::format("hashBuffer, {}-byte keys", keyLength), NumRuns, [] {}, [&] {
+            for (u32 i = 0; i < numKeys; i++) {
+                check += Hasher::hashBuffer(data.bytes + i * keyLength, keyLength);
+            }
+        });
+        // Print the checksum so that the compiler can't discard the work
+        sw->format("(checksum {})\n", check);
+    }
+}
+
+} // namespace ply
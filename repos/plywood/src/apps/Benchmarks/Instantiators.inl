@@ -0,0 +1,10 @@
+// ply instantiate Benchmarks
+void inst_Benchmarks(TargetInstantiatorArgs* args) {
+    args->buildTarget->targetType = BuildTargetType::EXE;
+    args->addSourceFiles(".", false);
+    args->addIncludeDir(Visibility::Private, ".");
+    args->addTarget(Visibility::Private, "runtime");
+    args->addTarget(Visibility::Private, "reflect");
+    args->addTarget(Visibility::Private, "plytool-client");
+    args->addTarget(Visibility::Private, "pylon");
+}
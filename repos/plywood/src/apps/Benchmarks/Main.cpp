@@ -0,0 +1,40 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <Benchmark.h>
+#include <ply-runtime/io/StdIO.h>
+
+using namespace ply;
+
+struct Benchmark {
+    StringView name;
+    void (*func)(StringWriter* sw);
+};
+
+static const Benchmark Benchmarks[] = {
+    {"hash", benchHash},
+    {"numbers", benchNumbers},
+    {"persist", benchPersist},
+    {"pylon", benchPylon},
+    {"sort", benchSort},
+    {"stringview", benchStringView},
+};
+
+// Runs the benchmarks named on the command line, or all of them if none are named.
+int main(int argc, char* argv[]) {
+    StringWriter sw = StdOut::createStringWriter();
+    for (const Benchmark& benchmark : Benchmarks) {
+        bool selected = (argc <= 1);
+        for (int i = 1; i < argc; i++) {
+            if (benchmark.name == argv[i]) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            sw << "---- " << benchmark.name << " ----\n";
+            benchmark.func(&sw);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,315 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <Benchmark.h>
+#include <ply-runtime/algorithm/Random.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace ply {
+
+//---------------------------------------------------
+// Copies of the digit-at-a-time loops that the integer and double printers and parsers used before
+// they were rewritten.
+//---------------------------------------------------
+static PLY_INLINE u8 oldToDigit(u32 d) {
+    return (d <= 35) ? "0123456789abcdefghijklmnopqrstuvwxyz"[d] : '?';
+}
+
+static PLY_NO_INLINE void oldPrintU64(OutStream* outs, u64 value, u32 radix) {
+    u8 digitBuffer[64];
+    s32 digitIndex = PLY_STATIC_ARRAY_SIZE(digitBuffer);
+    if (value == 0) {
+        digitBuffer[--digitIndex] = '0';
+    } else {
+        while (value > 0) {
+            u64 quotient = value / radix;
+            u32 digit = u32(value - quotient * radix);
+            digitBuffer[--digitIndex] = oldToDigit(digit);
+            value = quotient;
+        }
+    }
+    outs->write({digitBuffer + digitIndex, (u32) PLY_STATIC_ARRAY_SIZE(digitBuffer) - digitIndex});
+}
+
+// Prints three fractional digits, or four significant digits in scientific notation. The result
+// doesn't read back as the same value.
+static PLY_NO_INLINE void oldPrintDouble(OutStream* outs, double value, u32 radix) {
+    if (value < 0) {
+        value = -value;
+        outs->writeByte('-');
+    }
+    u32 radix3 = radix * radix * radix;
+    u32 radix6 = radix3 * radix3;
+    if (value == 0.0 || (value * radix3 > radix && value < radix6)) {
+        u64 fixedPoint = u64(value * radix3);
+        oldPrintU64(outs, fixedPoint / radix3, radix);
+        outs->writeByte('.');
+        u64 fractionalPart = fixedPoint % radix3;
+        u8 digitBuffer[3];
+        for (s32 i = 2; i >= 0; i--) {
+            u64 quotient = fractionalPart / radix;
+            digitBuffer[i] = oldToDigit(u32(fractionalPart - quotient * radix));
+            fractionalPart = quotient;
+        }
+        outs->write({digitBuffer, PLY_STATIC_ARRAY_SIZE(digitBuffer)});
+    } else {
+        double exponent = floor(log(value) / log(radix));
+        double m = value / pow(radix, exponent);
+        s32 digit = clamp<s32>((s32) floor(m), 1, radix - 1);
+        outs->writeByte(oldToDigit(digit));
+        outs->writeByte('.');
+        for (u32 i = 0; i < 3; i++) {
+            m = (m - digit) * radix;
+            digit = clamp<s32>((s32) floor(m), 0, radix - 1);
+            outs->writeByte(oldToDigit(digit));
+        }
+        outs->writeByte('e');
+        if (exponent < 0) {
+            outs->writeByte('-');
+            exponent = -exponent;
+        }
+        oldPrintU64(outs, (u64) exponent, radix);
+    }
+}
+
+static PLY_NO_INLINE u64 oldParseU64(InStream* ins, u32 radix) {
+    u64 result = 0;
+    bool anyDigits = false;
+    bool overflow = false;
+    while (ins->tryMakeBytesAvailable()) {
+        u8 digit = fmt::DigitTable[(u8) ins->peekByte()];
+        if (digit >= radix)
+            break;
+        ins->advanceByte();
+        u64 withNextDigit = result * radix + digit;
+        if (withNextDigit < result) {
+            overflow = true;
+        }
+        result = withNextDigit;
+        anyDigits = true;
+    }
+    if (!anyDigits || overflow) {
+        ins->status.parseError = 1;
+        return 0;
+    }
+    return result;
+}
+
+static PLY_NO_INLINE double oldReadDoubleComponent(InStream* ins, u32 radix, bool* anyDigits) {
+    double value = 0.0;
+    double dr = (double) radix;
+    while (ins->tryMakeBytesAvailable()) {
+        u8 digit = fmt::DigitTable[(u8) ins->peekByte()];
+        if (digit >= radix)
+            break;
+        ins->advanceByte();
+        value = value * dr + digit;
+        *anyDigits = true;
+    }
+    return value;
+}
+
+static PLY_NO_INLINE double oldParseDouble(InStream* ins, u32 radix) {
+    bool negate = false;
+    if (ins->tryMakeBytesAvailable() && ins->peekByte() == '-') {
+        ins->advanceByte();
+        negate = true;
+    }
+    bool anyDigits = false;
+    double value = oldReadDoubleComponent(ins, radix, &anyDigits);
+    if (ins->tryMakeBytesAvailable() && ins->peekByte() == '.') {
+        ins->advanceByte();
+        double significance = 1.0;
+        u64 numer = 0;
+        u64 denom = 1;
+        while (ins->tryMakeBytesAvailable()) {
+            u8 digit = fmt::DigitTable[(u8) ins->peekByte()];
+            if (digit >= radix)
+                break;
+            ins->advanceByte();
+            u64 denomWithNextDigit = denom * radix;
+            if (denomWithNextDigit < denom) {
+                double ooDenom = 1.0 / denom;
+                value += significance * numer * ooDenom;
+                significance *= ooDenom;
+                numer = digit;
+                denom = radix;
+            } else {
+                numer = numer * radix + digit;
+                denom = denomWithNextDigit;
+            }
+        }
+        value += significance * numer / denom;
+    }
+    if (anyDigits && ins->tryMakeBytesAvailable() && (ins->peekByte() | 0x20) == 'e') {
+        ins->advanceByte();
+        bool negateExp = false;
+        if (ins->tryMakeBytesAvailable()) {
+            if (ins->peekByte() == '+') {
+                ins->advanceByte();
+            } else if (ins->peekByte() == '-') {
+                ins->advanceByte();
+                negateExp = true;
+            }
+        }
+        anyDigits = false;
+        double exponent = oldReadDoubleComponent(ins, radix, &anyDigits);
+        value *= pow((double) radix, negateExp ? -exponent : exponent);
+    }
+    if (!anyDigits) {
+        ins->status.parseError = true;
+    }
+    return negate ? -value : value;
+}
+
+//---------------------------------------------------
+// benchNumbers
+//---------------------------------------------------
+void benchNumbers(StringWriter* sw) {
+    static constexpr u32 NumValues = 1000000;
+    static constexpr u32 NumRuns = 10;
+
+    // Integers of every length, and doubles that are either short decimals, like most numbers
+    // in text files, or arbitrary bit patterns that need all 17 digits
+    Array<u64> integers;
+    Array<double> doubles;
+    integers.resize(NumValues);
+    doubles.resize(NumValues);
+    Random r{1};
+    for (u32 i = 0; i < NumValues; i++) {
+        integers[i] = r.next64() >> (r.next32() % 64);
+        if (i % 2 == 0) {
+            doubles[i] = double(r.next32() % 1000000) / 1000;
+        } else {
+            u64 bits = r.next64() & ~(u64(0x401) << 53); // Positive and finite
+            memcpy(&doubles[i], &bits, sizeof(bits));
+        }
+    }
+
+    // Text to parse, with one value per line
+    String integerText;
+    String doubleText;
+    {
+        StringWriter textWriter;
+        for (u64 value : integers) {
+            textWriter << value << '\n';
+        }
+        integerText = textWriter.moveToString();
+    }
+    {
+        StringWriter textWriter;
+        for (double value : doubles) {
+            textWriter << value << '\n';
+        }
+        doubleText = textWriter.moveToString();
+    }
+    HybridString nullTerminatedDoubleText = doubleText.withNullTerminator();
+    sw->format("integers: {} bytes, doubles: {} bytes\n", integerText.numBytes,
+               doubleText.numBytes);
+
+    // Correctness: every value must read back as itself
+    u32 numFailed = 0;
+    {
+        StringViewReader svr{integerText};
+        for (u64 value : integers) {
+            numFailed += (svr.parse<u64>() != value);
+            svr.advanceByte();
+        }
+    }
+    {
+        StringViewReader svr{doubleText};
+        for (double value : doubles) {
+            numFailed += (svr.parse<double>() != value);
+            svr.advanceByte();
+        }
+    }
+    if (numFailed > 0) {
+        sw->format("{} values didn't read back; skipping timings\n", numFailed);
+        return;
+    }
+
+    u64 check = 0;
+    measure(sw, "print u64", NumRuns, [] {}, [&] {
+        StringWriter out;
+        for (u64 value : integers) {
+            out << value << '\n';
+        }
+        check += out.moveToString().numBytes;
+    });
+    measure(sw, "print u64 (old digit loop)", NumRuns, [] {}, [&] {
+        StringWriter out;
+        for (u64 value : integers) {
+            oldPrintU64(&out, value, 10);
+            out << '\n';
+        }
+        check += out.moveToString().numBytes;
+    });
+    measure(sw, "print double", NumRuns, [] {}, [&] {
+        StringWriter out;
+        for (double value : doubles) {
+            out << value << '\n';
+        }
+        check += out.moveToString().numBytes;
+    });
+    measure(sw, "print double (old digit loop, 4 significant digits)", NumRuns, [] {}, [&] {
+        StringWriter out;
+        for (double value : doubles) {
+            oldPrintDouble(&out, value, 10);
+            out << '\n';
+        }
+        check += out.moveToString().numBytes;
+    });
+    measure(sw, "print double (snprintf %.17g)", NumRuns, [] {}, [&] {
+        StringWriter out;
+        char buf[32];
+        for (double value : doubles) {
+            int n = snprintf(buf, sizeof(buf), "%.17g\n", value);
+            out << StringView{buf, (u32) n};
+        }
+        check += out.moveToString().numBytes;
+    });
+
+    measure(sw, "parse u64", NumRuns, [] {}, [&] {
+        StringViewReader svr{integerText};
+        for (u32 i = 0; i < NumValues; i++) {
+            check += svr.parse<u64>();
+            svr.advanceByte();
+        }
+    });
+    measure(sw, "parse u64 (old digit loop)", NumRuns, [] {}, [&] {
+        StringViewReader svr{integerText};
+        for (u32 i = 0; i < NumValues; i++) {
+            check += oldParseU64(&svr, 10);
+            svr.advanceByte();
+        }
+    });
+    measure(sw, "parse double", NumRuns, [] {}, [&] {
+        StringViewReader svr{doubleText};
+        for (u32 i = 0; i < NumValues; i++) {
+            check += svr.parse<double>() > 1;
+            svr.advanceByte();
+        }
+    });
+    measure(sw, "parse double (old digit loop)", NumRuns, [] {}, [&] {
+        StringViewReader svr{doubleText};
+        for (u32 i = 0; i < NumValues; i++) {
+            check += oldParseDouble(&svr, 10) > 1;
+            svr.advanceByte();
+        }
+    });
+    measure(sw, "parse double (strtod)", NumRuns, [] {}, [&] {
+        const char* cur = nullTerminatedDoubleText.view().bytes;
+        for (u32 i = 0; i < NumValues; i++) {
+            char* end;
+            check += strtod(cur, &end) > 1;
+            cur = end + 1;
+        }
+    });
+    // Print the checksum so that the compiler can't discard the work
+    sw->format("(checksum {})\n", check);
+}
+
+} // namespace ply
@@ -0,0 +1,90 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <Benchmark.h>
+#include <ply-reflect/PersistWrite.h>
+#include <ply-reflect/PersistRead.h>
+#include <ply-reflect/Asset.h>
+#include <plytool-client/Command.h>
+
+namespace ply {
+
+// Writes and reads a stream of tool::Commands, the same way PlyToolClient and "plytool rpc" do,
+// both with the generated serializers and with the generic TypeKeys.
+void benchPersist(StringWriter* sw) {
+    using Command = tool::Command;
+    static constexpr u32 NumCommands = 20000;
+    static constexpr u32 NumRuns = 10;
+
+    Command cmd;
+    auto run = cmd.type.run().switchTo();
+    for (u32 i = 0; i < 8; i++) {
+        run->sourceFiles.append(String::format("src/apps/Example/Source{}.cpp", i));
+    }
+    for (u32 i = 0; i < 4; i++) {
+        run->dependencies.append({"plywood", Command::Dependency::Type::Target,
+                                  String::format("target{}", i)});
+    }
+
+    // Clearing generatedWrite and generatedRead makes TypeKey_Struct walk the members instead
+    TypeDescriptor_Struct* structTypes[] = {Command::Type::Run::getReflection(),
+                                            Command::Dependency::getReflection()};
+    TypeDescriptor_Struct::GeneratedWriteFunc generatedWrites[2];
+    TypeDescriptor_Struct::GeneratedReadFunc generatedReads[2];
+    for (u32 i = 0; i < 2; i++) {
+        generatedWrites[i] = structTypes[i]->generatedWrite;
+        generatedReads[i] = structTypes[i]->generatedRead;
+    }
+
+    // Schema
+    MemOutStream schemaOut;
+    WriteFormatContext writeFormatContext{&schemaOut};
+    writeFormatContext.addOrGetFormatID(TypeResolver<Command>::get());
+    writeFormatContext.endSchema();
+    Schema schema;
+    {
+        Buffer schemaBytes = schemaOut.moveToBuffer();
+        ViewInStream schemaIn{schemaBytes};
+        readSchema(schema, &schemaIn);
+    }
+    RegistryTypeResolver resolver;
+    resolver.add(TypeResolver<Command>::get());
+
+    Buffer objBytes;
+    u32 check = 0;
+    for (bool generated : {true, false}) {
+        for (u32 i = 0; i < 2; i++) {
+            structTypes[i]->generatedWrite = generated ? generatedWrites[i] : nullptr;
+            structTypes[i]->generatedRead = generated ? generatedReads[i] : nullptr;
+        }
+        StringView suffix = generated ? "generated" : "TypeKey";
+
+        measure(sw, String::format("write ({})", suffix), NumRuns, [] {}, [&] {
+            MemOutStream memOut;
+            WriteObjectContext context{&memOut, &writeFormatContext};
+            for (u32 i = 0; i < NumCommands; i++) {
+                writeObject(TypedPtr::bind(&cmd), &context);
+            }
+            objBytes = memOut.moveToBuffer();
+        });
+
+        measure(sw, String::format("read ({})", suffix), NumRuns, [] {}, [&] {
+            ViewInStream ins{objBytes};
+            ReadObjectContext context{&schema, &ins, &resolver};
+            for (u32 i = 0; i < NumCommands; i++) {
+                TypedPtr obj = readObject(&context);
+                check += obj.cast<Command>()->type.run()->dependencies.numItems();
+                obj.destroy();
+            }
+        });
+    }
+    for (u32 i = 0; i < 2; i++) {
+        structTypes[i]->generatedWrite = generatedWrites[i];
+        structTypes[i]->generatedRead = generatedReads[i];
+    }
+    // Print the checksum so that the compiler can't discard the work
+    sw->format("(checksum {})\n", check);
+}
+
+} // namespace ply
@@ -0,0 +1,151 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <Benchmark.h>
+#include <ply-runtime/algorithm/Random.h>
+#include <pylon/Parse.h>
+
+namespace ply {
+
+// Returns the number of bytes allocated from the heap, or 0 if the heap doesn't keep track.
+static ureg getInUseBytes() {
+#if PLY_USE_DLMALLOC
+    return PLY_HEAP.getStats().inUseBytes;
+#else
+    return 0;
+#endif
+}
+
+// Returns true if node and ref have the same structure, names and text.
+static bool matches(const pylon::Node& node, pylon::FlatDocument::Ref ref) {
+    if (node.isObject()) {
+        const pylon::Node::Object& obj = node.object();
+        if (!ref.isObject() || ref.numItems() != obj.items.numItems())
+            return false;
+        u32 i = 0;
+        for (pylon::FlatDocument::Ref child : ref.children()) {
+            if (child.name() != obj.items[i].name || !matches(obj.items[i].value, child))
+                return false;
+            i++;
+        }
+        return true;
+    } else if (node.isArray()) {
+        if (!ref.isArray() || ref.numItems() != node.numItems())
+            return false;
+        u32 i = 0;
+        for (pylon::FlatDocument::Ref child : ref.children()) {
+            if (!matches(node[i], child))
+                return false;
+            i++;
+        }
+        return true;
+    } else {
+        return ref.isText() && ref.text() == node.text();
+    }
+}
+
+// Parses src both ways and checks that parseFlat() returns the same thing as parse().
+static bool checkParseFlat(StringWriter* sw, StringView src) {
+    pylon::Parser parser;
+    pylon::Node node = parser.parse(src);
+    pylon::FlatDocument doc = parser.parseFlat(src);
+    if (!node.isValid() || !doc.isValid() || !matches(node, doc.root())) {
+        sw->format("parseFlat doesn't match parse: \"{}\"\n", fmt::EscapedString{src, 40});
+        return false;
+    }
+    return true;
+}
+
+// Small documents that exercise each kind of node and token.
+static const StringView TestDocuments[] = {
+    "{}",
+    "[]",
+    "{a: 1, b: [2, 3], c: {d: 4}}",
+    "[[], {}, [[x]], \"\"]",
+    "{\n  name = value\n  list = [\n    1\n    2\n  ]\n}",
+    "{'single quoted': 'string'}",
+    "{\"a key long enough to be allocated\\t\": \"a value long enough to be allocated\\n\"}",
+    // Short text that had to be unescaped is stored inline in a HybridString, so parseFlat()
+    // must copy it into the FlatDocument
+    "{\"k\\ty\": \"a\\nb\"}",
+    "['\\x41', \"\\\"\", \"\\\\\"]",
+    "{\"\"\"multi\nline\"\"\": \"\"\"a\n\"b\"\n\"\"\"}",
+};
+
+// Generates a document that looks like a typical exported Pylon file.
+static String generateDocument(u32 numItems) {
+    StringWriter sw;
+    Random r{1};
+    sw << "{\n  items: [\n";
+    for (u32 i = 0; i < numItems; i++) {
+        sw << "    {\n";
+        sw.format("      name: \"item{}\"\n", i);
+        sw.format("      id: {}\n", r.next32());
+        sw.format("      scale: {}\n", r.nextFloat());
+        sw.format("      tags: [tag{}, tag{}, tag{}]\n", i % 7, i % 11, i % 13);
+        sw.format("      position: {{x: {}, y: {}, z: {}}}\n", r.next16(), r.next16(),
+                  r.next16());
+        sw << "      description: \"A somewhat longer string that describes the item\"\n";
+        sw << "    }\n";
+    }
+    sw << "  ]\n}\n";
+    return sw.moveToString();
+}
+
+void benchPylon(StringWriter* sw) {
+    static constexpr u32 NumItems = 50000;
+    static constexpr u32 NumRuns = 10;
+
+    String src = generateDocument(NumItems);
+    sw->format("document: {} bytes\n", src.numBytes);
+
+    // Correctness
+    u32 numFailed = 0;
+    for (StringView doc : TestDocuments) {
+        numFailed += !checkParseFlat(sw, doc);
+    }
+    numFailed += !checkParseFlat(sw, src);
+    {
+        pylon::Parser parser;
+        pylon::FlatDocument doc = parser.parseFlat("{\"k\\ty\": \"a\\nb\"}");
+        if (!doc.isValid() || doc.root()["k\ty"].text() != "a\nb") {
+            *sw << "parseFlat didn't unescape short text\n";
+            numFailed++;
+        }
+    }
+    if (numFailed > 0) {
+        sw->format("{} checks failed; skipping timings\n", numFailed);
+        return;
+    }
+
+    // Bytes allocated for the result of each parse
+    {
+        pylon::Parser parser;
+        ureg before = getInUseBytes();
+        pylon::Node node = parser.parse(src);
+        sw->format("parse: {} bytes allocated\n", getInUseBytes() - before);
+    }
+    {
+        pylon::Parser parser;
+        ureg before = getInUseBytes();
+        pylon::FlatDocument doc = parser.parseFlat(src);
+        sw->format("parseFlat: {} bytes allocated\n", getInUseBytes() - before);
+    }
+
+    u32 check = 0;
+    measure(sw, "parse", NumRuns, [] {}, [&] {
+        pylon::Parser parser;
+        pylon::Node node = parser.parse(src);
+        check += node["items"].numItems();
+    });
+    measure(sw, "parseFlat", NumRuns, [] {}, [&] {
+        pylon::Parser parser;
+        pylon::FlatDocument doc = parser.parseFlat(src);
+        check += doc.root()["items"].numItems();
+    });
+    // Print the checksum so that the compiler can't discard the work
+    sw->format("(checksum {})\n", check);
+}
+
+} // namespace ply
@@ -0,0 +1,110 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <Benchmark.h>
+#include <ply-runtime/algorithm/Sort.h>
+#include <ply-runtime/algorithm/ParallelSort.h>
+#include <ply-runtime/algorithm/RadixSort.h>
+#include <ply-runtime/algorithm/Random.h>
+#include <ply-runtime/thread/Affinity.h>
+
+namespace ply {
+
+void benchSort(StringWriter* sw) {
+    static constexpr u32 NumItems = 4000000;
+    static constexpr u32 NumRuns = 5;
+    u32 numThreads = Affinity{}.getNumHWThreads();
+
+    Array<u32> random;
+    random.resize(NumItems);
+    Random r{1};
+    for (u32& item : random) {
+        item = r.next32();
+    }
+    Array<u32> sorted = random;
+    sort(sorted.view());
+    Array<u32> reverseSorted;
+    reverseSorted.resize(NumItems);
+    for (u32 i = 0; i < NumItems; i++) {
+        reverseSorted[i] = sorted[NumItems - 1 - i];
+    }
+
+    struct Input {
+        StringView name;
+        const Array<u32>* items;
+    };
+    Input inputs[] = {{"random", &random}, {"sorted", &sorted}, {"reverse", &reverseSorted}};
+    Array<u32> work;
+    for (const Input& input : inputs) {
+        auto prepare = [&] { work = input.items->view(); };
+        measure(sw, String::format("sort {}", input.name), NumRuns, prepare,
+                [&] { sort(work.view()); });
+        measure(sw, String::format("parallelSort {} ({} threads)", input.name, numThreads),
+                NumRuns, prepare, [&] { parallelSort(work.view(), numThreads); });
+        PLY_ASSERT(memcmp(work.get(), sorted.get(), work.sizeBytes()) == 0);
+        measure(sw, String::format("stableSort {}", input.name), NumRuns, prepare,
+                [&] { stableSort(work.view()); });
+        PLY_ASSERT(memcmp(work.get(), sorted.get(), work.sizeBytes()) == 0);
+        measure(sw, String::format("radixSort {}", input.name), NumRuns, prepare,
+                [&] { radixSort(work.view()); });
+        PLY_ASSERT(memcmp(work.get(), sorted.get(), work.sizeBytes()) == 0);
+    }
+
+    // 64-bit keys
+    {
+        Array<u64> random64;
+        random64.resize(NumItems);
+        for (u64& item : random64) {
+            item = r.next64();
+        }
+        Array<u64> work64;
+        auto prepare = [&] { work64 = random64.view(); };
+        measure(sw, "sort random u64", NumRuns, prepare, [&] { sort(work64.view()); });
+        measure(sw, "radixSort random u64", NumRuns, prepare, [&] { radixSort(work64.view()); });
+    }
+
+    // Strings of 4 to 19 random lowercase letters
+    {
+        static constexpr u32 NumStrings = 1000000;
+        Array<String> strings;
+        strings.resize(NumStrings);
+        for (String& str : strings) {
+            str = String::allocate(4 + r.next32() % 16);
+            for (u32 i = 0; i < str.numBytes; i++) {
+                str.bytes[i] = char('a' + r.next32() % 26);
+            }
+        }
+        Array<StringView> views;
+        auto prepare = [&] {
+            views.resize(NumStrings);
+            for (u32 i = 0; i < NumStrings; i++) {
+                views[i] = strings[i];
+            }
+        };
+        measure(sw, "sort random StringView", NumRuns, prepare, [&] { sort(views.view()); });
+        Array<StringView> sortedViews = views;
+        measure(sw, "radixSort random StringView", NumRuns, prepare,
+                [&] { radixSort(views.view()); });
+        for (u32 i = 0; i < NumStrings; i++) {
+            PLY_ASSERT(views[i] == sortedViews[i]);
+        }
+    }
+
+    // Many small arrays, to show where radixSort starts to beat sort(). Below
+    // details::RadixSortThreshold items, radixSort falls back to stableSort().
+    for (u32 arraySize : {16, 32, 64, 128, 256, 1024, 65536}) {
+        auto prepare = [&] { work = random.view(); };
+        auto sortEach = [&](const auto& sortFunc) {
+            for (u32 start = 0; start + arraySize <= NumItems; start += arraySize) {
+                sortFunc(work.view().subView(start, arraySize));
+            }
+        };
+        measure(sw, String::format("sort {}-item arrays", arraySize), NumRuns, prepare,
+                [&] { sortEach([](ArrayView<u32> view) { sort(view); }); });
+        measure(sw, String::format("radixSort {}-item arrays", arraySize), NumRuns, prepare,
+                [&] { sortEach([](ArrayView<u32> view) { radixSort(view); }); });
+    }
+}
+
+} // namespace ply
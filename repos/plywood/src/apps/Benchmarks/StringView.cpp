@@ -0,0 +1,35 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <Benchmark.h>
+#include <ply-runtime/algorithm/Random.h>
+
+namespace ply {
+
+void benchStringView(StringWriter* sw) {
+    static constexpr u32 NumBytes = 1 << 16;
+    static constexpr u32 NumRuns = 200;
+
+    // Random lowercase words with some capitals and punctuation, split into lines
+    String text = String::allocate(NumBytes);
+    Random r{1};
+    for (u32 i = 0; i < NumBytes; i++) {
+        u32 x = r.next32() % 64;
+        text.bytes[i] = x < 52 ? char((x < 26 ? 'a' : 'A') + x % 26) : x < 62 ? ' ' : '\n';
+    }
+    String copy = text;
+    StringView needle = "not in the text!";
+
+    u32 check = 0;
+    measure(sw, "upperAsc", NumRuns, [] {}, [&] { check += text.upperAsc().numBytes; });
+    measure(sw, "lowerAsc", NumRuns, [] {}, [&] { check += text.lowerAsc().numBytes; });
+    measure(sw, "compare (equal)", NumRuns, [] {}, [&] { check += compare(text, copy); });
+    measure(sw, "findByte (miss)", NumRuns, [] {}, [&] { check += text.findByte('!'); });
+    measure(sw, "findSubStr (miss)", NumRuns, [] {}, [&] { check += text.findSubStr(needle); });
+    measure(sw, "splitByte", NumRuns, [] {}, [&] { check += text.splitByte(' ').numItems(); });
+    // Print the checksum so that the compiler can't discard the work
+    sw->format("(checksum {})\n", check);
+}
+
+} // namespace ply
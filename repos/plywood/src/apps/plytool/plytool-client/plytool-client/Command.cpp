@@ -4,5 +4,6 @@
 ------------------------------------*/
 #include <plytool-client/Core.h>
 #include <plytool-client/Command.h>
+#include <ply-reflect/PersistGenerated.h>
 
 #include "codegen/Command.inl" //%%
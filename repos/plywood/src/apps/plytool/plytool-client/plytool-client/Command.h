@@ -17,7 +17,7 @@ struct Command {
         };
         PLY_REFLECT_ENUM(friend, Type)
 
-        PLY_REFLECT()
+        PLY_REFLECT_WITH_SERIALIZERS()
         String repoName;
         Type depType = Type::Target;
         String depName;
@@ -27,7 +27,7 @@ struct Command {
     struct Type {
         // ply make reflected switch
         struct Run {
-            PLY_REFLECT()
+            PLY_REFLECT_WITH_SERIALIZERS()
             Array<String> sourceFiles;
             Array<Dependency> dependencies;
             // ply reflect off
@@ -4,11 +4,33 @@ PLY_STRUCT_MEMBER(depType)
 PLY_STRUCT_MEMBER(depName)
 PLY_STRUCT_END()
 
+PLY_STRUCT_WRITE_BEGIN(ply::tool::Command::Dependency)
+PLY_STRUCT_WRITE_MEMBER(repoName)
+PLY_STRUCT_WRITE_MEMBER(depType)
+PLY_STRUCT_WRITE_MEMBER(depName)
+PLY_STRUCT_WRITE_END()
+
+PLY_STRUCT_READ_BEGIN(ply::tool::Command::Dependency)
+PLY_STRUCT_READ_MEMBER(repoName)
+PLY_STRUCT_READ_MEMBER(depType)
+PLY_STRUCT_READ_MEMBER(depName)
+PLY_STRUCT_READ_END()
+
 PLY_STRUCT_BEGIN(ply::tool::Command::Type::Run)
 PLY_STRUCT_MEMBER(sourceFiles)
 PLY_STRUCT_MEMBER(dependencies)
 PLY_STRUCT_END()
 
+PLY_STRUCT_WRITE_BEGIN(ply::tool::Command::Type::Run)
+PLY_STRUCT_WRITE_MEMBER(sourceFiles)
+PLY_STRUCT_WRITE_MEMBER(dependencies)
+PLY_STRUCT_WRITE_END()
+
+PLY_STRUCT_READ_BEGIN(ply::tool::Command::Type::Run)
+PLY_STRUCT_READ_MEMBER(sourceFiles)
+PLY_STRUCT_READ_MEMBER(dependencies)
+PLY_STRUCT_READ_END()
+
 PLY_STRUCT_BEGIN(ply::tool::Command)
 PLY_STRUCT_MEMBER(type)
 PLY_STRUCT_END()
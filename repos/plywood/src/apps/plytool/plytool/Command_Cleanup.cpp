@@ -35,7 +35,7 @@ void checkFileHeader(StringView srcPath, StringView desiredHeader) {
     Preprocessor::StackItem& item = pp.stack.append();
     item.includeChainIdx = includeChainIdx;
     item.strViewReader = StringViewReader{srcFile.contents};
-    pp.linearLocAtEndOfStackTop = srcFile.contents.numBytes;
+    pp.linearLocAtEndOfStackTop = srcFile.contents.view().numBytes;
 
     PPVisitedFiles::LocationMapTraits::Item locMapItem;
     locMapItem.linearLoc = 0;
@@ -55,7 +55,7 @@ void checkFileHeader(StringView srcPath, StringView desiredHeader) {
     ExpandedFileLocation efl = expandFileLocation(&visitedFiles, tok.linearLoc);
     PLY_ASSERT(efl.srcFile == &srcFile);
     StringView existingFileHeader = StringView::fromRange(
-        srcFile.contents.bytes, tok.identifier.bytes - efl.fileLoc.numBytesIntoLine);
+        srcFile.contents.view().bytes, tok.identifier.bytes - efl.fileLoc.numBytesIntoLine);
 
     // Trim header at first blank line
     {
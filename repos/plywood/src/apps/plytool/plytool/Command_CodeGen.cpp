@@ -127,6 +127,18 @@ void generateAllCppInls(cpp::ReflectionInfoAggregator* agg) {
                     sw->format("PLY_STRUCT_MEMBER({})\n", member);
                 }
                 *sw << "PLY_STRUCT_END()\n\n";
+                if (this->clazz->withSerializers) {
+                    sw->format("PLY_STRUCT_WRITE_BEGIN({})\n", this->clazz->name);
+                    for (StringView member : this->clazz->members) {
+                        sw->format("PLY_STRUCT_WRITE_MEMBER({})\n", member);
+                    }
+                    *sw << "PLY_STRUCT_WRITE_END()\n\n";
+                    sw->format("PLY_STRUCT_READ_BEGIN({})\n", this->clazz->name);
+                    for (StringView member : this->clazz->members) {
+                        sw->format("PLY_STRUCT_READ_MEMBER({})\n", member);
+                    }
+                    *sw << "PLY_STRUCT_READ_END()\n\n";
+                }
             }
             StructGenerator(cpp::ReflectedClass* clazz) : clazz{clazz} {
             }
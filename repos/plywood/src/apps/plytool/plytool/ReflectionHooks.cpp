@@ -207,7 +207,7 @@ struct ReflectionHooks : ParseSupervisor {
                     // reflection info:
                     PLY_ASSERT(srcFile.absPath == curAbsPath);
                     const char* endCurly =
-                        srcFile.contents.bytes +
+                        srcFile.contents.view().bytes +
                         (lmItem.offset + record->closeCurly.linearLoc - lmItem.linearLoc);
                     PLY_ASSERT(*endCurly == '}');
                     String genFileName = String::format("switch-{}.inl", this->getClassName("-"));
@@ -264,7 +264,7 @@ struct ReflectionHooks : ParseSupervisor {
         subst.numBytes = safeDemote<u32>((directive.bytes + directive.numBytes) - startOfLine);
     }
 
-    void beginCapture(const Token& token) {
+    void beginCapture(const Token& token, bool withSerializers) {
         State& state = this->stack.back();
         if (state.clazz) {
             // Already have a PLY_REFLECT macro
@@ -276,6 +276,7 @@ struct ReflectionHooks : ParseSupervisor {
         ReflectedClass* clazz = new ReflectedClass;
         clazz->cppInlPath = makeInlRelPath(this->filePath);
         clazz->name = this->getClassName();
+        clazz->withSerializers = withSerializers;
         this->agg->classes.append(clazz);
         state.clazz = clazz;
         state.captureMembersToken = token;
@@ -283,7 +284,8 @@ struct ReflectionHooks : ParseSupervisor {
 
     virtual void gotMacroOrComment(Token token, bool atDeclarationScope) override {
         if (token.type == Token::Macro) {
-            if (token.identifier == "PLY_STATE_REFLECT" || token.identifier == "PLY_REFLECT") {
+            if (token.identifier == "PLY_STATE_REFLECT" || token.identifier == "PLY_REFLECT" ||
+                token.identifier == "PLY_REFLECT_WITH_SERIALIZERS") {
                 if (!atDeclarationScope) {
                     this->parser->pp->errorHandler.call(new ReflectionHookError{
                         ReflectionHookError::CommandCanOnlyBeUsedAtDeclarationScope,
@@ -296,7 +298,7 @@ struct ReflectionHooks : ParseSupervisor {
                         ReflectionHookError::CommandCanOnlyBeUsedInClassOrStruct, token.linearLoc});
                     return;
                 }
-                this->beginCapture(token);
+                this->beginCapture(token, token.identifier == "PLY_REFLECT_WITH_SERIALIZERS");
             }
         } else if (token.type == Token::LineComment) {
             StringViewReader commentReader{token.identifier};
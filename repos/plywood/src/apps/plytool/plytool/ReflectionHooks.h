@@ -29,6 +29,7 @@ struct ReflectedClass {
     String name;
     Array<String> members;
     // ply reflect off
+    bool withSerializers = false; // Declared with PLY_REFLECT_WITH_SERIALIZERS()
 };
 
 // FIXME: The parser actually fills in Enum_::enumerators, making this struct redundant.
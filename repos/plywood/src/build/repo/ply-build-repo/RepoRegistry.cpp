@@ -89,7 +89,7 @@ struct RepoInstantiator {
         // Load DLL
         typedef void RegFunc(Repo*);
 #if PLY_TARGET_POSIX
-        void* module = dlopen(idll.dllPath.withNullTerminator().bytes, RTLD_LAZY);
+        void* module = dlopen(idll.dllPath.withNullTerminator().view().bytes, RTLD_LAZY);
         if (!module) {
             const char* errStr = dlerror();
             ErrorHandler::log(ErrorHandler::Fatal,
@@ -27,8 +27,8 @@ void writeCMakeLists(StringWriter* sw, CMakeBuildFolder* cbf) {
         PLY_ASSERT(NativePath::isNormalized(filePath));
         if (cbf->forBootstrap) {
             if (filePath.startsWith(sourceFolderPrefix)) {
-                return StringView{"${SRC_FOLDER}"} +
-                       PosixPath::from<NativePath>(filePath.subStr(sourceFolderPrefix.numBytes));
+                return StringView{"${SRC_FOLDER}"} + PosixPath::from<NativePath>(filePath.subStr(
+                                                          sourceFolderPrefix.view().numBytes));
             } else if (filePath.startsWith(cbf->absPath)) {
                 return StringView{"${BUILD_FOLDER}"} +
                        PosixPath::from<NativePath>(filePath.subStr(cbf->absPath.numBytes));
@@ -570,7 +570,7 @@ public:
 
         // Create AVFormatContext
         AVOutputFormat* oformat =
-            av_guess_format(containerFormat.withNullTerminator().bytes, NULL, NULL);
+            av_guess_format(containerFormat.withNullTerminator().view().bytes, NULL, NULL);
         if (!oformat) {
             cleanup();
             return;
@@ -94,7 +94,7 @@ Owned<InStream> CookResult::openFileAsDependency(StringView path) {
         return nullptr;
     }
 
-    Owned<InStream> ins = FileSystem::native()->openStreamForRead(path);
+    Owned<InStream> ins = FileSystem::native()->openMappedStreamForRead(path);
     if (!ins) {
         this->errors.append(String::format("error opening {}\n", path));
         return nullptr;
@@ -17,6 +17,7 @@
 
 #include <ply-cook/Core.h>
 #include <ply-cook/Hash128.h>
+#include <ply-runtime/thread/Thread.h>
 
 #define PLY_ALLOW_UNALIGNED_READS 1
 
@@ -325,12 +326,98 @@ PLY_NO_INLINE Hash128::Value Hash128::get() const {
     return r;
 }
 
+PLY_NO_INLINE void Hash128::append(InStream* ins) {
+    while (ins->tryMakeBytesAvailable() > 0) {
+        this->append(ins->viewAvailable());
+        ins->curByte = ins->endByte;
+    }
+}
+
 PLY_NO_INLINE Hash128::Value Hash128::compute(ConstBufferView view) {
     Hash128 hasher;
     hasher.append(view);
     return hasher.get();
 }
 
+constexpr u32 Hash128::LeafSize;
+
+// Hashes the leaf hashes together. Seeded differently from compute() so that tree hashes can't
+// collide with plain hashes of the leaf hash array.
+static PLY_NO_INLINE Hash128::Value combineLeaves(ArrayView<const Hash128::Value> leaves,
+                                                  u64 numBytes) {
+    PLY_ASSERT(leaves.numItems > 1);
+    SpookyHash state;
+    state.Init(numBytes, 0x7472656568617368ull);
+    state.Update(leaves.items, leaves.numItems * sizeof(Hash128::Value));
+    Hash128::Value r;
+    state.Final(&r.a, &r.b);
+    return r;
+}
+
+static PLY_NO_INLINE void hashLeaves(ConstBufferView view, ArrayView<Hash128::Value> leaves,
+                                     u32 numThreads) {
+    if (numThreads > 1 && leaves.numItems > 1) {
+        // Hash the first half of the leaves on another thread
+        u32 numLeftLeaves = leaves.numItems / 2;
+        u32 numLeftThreads = numThreads / 2;
+        ConstBufferView leftView = view.subView(0, numLeftLeaves * Hash128::LeafSize);
+        ArrayView<Hash128::Value> leftLeaves = leaves.subView(0, numLeftLeaves);
+        Thread thread;
+        thread.run([&] { hashLeaves(leftView, leftLeaves, numLeftThreads); });
+        hashLeaves(view.subView(leftView.numBytes, view.numBytes - leftView.numBytes),
+                   leaves.subView(numLeftLeaves),
+                   numThreads - numLeftThreads);
+        thread.join();
+        return;
+    }
+    for (u32 i = 0; i < leaves.numItems; i++) {
+        u32 offset = i * Hash128::LeafSize;
+        leaves[i] =
+            Hash128::compute(view.subView(offset, min(Hash128::LeafSize, view.numBytes - offset)));
+    }
+}
+
+PLY_NO_INLINE Hash128::Value Hash128::computeTree(ConstBufferView view, u32 numThreads) {
+    if (view.numBytes <= LeafSize)
+        return compute(view);
+    Array<Value> leaves;
+    leaves.resize((view.numBytes + LeafSize - 1) / LeafSize);
+    hashLeaves(view, leaves.view(), numThreads);
+    return combineLeaves(leaves.view(), view.numBytes);
+}
+
+PLY_NO_INLINE Hash128::Value Hash128::computeFile(StringView path, u32 numThreads) {
+    Owned<InStream> ins = FileSystem::native()->openMappedStreamForRead(path);
+    if (!ins)
+        return Value::zero();
+    if (ins->isView())
+        return computeTree(ins->viewAvailable(), numThreads);
+
+    // Not memory-mapped. Read one leaf at a time.
+    Array<Value> leaves;
+    Buffer leaf = Buffer::allocate(LeafSize);
+    u64 numBytes = 0;
+    for (;;) {
+        BufferView dst = leaf;
+        while (dst.numBytes > 0 && ins->tryMakeBytesAvailable() > 0) {
+            u32 numBytesToCopy = min<u32>(dst.numBytes, ins->numBytesAvailable());
+            memcpy(dst.bytes, ins->curByte, numBytesToCopy);
+            ins->curByte += numBytesToCopy;
+            dst.offsetHead(numBytesToCopy);
+        }
+        u32 leafBytes = LeafSize - dst.numBytes;
+        if (leafBytes == 0 && leaves.numItems() > 0)
+            break;
+        numBytes += leafBytes;
+        leaves.append(compute(leaf.view().subView(0, leafBytes)));
+        if (leafBytes < LeafSize)
+            break;
+    }
+    if (leaves.numItems() == 1)
+        return leaves[0];
+    return combineLeaves(leaves.view(), numBytes);
+}
+
 } // namespace ply
 
 #include "codegen/Hash128.inl" //%%
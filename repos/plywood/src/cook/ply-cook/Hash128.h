@@ -303,9 +303,22 @@ struct Hash128 {
 
     Hash128();
     void append(ConstBufferView view);
+    // Hashes the rest of the InStream chunk by chunk, without loading it all into memory.
+    void append(InStream* ins);
     Value get() const;
 
     static Value compute(ConstBufferView view);
+
+    // Tree mode: The input is split into leaves of LeafSize bytes, each leaf is hashed
+    // independently (so that leaves can be hashed on multiple threads), and the leaf hashes are
+    // hashed together with the total length. Inputs no longer than a single leaf hash to the same
+    // value as compute().
+    static constexpr u32 LeafSize = 1024 * 1024;
+    static Value computeTree(ConstBufferView view, u32 numThreads = 1);
+    // Returns the tree mode hash of the file's contents, or zero() if the file can't be opened. The
+    // file is memory-mapped when possible so that leaves can be hashed in parallel; otherwise, it's
+    // streamed one leaf at a time.
+    static Value computeFile(StringView path, u32 numThreads = 1);
 };
 
 } // namespace ply
@@ -38,7 +38,7 @@ grammar::TranslationUnit parse(String&& sourceCode, PPVisitedFiles* visitedFiles
     Preprocessor::StackItem& item = pp.stack.append();
     item.includeChainIdx = includeChainIdx;
     item.strViewReader = StringViewReader{srcFile.contents};
-    pp.linearLocAtEndOfStackTop = srcFile.contents.numBytes;
+    pp.linearLocAtEndOfStackTop = srcFile.contents.view().numBytes;
 
     // Initialize location map
     PPVisitedFiles::LocationMapTraits::Item locMapItem;
@@ -82,7 +82,7 @@ parseSimpleDeclaration(StringView sourceCode, LinearLocation linearLocOfs) {
     Preprocessor::StackItem& item = pp.stack.append();
     item.includeChainIdx = includeChainIdx;
     item.strViewReader = StringViewReader{srcFile.contents};
-    pp.linearLocAtEndOfStackTop = linearLocOfs + srcFile.contents.numBytes;
+    pp.linearLocAtEndOfStackTop = linearLocOfs + srcFile.contents.view().numBytes;
 
     // Create parser
     Parser parser;
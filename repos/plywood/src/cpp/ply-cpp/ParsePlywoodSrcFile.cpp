@@ -20,7 +20,8 @@ PLY_NO_INLINE void addPPDef(Preprocessor* pp, StringView identifier, StringView
     exp.takesArgs = takesArgs;
 
     auto cursor = pp->macros.insertOrFind(identifier);
-    cursor->identifier = identifier;
+    cursor->identifier = g_labelStorage.insert(identifier);
+    cursor->name = g_labelStorage.view(cursor->identifier);
     cursor->expansionIdx = expIdx;
 }
 
@@ -60,7 +61,7 @@ void parsePlywoodSrcFile(StringView absSrcPath, cpp::PPVisitedFiles* visitedFile
     Preprocessor::StackItem& item = pp.stack.append();
     item.includeChainIdx = includeChainIdx;
     item.strViewReader = StringViewReader{srcFile.contents};
-    pp.linearLocAtEndOfStackTop = srcFile.contents.numBytes;
+    pp.linearLocAtEndOfStackTop = srcFile.contents.view().numBytes;
 
     PPVisitedFiles::LocationMapTraits::Item locMapItem;
     locMapItem.linearLoc = 0;
@@ -76,6 +77,7 @@ void parsePlywoodSrcFile(StringView absSrcPath, cpp::PPVisitedFiles* visitedFile
     addPPDef(&pp, "PLY_STATIC_ASSERT", "static_assert");
     addPPDef(&pp, "PLY_STATE_REFLECT", "", true);
     addPPDef(&pp, "PLY_REFLECT", "", true);
+    addPPDef(&pp, "PLY_REFLECT_WITH_SERIALIZERS", "", true);
     addPPDef(&pp, "PLY_REFLECT_ENUM", "", true);
     addPPDef(&pp, "PLY_IMPLEMENT_IFACE", "", true);
     addPPDef(&pp, "PLY_STRUCT_BEGIN", "", true);
@@ -84,6 +86,12 @@ void parsePlywoodSrcFile(StringView absSrcPath, cpp::PPVisitedFiles* visitedFile
     addPPDef(&pp, "PLY_STRUCT_END", "", true);
     addPPDef(&pp, "PLY_STRUCT_END_PRIM", "", true);
     addPPDef(&pp, "PLY_STRUCT_MEMBER", "", true);
+    addPPDef(&pp, "PLY_STRUCT_WRITE_BEGIN", "", true);
+    addPPDef(&pp, "PLY_STRUCT_WRITE_MEMBER", "", true);
+    addPPDef(&pp, "PLY_STRUCT_WRITE_END", "", true);
+    addPPDef(&pp, "PLY_STRUCT_READ_BEGIN", "", true);
+    addPPDef(&pp, "PLY_STRUCT_READ_MEMBER", "", true);
+    addPPDef(&pp, "PLY_STRUCT_READ_END", "", true);
     addPPDef(&pp, "PLY_ENUM_BEGIN", "", true);
     addPPDef(&pp, "PLY_ENUM_IDENTIFIER", "", true);
     addPPDef(&pp, "PLY_ENUM_END", "", true);
@@ -95,6 +103,8 @@ void parsePlywoodSrcFile(StringView absSrcPath, cpp::PPVisitedFiles* visitedFile
     addPPDef(&pp, "SLOG_DECLARE_CHANNEL", "", true);
     addPPDef(&pp, "PLY_WORKSPACE_FOLDER", "\"\"", false);
     addPPDef(&pp, "PLY_THREAD_STARTCALL", "", false);
+    addPPDef(&pp, "PLY_THREAD_LOCAL", "", false);
+    addPPDef(&pp, "PLY_ENABLE_AVX2", "", false);
     addPPDef(&pp, "GL_FUNC", "", true);
     addPPDef(&pp, "PLY_MAKE_LIMITS", "", true);
     addPPDef(&pp, "PLY_DECL_ALIGNED", "", true);
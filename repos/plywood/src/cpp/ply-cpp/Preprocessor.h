@@ -53,14 +53,18 @@ struct Preprocessor {
     Array<StackItem> stack;
     LinearLocation linearLocAtEndOfStackTop = -1;
 
+    // Macro identifiers are interned, since every Preprocessor defines the same macros. Every
+    // identifier token is looked up here, so the map is keyed on the interned bytes, which doesn't
+    // involve g_labelStorage's mutex. The Label is only needed once a macro is found.
     struct MacrosTraits {
         using Key = StringView;
         struct Item {
-            String identifier;
+            StringView name; // Points into g_labelStorage
+            Label identifier;
             u32 expansionIdx = 0;
         };
         static Key comparand(const Item& item) {
-            return item.identifier;
+            return item.name;
         }
     };
     HashMap<MacrosTraits> macros;
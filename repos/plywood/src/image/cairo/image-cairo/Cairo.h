@@ -143,11 +143,11 @@ struct Context {
     }
     PLY_INLINE cairo_text_extents_t textExtents(const StringView& s) {
         cairo_text_extents_t extents;
-        cairo_text_extents((cairo_t*) this, s.withNullTerminator().bytes, &extents);
+        cairo_text_extents((cairo_t*) this, s.withNullTerminator().view().bytes, &extents);
         return extents;
     }
     PLY_INLINE void showText(StringView s) {
-        cairo_show_text((cairo_t*) this, s.withNullTerminator().bytes);
+        cairo_show_text((cairo_t*) this, s.withNullTerminator().view().bytes);
     }
     PLY_INLINE cairo_font_extents_t fontExtents() {
         cairo_font_extents_t extents;
@@ -70,6 +70,45 @@ inline s64 roundUpPowerOf2(s64 v) {
     return (s64) roundUpPowerOf2((u64) v);
 }
 
+// Returns the index of the lowest set bit. v must not be zero.
+PLY_INLINE u32 countTrailingZeros(u64 v) {
+    PLY_ASSERT(v != 0);
+#if PLY_COMPILER_MSVC
+    unsigned long index;
+#if PLY_CPU_X64 || PLY_CPU_ARM64
+    _BitScanForward64(&index, v);
+#else
+    if (_BitScanForward(&index, (u32) v) == 0) {
+        _BitScanForward(&index, (u32)(v >> 32));
+        index += 32;
+    }
+#endif
+    return index;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+// Returns the number of leading zero bits. v must not be zero.
+PLY_INLINE u32 countLeadingZeros(u64 v) {
+    PLY_ASSERT(v != 0);
+#if PLY_COMPILER_MSVC
+    unsigned long index;
+#if PLY_CPU_X64 || PLY_CPU_ARM64
+    _BitScanReverse64(&index, v);
+#else
+    if (_BitScanReverse(&index, (u32)(v >> 32))) {
+        index += 32;
+    } else {
+        _BitScanReverse(&index, (u32) v);
+    }
+#endif
+    return 63 - index;
+#else
+    return __builtin_clzll(v);
+#endif
+}
+
 inline ureg countSetBits(u64 mask) {
     ureg count = 0;
     while (mask) {
@@ -22,6 +22,13 @@
 //-------------------------------------
 #define PLY_THREAD_LOCAL __thread
 
+//-------------------------------------
+//  Instruction set extensions
+//-------------------------------------
+// Lets a function use AVX2 intrinsics without compiling the whole module for AVX2. Callers must
+// check that the CPU supports AVX2 first.
+#define PLY_ENABLE_AVX2 __attribute__((target("avx2")))
+
 //-------------------------------------
 //  CPU intrinsics
 //-------------------------------------
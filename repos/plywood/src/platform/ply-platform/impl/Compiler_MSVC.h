@@ -21,6 +21,12 @@
 //-------------------------------------
 #define PLY_THREAD_LOCAL __declspec(thread)
 
+//-------------------------------------
+//  Instruction set extensions
+//-------------------------------------
+// MSVC allows AVX2 intrinsics in any function. Callers must check that the CPU supports AVX2 first.
+#define PLY_ENABLE_AVX2
+
 //-------------------------------------
 //  Debug break
 //-------------------------------------
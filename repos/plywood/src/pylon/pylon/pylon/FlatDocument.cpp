@@ -0,0 +1,54 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <pylon/Core.h>
+#include <pylon/FlatDocument.h>
+
+namespace pylon {
+
+FlatDocument::Ref FlatDocument::Ref::operator[](u32 index) const {
+    if (!this->isArray() || index >= this->numItems())
+        return {};
+    u32 childIndex = this->index + 1;
+    for (u32 i = 0; i < index; i++) {
+        childIndex += this->doc->nodes[childIndex].numNodes;
+    }
+    return {this->doc, childIndex};
+}
+
+u32 FlatDocument::find(u32 objectIndex, StringView name) const {
+    const Node& object = this->nodes[objectIndex];
+    PLY_ASSERT(object.type == Type::Object);
+    if (object.numChildren() <= LinearSearchLimit) {
+        u32 childIndex = objectIndex + 1;
+        for (u32 i = 0; i < object.numChildren(); i++) {
+            const Node& child = this->nodes[childIndex];
+            if (child.name() == name)
+                return childIndex;
+            childIndex += child.numNodes;
+        }
+        return InvalidIndex;
+    }
+
+    if (!this->index) {
+        // Build the index for every large object in the document at once
+        this->index = new HashMap<IndexTraits>;
+        for (u32 i = 0; i < this->nodes.numItems(); i++) {
+            const Node& node = this->nodes[i];
+            if (node.type != Type::Object || node.numChildren() <= LinearSearchLimit)
+                continue;
+            u32 childIndex = i + 1;
+            for (u32 j = 0; j < node.numChildren(); j++) {
+                auto cursor = this->index->insertOrFind({i, this->nodes[childIndex].name()},
+                                                        &this->nodes);
+                *cursor = {i, childIndex};
+                childIndex += this->nodes[childIndex].numNodes;
+            }
+        }
+    }
+    auto cursor = this->index->find({objectIndex, name}, &this->nodes);
+    return cursor.wasFound() ? cursor->nodeIndex : InvalidIndex;
+}
+
+} // namespace pylon
@@ -0,0 +1,166 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <pylon/Core.h>
+#include <pylon/Node.h>
+
+namespace pylon {
+
+// A FlatDocument is an alternative to a tree of Nodes, produced by Parser::parseFlat. All nodes
+// are stored in a single array in depth-first order, so parsing doesn't allocate memory per node.
+// The children of an Object or Array node immediately follow it, and each node records the size
+// of its subtree so that siblings can be skipped over.
+//
+// Text values and property names are StringViews into the source buffer, so the source must
+// outlive the FlatDocument. Strings containing escape sequences are the exception; they're
+// unescaped into memory owned by the FlatDocument.
+//
+// Property lookup uses a linear search for small objects. For larger objects, an index is built
+// the first time find() is called. That makes find() unsafe to call from multiple threads at once.
+struct FlatDocument {
+    static const u32 InvalidIndex = u32(-1);
+    // Objects with more properties than this are looked up using the index:
+    static const u32 LinearSearchLimit = 16;
+
+    enum class Type : u8 { Invalid, Object, Array, Text };
+
+    struct Node {
+        Type type = Type::Invalid;
+        u32 numNodes = 1; // Size of this subtree, including this node
+        Location location = {0, 0};
+        // StringViews are split into separate fields to keep Node small:
+        const char* nameBytes = nullptr; // Property name, if the parent is an Object
+        const char* textBytes = nullptr; // Text only
+        u32 numNameBytes = 0;
+        u32 numTextBytesOrChildren = 0; // Number of children for an Object or Array
+
+        PLY_INLINE StringView name() const {
+            return {this->nameBytes, this->numNameBytes};
+        }
+        PLY_INLINE StringView text() const {
+            PLY_ASSERT(this->type == Type::Text);
+            return {this->textBytes, this->numTextBytesOrChildren};
+        }
+        PLY_INLINE u32 numChildren() const {
+            PLY_ASSERT(this->type == Type::Object || this->type == Type::Array);
+            return this->numTextBytesOrChildren;
+        }
+    };
+
+    struct IndexTraits {
+        struct Key {
+            u32 objectIndex;
+            StringView name;
+
+            PLY_INLINE bool operator==(const Key& other) const {
+                return this->objectIndex == other.objectIndex && this->name == other.name;
+            }
+        };
+        struct Item {
+            u32 objectIndex;
+            u32 nodeIndex;
+        };
+        using Context = Array<Node>;
+        static PLY_INLINE Key comparand(const Item& item, const Array<Node>& nodes) {
+            return {item.objectIndex, nodes[item.nodeIndex].name()};
+        }
+        static PLY_INLINE u32 hash(const Key& key) {
+            return Hasher::hashBuffer(key.name.bytes, key.name.numBytes, key.objectIndex);
+        }
+    };
+
+    // A lightweight handle to a node in a FlatDocument.
+    struct Ref {
+        const FlatDocument* doc = nullptr;
+        u32 index = InvalidIndex;
+
+        struct Iterator {
+            const FlatDocument* doc;
+            u32 index;
+            u32 remaining;
+
+            PLY_INLINE Ref operator*() const {
+                return {this->doc, this->index};
+            }
+            PLY_INLINE void operator++() {
+                this->index += this->doc->nodes[this->index].numNodes;
+                this->remaining--;
+            }
+            PLY_INLINE bool operator!=(const Iterator& other) const {
+                return this->remaining != other.remaining;
+            }
+        };
+
+        struct Children {
+            Iterator first;
+
+            PLY_INLINE Iterator begin() const {
+                return first;
+            }
+            PLY_INLINE Iterator end() const {
+                return {first.doc, 0, 0};
+            }
+        };
+
+        PLY_INLINE bool isValid() const {
+            return this->doc && this->index < this->doc->nodes.numItems();
+        }
+        PLY_INLINE Type type() const {
+            return this->isValid() ? this->doc->nodes[this->index].type : Type::Invalid;
+        }
+        PLY_INLINE bool isObject() const {
+            return this->type() == Type::Object;
+        }
+        PLY_INLINE bool isArray() const {
+            return this->type() == Type::Array;
+        }
+        PLY_INLINE bool isText() const {
+            return this->type() == Type::Text;
+        }
+        PLY_INLINE Location location() const {
+            return this->isValid() ? this->doc->nodes[this->index].location : Location{0, 0};
+        }
+        PLY_INLINE StringView name() const {
+            return this->isValid() ? this->doc->nodes[this->index].name() : StringView{};
+        }
+        PLY_INLINE StringView text() const {
+            return this->isText() ? this->doc->nodes[this->index].text() : StringView{};
+        }
+        PLY_INLINE operator StringView() const {
+            return this->text();
+        }
+        // Number of properties of an Object, or items of an Array.
+        PLY_INLINE u32 numItems() const {
+            return (this->isObject() || this->isArray())
+                       ? this->doc->nodes[this->index].numChildren()
+                       : 0;
+        }
+        // Iterates over the properties of an Object, or the items of an Array.
+        PLY_INLINE Children children() const {
+            return {{this->doc, this->index + 1, this->numItems()}};
+        }
+        // Takes time proportional to index. Prefer children() when visiting every item.
+        Ref operator[](u32 index) const;
+        PLY_INLINE Ref operator[](StringView key) const {
+            return {this->doc, this->isObject() ? this->doc->find(this->index, key) : InvalidIndex};
+        }
+    };
+
+    Array<Node> nodes;
+    Array<String> unescapedStrings;
+    mutable Owned<HashMap<IndexTraits>> index;
+
+    PLY_INLINE bool isValid() const {
+        return !this->nodes.isEmpty();
+    }
+    PLY_INLINE Ref root() const {
+        return {this, 0};
+    }
+
+    // Returns the index of the property of the given Object node, or InvalidIndex.
+    u32 find(u32 objectIndex, StringView name) const;
+};
+
+} // namespace pylon
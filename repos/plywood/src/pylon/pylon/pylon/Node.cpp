@@ -13,6 +13,13 @@ Node Node::invalidNode;
 
 bool Node::isNumeric() const {
     StringView strView = type.text()->str.view();
+    {
+        // Fast path for plain decimal numbers
+        StringViewReader svr{strView};
+        svr.parse<double>();
+        if (svr.atEOF() && !svr.anyParseError())
+            return true;
+    }
     char* end = nullptr;
     // FIXME: Replace strtod with something that respects strView.numBytes (like TextInput):
     strtod(strView.bytes, &end);
@@ -21,6 +28,13 @@ bool Node::isNumeric() const {
 
 double Node::numeric() const {
     StringView strView = type.text()->str.view();
+    {
+        // Fast path for plain decimal numbers
+        StringViewReader svr{strView};
+        double value = svr.parse<double>();
+        if (svr.atEOF() && !svr.anyParseError())
+            return value;
+    }
     char* end = nullptr;
     // FIXME: Replace strtod with something that respects strView.numBytes:
     double value = strtod(strView.bytes, &end);
@@ -4,15 +4,10 @@
 ------------------------------------*/
 #include <pylon/Core.h>
 #include <pylon/Parse.h>
-#include <ply-runtime/io/StdIO.h>
+#include <ply-runtime/container/SetInScope.h>
 
 namespace pylon {
 
-bool isAlnumUnit(u32 c) {
-    return (c == '_') || (c == '$') || (c == '-') || (c == '.') || (c >= 'a' && c <= 'z') ||
-           (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || (c >= 128);
-}
-
 void ParseError::dump(StringWriter& sw) const {
     sw.format("({}, {}): error: {}\n", location.line, location.column, message);
     for (u32 i = 0; i < context.numItems(); i++) {
@@ -48,190 +43,6 @@ void Parser::error(Location location, HybridString&& message) {
     this->anyError_ = true;
 }
 
-void Parser::advanceChar() {
-    switch (nextUnit) {
-        case '\r':
-        case -1:
-            break;
-
-        case '\t':
-            location.column = ((location.column + tabSize - 1) / tabSize) * tabSize + 1;
-            break;
-
-        case '\n':
-            location.line++;
-            location.column = 1;
-            break;
-
-        default:
-            location.column++;
-            break;
-    }
-
-    if (readOfs + 1 < srcView.numBytes) {
-        readOfs++;
-        nextUnit = srcView.bytes[readOfs];
-    } else {
-        nextUnit = -1;
-    }
-}
-
-Parser::Token Parser::readPlainToken(Token::Type type) {
-    Token result = {type, location, {}};
-    advanceChar();
-    return result;
-}
-
-bool Parser::readEscapedHex(OutStream* outs, Location escapeLoc) {
-    PLY_ASSERT(0); // FIXME
-    return false;
-}
-
-Parser::Token Parser::readQuotedString() {
-    PLY_ASSERT(nextUnit == '"' || nextUnit == '\'');
-    Token token = {Token::Type::Text, location, {}};
-    MemOutStream outs;
-    NativeEndianWriter wr{&outs};
-    s32 endByte = nextUnit;
-    u32 quoteRun = 1;
-    bool multiline = false;
-    advanceChar();
-
-    for (;;) {
-        if (nextUnit == endByte) {
-            advanceChar();
-            if (quoteRun == 0) {
-                if (multiline) {
-                    quoteRun++;
-                } else {
-                    break; // end of string
-                }
-            } else {
-                quoteRun++;
-                if (quoteRun == 3) {
-                    if (multiline) {
-                        break; // end of string
-                    } else {
-                        multiline = true;
-                        quoteRun = 0;
-                    }
-                }
-            }
-        } else {
-            if (quoteRun > 0) {
-                if (multiline) {
-                    for (u32 i = 0; i < quoteRun; i++) {
-                        wr.write((u8) endByte);
-                    }
-                } else if (quoteRun == 2) {
-                    break; // empty string
-                }
-                quoteRun = 0;
-            }
-
-            switch (nextUnit) {
-                case -1: {
-                    error(location, "Unexpected end of file in string literal");
-                    return {};
-                }
-
-                case '\r':
-                case '\n': {
-                    if (multiline) {
-                        if (nextUnit == '\n') {
-                            wr.write((u8) nextUnit);
-                        }
-                        advanceChar();
-                    } else {
-                        error(location, "Unexpected end of line in string literal");
-                        return {};
-                    }
-                    break;
-                }
-
-                case '\\': {
-                    // Escape sequence
-                    Location escapeLoc = location;
-                    advanceChar();
-                    s32 code = nextUnit;
-                    advanceChar();
-                    switch (code) {
-                        case -1: {
-                            error(location, "Unexpected end of file in string literal");
-                            return {};
-                        }
-
-                        case '\r':
-                        case '\n': {
-                            error(location, "Unexpected end of line in string literal");
-                            return {};
-                        }
-
-                        case '\\':
-                        case '\'':
-                        case '"': {
-                            wr.write((u8) code);
-                            break;
-                        }
-
-                        case 'r': {
-                            wr.write((u8) '\r');
-                            break;
-                        }
-
-                        case 'n': {
-                            wr.write((u8) '\n');
-                            break;
-                        }
-
-                        case 't': {
-                            wr.write((u8) '\t');
-                            break;
-                        }
-
-                        case 'x': {
-                            if (!readEscapedHex(&outs, escapeLoc))
-                                return {}; // FIXME: Would be better to continue reading the
-                                           // rest of the string
-                            break;
-                        }
-
-                        default: {
-                            error(escapeLoc, String::format("Unrecognized escape sequence \"\\{}\"",
-                                                            (char) code));
-                            return {}; // FIXME: Would be better to continue reading the rest
-                                       // of the string
-                        }
-                    }
-                    break;
-                }
-
-                default: {
-                    wr.write((u8) nextUnit);
-                    advanceChar();
-                    break;
-                }
-            }
-        }
-    }
-
-    token.text = outs.moveToString();
-    return token;
-}
-
-Parser::Token Parser::readLiteral() {
-    PLY_ASSERT(isAlnumUnit(nextUnit));
-    Token token = {Token::Text, location, {}};
-    u32 startOfs = readOfs;
-
-    while (isAlnumUnit(nextUnit)) {
-        advanceChar();
-    }
-
-    token.text = StringView{(char*) srcView.bytes + startOfs, readOfs - startOfs};
-    return token;
-}
-
 Parser::Token Parser::readToken(bool tokenizeNewLine) {
     if (pushBackToken.isValid()) {
         Token token = std::move(pushBackToken);
@@ -239,84 +50,23 @@ Parser::Token Parser::readToken(bool tokenizeNewLine) {
         return token;
     }
 
-    for (;;) {
-        switch (nextUnit) {
-            case ' ':
-            case '\t':
-            case '\r':
-                advanceChar();
-                break;
-
-            case '\n': {
-                Location newLineLoc = location;
-                advanceChar();
-                if (tokenizeNewLine)
-                    return {Token::NewLine, newLineLoc, {}};
-                break;
-            }
-
-            case -1:
-                return {Token::EndOfFile, location, {}};
-            case '{':
-                return readPlainToken(Token::OpenCurly);
-            case '}':
-                return readPlainToken(Token::CloseCurly);
-            case '[':
-                return readPlainToken(Token::OpenSquare);
-            case ']':
-                return readPlainToken(Token::CloseSquare);
-            case ':':
-                return readPlainToken(Token::Colon);
-            case '=':
-                return readPlainToken(Token::Equals);
-            case ',':
-                return readPlainToken(Token::Comma);
-            case ';':
-                return readPlainToken(Token::Semicolon);
-
-            case '"':
-            case '\'':
-                return readQuotedString();
-
-            default:
-                if (isAlnumUnit(nextUnit))
-                    return readLiteral();
-                else
-                    return {Token::Junk, location, {}};
+    Token token;
+    static_cast<pylon::Token&>(token) = this->tokenizer->readToken(tokenizeNewLine);
+    if (token.type == Token::Text) {
+        if (this->tokenizer->isTextInSource()) {
+            token.text = this->tokenizer->text();
+            token.isTextInSource = true;
+        } else {
+            token.text = HybridString::copy(this->tokenizer->text());
         }
+    } else if (!token.isValid()) {
+        error(this->tokenizer->errorLocation, std::move(this->tokenizer->errorMessage));
     }
+    return token;
 }
 
 HybridString Parser::toString(const Token& token) {
-    switch (token.type) {
-        case Token::OpenCurly:
-            return "\"{\"";
-        case Token::CloseCurly:
-            return "\"}\"";
-        case Token::OpenSquare:
-            return "\"[\"";
-        case Token::CloseSquare:
-            return "\"]\"";
-        case Token::Colon:
-            return "\":\"";
-        case Token::Equals:
-            return "\"=\"";
-        case Token::Comma:
-            return "\",\"";
-        case Token::Semicolon:
-            return "\";\"";
-        case Token::Text:
-            return String::format("text \"{}\"", fmt::EscapedString{token.text, 20});
-        case Token::Junk:
-            return String::format("junk \"{}\"", fmt::EscapedString{token.text, 20});
-        case Token::NewLine:
-            return "newline";
-        case Token::EndOfFile:
-            return "end of file";
-        default:
-            PLY_ASSERT(0);
-            return "???";
-    }
+    return Tokenizer::toString(token, token.text);
 }
 
 HybridString Parser::toString(const Node& node) {
@@ -484,8 +234,10 @@ Node Parser::readExpression(Token&& firstToken, const Token* afterToken) {
 }
 
 Node Parser::parse(ConstBufferView srcView_) {
-    srcView = srcView_;
-    nextUnit = srcView.numBytes > 0 ? srcView[0] : -1;
+    ViewInStream ins{srcView_};
+    Tokenizer tokenizer{&ins};
+    tokenizer.tabSize = this->tabSize;
+    PLY_SET_IN_SCOPE(this->tokenizer, &tokenizer);
 
     Token rootToken = readToken();
     Node root = readExpression(std::move(rootToken));
@@ -502,4 +254,239 @@ Node Parser::parse(ConstBufferView srcView_) {
     return root;
 }
 
+//-----------------------------------------------------------
+// Flat parsing
+//-----------------------------------------------------------
+
+HybridString Parser::toString(const FlatDocument::Node& node) {
+    switch (node.type) {
+        case FlatDocument::Type::Object:
+            return "object";
+        case FlatDocument::Type::Array:
+            return "array";
+        case FlatDocument::Type::Text:
+            return String::format("text \"{}\"", fmt::EscapedString{node.text(), 20});
+        default:
+            PLY_ASSERT(0);
+            return "???";
+    }
+}
+
+StringView Parser::storeText(FlatDocument* doc, HybridString&& text, bool isTextInSource) {
+    if (isTextInSource)
+        return text.view();
+    // Short text is stored inline in the HybridString, so it can't be viewed after text is gone
+    return doc->unescapedStrings.append(std::move(text));
+}
+
+u32 Parser::findDuplicate(FlatDocument* doc, u32 objectIndex, StringView name) {
+    if (doc->nodes[objectIndex].numChildren() <= FlatDocument::LinearSearchLimit)
+        return doc->find(objectIndex, name);
+    auto cursor = this->flatPropIndex->find({objectIndex, name}, &doc->nodes);
+    return cursor.wasFound() ? cursor->nodeIndex : FlatDocument::InvalidIndex;
+}
+
+bool Parser::readFlatObject(FlatDocument* doc, const Token& startToken, StringView name) {
+    PLY_ASSERT(startToken.type == Token::OpenCurly);
+    ScopeHandler objectScope{*this, ParseError::Scope::object(startToken.location)};
+    u32 objectIndex = doc->nodes.numItems();
+    {
+        FlatDocument::Node& node = doc->nodes.append();
+        node.type = FlatDocument::Type::Object;
+        node.location = startToken.location;
+        node.nameBytes = name.bytes;
+        node.numNameBytes = name.numBytes;
+    }
+    Token prevProperty = {};
+    for (;;) {
+        bool gotSeparator = false;
+        Token firstToken = {};
+        for (;;) {
+            firstToken = readToken(true);
+            switch (firstToken.type) {
+                case Token::CloseCurly:
+                    doc->nodes[objectIndex].numNodes = doc->nodes.numItems() - objectIndex;
+                    return true;
+
+                case Token::Comma:
+                case Token::Semicolon:
+                case Token::NewLine:
+                    gotSeparator = true;
+                    break;
+
+                default:
+                    goto breakOuter;
+            }
+        }
+    breakOuter:
+
+        if (firstToken.type == Token::Text) {
+            if (prevProperty.isValid() && !gotSeparator) {
+                error(firstToken.location,
+                      String::format("Expected a comma, semicolon or newline "
+                                     "separator between properties \"{}\" and \"{}\"",
+                                     fmt::EscapedString{prevProperty.text, 20},
+                                     fmt::EscapedString{firstToken.text, 20}));
+                return false;
+            }
+        } else if (prevProperty.isValid()) {
+            error(firstToken.location,
+                  String::format("Unexpected {} after property \"{}\"", toString(firstToken),
+                                 fmt::EscapedString{prevProperty.text, 20}));
+            return false;
+        } else {
+            error(firstToken.location,
+                  String::format("Expected property, got {}", toString(firstToken)));
+            return false;
+        }
+
+        u32 duplicateIndex = findDuplicate(doc, objectIndex, firstToken.text);
+        if (duplicateIndex != FlatDocument::InvalidIndex) {
+            ScopeHandler duplicateScope{
+                *this, ParseError::Scope::duplicate(doc->nodes[duplicateIndex].location)};
+            error(firstToken.location, String::format("Duplicate property \"{}\"",
+                                                      fmt::EscapedString{firstToken.text, 20}));
+            return false;
+        }
+
+        Token colon = readToken();
+        if (colon.type != Token::Colon && colon.type != Token::Equals) {
+            error(colon.location,
+                  String::format("Expected \":\" or \"=\" after \"{}\", got {}",
+                                 fmt::EscapedString{firstToken.text, 20}, toString(colon)));
+            return false;
+        }
+
+        {
+            // Read value of property
+            StringView propName =
+                storeText(doc, std::move(firstToken.text), firstToken.isTextInSource);
+            firstToken.text = propName;
+            ScopeHandler propertyScope{*this,
+                                       ParseError::Scope::property(firstToken.location, propName)};
+            u32 valueIndex = doc->nodes.numItems();
+            if (!readFlatExpression(doc, readToken(), propName, &colon))
+                return false;
+
+            u32 numChildren = ++doc->nodes[objectIndex].numTextBytesOrChildren;
+            if (numChildren > FlatDocument::LinearSearchLimit) {
+                // Large object: Index its properties so that duplicates are found quickly
+                if (!this->flatPropIndex) {
+                    this->flatPropIndex = new HashMap<FlatDocument::IndexTraits>;
+                }
+                u32 childIndex = valueIndex;
+                if (numChildren == FlatDocument::LinearSearchLimit + 1) {
+                    childIndex = objectIndex + 1;
+                }
+                while (childIndex < doc->nodes.numItems()) {
+                    auto cursor = this->flatPropIndex->insertOrFind(
+                        {objectIndex, doc->nodes[childIndex].name()}, &doc->nodes);
+                    *cursor = {objectIndex, childIndex};
+                    childIndex += doc->nodes[childIndex].numNodes;
+                }
+            }
+        }
+
+        prevProperty = std::move(firstToken);
+    }
+}
+
+bool Parser::readFlatArray(FlatDocument* doc, const Token& startToken, StringView name) {
+    PLY_ASSERT(startToken.type == Token::OpenSquare);
+    ScopeHandler arrayScope{*this, ParseError::Scope::array(startToken.location, 0)};
+    u32 arrayIndex = doc->nodes.numItems();
+    {
+        FlatDocument::Node& node = doc->nodes.append();
+        node.type = FlatDocument::Type::Array;
+        node.location = startToken.location;
+        node.nameBytes = name.bytes;
+        node.numNameBytes = name.numBytes;
+    }
+    Token sepTokenHolder;
+    Token* sepToken = nullptr;
+    for (;;) {
+        Token token = readToken(true);
+        switch (token.type) {
+            case Token::CloseSquare:
+                doc->nodes[arrayIndex].numNodes = doc->nodes.numItems() - arrayIndex;
+                return true;
+
+            case Token::Comma:
+            case Token::Semicolon:
+            case Token::NewLine:
+                sepTokenHolder = std::move(token);
+                sepToken = &sepTokenHolder;
+                break;
+
+            default: {
+                if (!readFlatExpression(doc, std::move(token), {}, sepToken))
+                    return false;
+                doc->nodes[arrayIndex].numTextBytesOrChildren++;
+                arrayScope.get().index++;
+                sepToken = nullptr;
+                break;
+            }
+        }
+    }
+}
+
+bool Parser::readFlatExpression(FlatDocument* doc, Token&& firstToken, StringView name,
+                                const Token* afterToken) {
+    switch (firstToken.type) {
+        case Token::OpenCurly:
+            return readFlatObject(doc, firstToken, name);
+
+        case Token::OpenSquare:
+            return readFlatArray(doc, firstToken, name);
+
+        case Token::Text: {
+            StringView text =
+                storeText(doc, std::move(firstToken.text), firstToken.isTextInSource);
+            FlatDocument::Node& node = doc->nodes.append();
+            node.type = FlatDocument::Type::Text;
+            node.location = firstToken.location;
+            node.nameBytes = name.bytes;
+            node.numNameBytes = name.numBytes;
+            node.textBytes = text.bytes;
+            node.numTextBytesOrChildren = text.numBytes;
+            return true;
+        }
+
+        case Token::Invalid:
+            return false;
+
+        default: {
+            StringWriter sw;
+            sw << "Unexpected " << toString(firstToken);
+            if (afterToken) {
+                sw << " after " << toString(*afterToken);
+            }
+            error(firstToken.location, sw.moveToString());
+            return false;
+        }
+    }
+}
+
+FlatDocument Parser::parseFlat(ConstBufferView srcView_) {
+    ViewInStream ins{srcView_};
+    Tokenizer tokenizer{&ins};
+    tokenizer.tabSize = this->tabSize;
+    PLY_SET_IN_SCOPE(this->tokenizer, &tokenizer);
+    this->flatPropIndex = nullptr;
+
+    FlatDocument doc;
+    Token rootToken = readToken();
+    if (!readFlatExpression(&doc, std::move(rootToken), {}))
+        return {};
+
+    Token nextToken = readToken();
+    if (nextToken.type != Token::EndOfFile) {
+        error(nextToken.location, String::format("Unexpected {} after {}", toString(nextToken),
+                                                 toString(doc.nodes[0])));
+        return {};
+    }
+
+    return doc;
+}
+
 } // namespace pylon
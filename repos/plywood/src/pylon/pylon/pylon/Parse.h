@@ -5,6 +5,8 @@
 #pragma once
 #include <pylon/Core.h>
 #include <pylon/Node.h>
+#include <pylon/FlatDocument.h>
+#include <pylon/Tokenizer.h>
 #include <ply-runtime/io/text/StringWriter.h>
 
 namespace pylon {
@@ -40,40 +42,21 @@ struct ParseError {
 
 class Parser {
 private:
-    struct Token {
-        enum Type {
-            Invalid,
-            OpenCurly,
-            CloseCurly,
-            OpenSquare,
-            CloseSquare,
-            Colon,
-            Equals,
-            Comma,
-            Semicolon,
-            Text,
-            Junk,
-            NewLine,
-            EndOfFile
-        };
-        Type type = Invalid;
-        Location location;
+    // Unlike pylon::Token, keeps its text, since Parser refers to earlier tokens after reading
+    // further ones.
+    struct Token : pylon::Token {
         HybridString text;
-
-        PLY_INLINE bool isValid() const {
-            return type != Type::Invalid;
-        }
+        bool isTextInSource = false; // text points into the source, which outlives the parse
     };
 
     Functor<void(const ParseError& err)> errorCallback;
     bool anyError_ = false;
-    ConstBufferView srcView;
-    u32 readOfs = 0;
-    s32 nextUnit = 0;
     u32 tabSize = 4;
-    Location location = {1, 1};
+    Tokenizer* tokenizer = nullptr; // Only valid during parse() and parseFlat()
     Token pushBackToken;
     Array<ParseError::Scope> context;
+    // Used by parseFlat to detect duplicate properties in large objects:
+    Owned<HashMap<FlatDocument::IndexTraits>> flatPropIndex;
 
     PLY_INLINE void pushBack(Token&& token) {
         pushBackToken = std::move(token);
@@ -100,17 +83,19 @@ private:
     };
 
     void error(Location location, HybridString&& message);
-    void advanceChar();
-    Token readPlainToken(Token::Type type);
-    bool readEscapedHex(OutStream* outs, Location escapeLoc);
-    Token readQuotedString();
-    Token readLiteral();
     Token readToken(bool tokenizeNewLine = false);
     static HybridString toString(const Token& token);
     static HybridString toString(const Node& node);
     Node readObject(const Token& startToken);
     Node readArray(const Token& startToken);
     Node readExpression(Token&& firstToken, const Token* afterToken = nullptr);
+    static HybridString toString(const FlatDocument::Node& node);
+    static StringView storeText(FlatDocument* doc, HybridString&& text, bool isTextInSource);
+    u32 findDuplicate(FlatDocument* doc, u32 objectIndex, StringView name);
+    bool readFlatObject(FlatDocument* doc, const Token& startToken, StringView name);
+    bool readFlatArray(FlatDocument* doc, const Token& startToken, StringView name);
+    bool readFlatExpression(FlatDocument* doc, Token&& firstToken, StringView name,
+                            const Token* afterToken = nullptr);
 
 public:
     PLY_INLINE void setTabSize(int tabSize_) {
@@ -128,6 +113,14 @@ public:
     PLY_INLINE Node parse(StringView srcView_) {
         return parse(srcView_.bufferView());
     }
+
+    // Like parse(), but returns a FlatDocument, which takes less time and memory to build. Returns
+    // an empty FlatDocument if there's an error. The FlatDocument refers to memory in srcView_.
+    FlatDocument parseFlat(ConstBufferView srcView_);
+
+    PLY_INLINE FlatDocument parseFlat(StringView srcView_) {
+        return parseFlat(srcView_.bufferView());
+    }
 };
 
 } // namespace pylon
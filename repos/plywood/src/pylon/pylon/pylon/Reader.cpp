@@ -0,0 +1,242 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <pylon/Core.h>
+#include <pylon/Reader.h>
+
+namespace pylon {
+
+Reader::Reader(InStream* ins) : tokenizer{ins} {
+}
+
+Reader::Event Reader::fail(Location location, HybridString&& message) {
+    if (this->errorCallback) {
+        ParseError err{location, std::move(message), context};
+        this->errorCallback.call(err);
+    }
+    this->anyError_ = true;
+    return {};
+}
+
+Token Reader::readToken(bool tokenizeNewLine) {
+    Token token = this->tokenizer.readToken(tokenizeNewLine);
+    if (!token.isValid()) {
+        fail(this->tokenizer.errorLocation, std::move(this->tokenizer.errorMessage));
+    }
+    return token;
+}
+
+// Called after each complete value.
+void Reader::endItem() {
+    if (!this->frames.isEmpty()) {
+        if (this->frames.back().isObject) {
+            this->frames.back().gotProperty = true;
+        } else {
+            this->context.back().index++;
+        }
+    }
+}
+
+Reader::Event Reader::readValue(Token&& firstToken, const Token* afterToken) {
+    switch (firstToken.type) {
+        case Token::OpenCurly: {
+            this->frames.append().isObject = true;
+            this->context.append(ParseError::Scope::object(firstToken.location));
+            return {Event::BeginObject, firstToken.location, {}};
+        }
+
+        case Token::OpenSquare: {
+            this->frames.append().isObject = false;
+            this->context.append(ParseError::Scope::array(firstToken.location, 0));
+            return {Event::BeginArray, firstToken.location, {}};
+        }
+
+        case Token::Text: {
+            endItem();
+            return {Event::Text, firstToken.location, this->text()};
+        }
+
+        case Token::Invalid:
+            return {};
+
+        default: {
+            StringWriter sw;
+            sw << "Unexpected " << toString(firstToken);
+            if (afterToken) {
+                sw << " after " << toString(*afterToken);
+            }
+            return fail(firstToken.location, sw.moveToString());
+        }
+    }
+}
+
+Reader::Event Reader::next() {
+    if (this->anyError_)
+        return {};
+
+    if (this->frames.isEmpty()) {
+        if (!this->readRoot) {
+            this->readRoot = true;
+            return readValue(readToken());
+        }
+        Token token = readToken();
+        if (token.type != Token::EndOfFile)
+            return fail(token.location,
+                        String::format("Unexpected {} after root value", toString(token)));
+        return {Event::EndOfFile, token.location, {}};
+    }
+
+    if (this->frames.back().isObject) {
+        if (this->frames.back().afterKey) {
+            this->frames.back().afterKey = false;
+            Token colon = readToken();
+            if (colon.type != Token::Colon && colon.type != Token::Equals)
+                return fail(colon.location, String::format(
+                                                "Expected \":\" or \"=\" after property, got {}",
+                                                toString(colon)));
+            return readValue(readToken(), &colon);
+        }
+
+        bool gotSeparator = false;
+        for (;;) {
+            Token token = readToken(true);
+            switch (token.type) {
+                case Token::CloseCurly: {
+                    this->frames.pop();
+                    this->context.pop();
+                    endItem();
+                    return {Event::EndObject, token.location, {}};
+                }
+
+                case Token::Comma:
+                case Token::Semicolon:
+                case Token::NewLine:
+                    gotSeparator = true;
+                    break;
+
+                case Token::Text: {
+                    Frame& frame = this->frames.back();
+                    if (frame.gotProperty && !gotSeparator)
+                        return fail(token.location,
+                                    String::format("Expected a comma, semicolon or newline "
+                                                   "separator before property \"{}\"",
+                                                   fmt::EscapedString{this->text(), 20}));
+                    frame.gotProperty = false;
+                    frame.afterKey = true;
+                    return {Event::Key, token.location, this->text()};
+                }
+
+                case Token::Invalid:
+                    return {};
+
+                default: {
+                    if (this->frames.back().gotProperty)
+                        return fail(token.location, String::format("Unexpected {} after property",
+                                                                   toString(token)));
+                    return fail(token.location,
+                                String::format("Expected property, got {}", toString(token)));
+                }
+            }
+        }
+    } else {
+        Token sepToken;
+        for (;;) {
+            Token token = readToken(true);
+            switch (token.type) {
+                case Token::CloseSquare: {
+                    this->frames.pop();
+                    this->context.pop();
+                    endItem();
+                    return {Event::EndArray, token.location, {}};
+                }
+
+                case Token::Comma:
+                case Token::Semicolon:
+                case Token::NewLine:
+                    sepToken = token;
+                    break;
+
+                default:
+                    return readValue(std::move(token), sepToken.type != Token::Invalid ? &sepToken
+                                                                                      : nullptr);
+            }
+        }
+    }
+}
+
+bool Reader::skipValue(const Event& event) {
+    if (event.type == Event::Text)
+        return true;
+    if (event.type != Event::BeginObject && event.type != Event::BeginArray)
+        return false;
+    u32 depth = 1;
+    while (depth > 0) {
+        Event e = next();
+        switch (e.type) {
+            case Event::BeginObject:
+            case Event::BeginArray:
+                depth++;
+                break;
+
+            case Event::EndObject:
+            case Event::EndArray:
+                depth--;
+                break;
+
+            case Event::Key:
+            case Event::Text:
+                break;
+
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+Node Reader::readNode(const Event& event) {
+    switch (event.type) {
+        case Event::Text:
+            return Node::createText(HybridString::copy(event.text), event.location);
+
+        case Event::BeginObject: {
+            Node node = Node::createObject(event.location);
+            for (;;) {
+                Event keyEvent = next();
+                if (keyEvent.type == Event::EndObject)
+                    return node;
+                if (keyEvent.type != Event::Key)
+                    return {};
+                if (node.object().find(keyEvent.text).isValid()) {
+                    fail(keyEvent.location, String::format("Duplicate property \"{}\"",
+                                                           fmt::EscapedString{keyEvent.text, 20}));
+                    return {};
+                }
+                HybridString name = HybridString::copy(keyEvent.text);
+                Node value = readNode(next());
+                if (!value.isValid())
+                    return {};
+                node.object().add(std::move(name)).value = std::move(value);
+            }
+        }
+
+        case Event::BeginArray: {
+            Node node = Node::createArray(event.location);
+            for (;;) {
+                Event itemEvent = next();
+                if (itemEvent.type == Event::EndArray)
+                    return node;
+                Node item = readNode(itemEvent);
+                if (!item.isValid())
+                    return {};
+                node.array().append(std::move(item));
+            }
+        }
+
+        default:
+            return {};
+    }
+}
+
+} // namespace pylon
@@ -0,0 +1,84 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <pylon/Core.h>
+#include <pylon/Parse.h>
+#include <pylon/Tokenizer.h>
+
+namespace pylon {
+
+// A Reader reads Pylon from an InStream one event at a time, without building a tree of Nodes.
+// Each call to next() returns the next event. An object produces BeginObject, then a Key event
+// followed by the events of its value for each property, then EndObject. Arrays produce
+// BeginArray, the events of each item, then EndArray. After the root value, next() returns
+// EndOfFile. If there's an error, next() returns an Invalid event.
+//
+// The text of Key and Text events is only valid until the next call to next(). Unlike Parser,
+// Reader doesn't detect duplicate properties, except inside readNode().
+class Reader {
+public:
+    struct Event {
+        enum Type { Invalid, BeginObject, EndObject, BeginArray, EndArray, Key, Text, EndOfFile };
+        Type type = Invalid;
+        Location location = {0, 0};
+        StringView text; // Key and Text only
+
+        PLY_INLINE bool isValid() const {
+            return type != Type::Invalid;
+        }
+    };
+
+private:
+    struct Frame {
+        bool isObject = false;
+        bool gotProperty = false; // No separator was read since the last property
+        bool afterKey = false;    // A Key event was returned; its value comes next
+    };
+
+    Tokenizer tokenizer;
+    Functor<void(const ParseError& err)> errorCallback;
+    bool anyError_ = false;
+    bool readRoot = false;
+    Array<Frame> frames;
+    Array<ParseError::Scope> context;
+
+    PLY_INLINE StringView text() const {
+        return this->tokenizer.text();
+    }
+    PLY_INLINE HybridString toString(const Token& token) const {
+        return Tokenizer::toString(token, this->tokenizer.text());
+    }
+
+    Event fail(Location location, HybridString&& message);
+    Token readToken(bool tokenizeNewLine = false);
+    void endItem();
+    Event readValue(Token&& firstToken, const Token* afterToken = nullptr);
+
+public:
+    Reader(InStream* ins);
+
+    PLY_INLINE void setTabSize(int tabSize_) {
+        tokenizer.tabSize = tabSize_;
+    }
+    PLY_INLINE void setErrorCallback(Functor<void(const ParseError& err)>&& cb) {
+        this->errorCallback = std::move(cb);
+    }
+    PLY_INLINE bool anyError() const {
+        return this->anyError_;
+    }
+
+    Event next();
+
+    // Skips over the value that begins with event, which must be the event that was just returned
+    // by next(). Returns false if there's an error.
+    bool skipValue(const Event& event);
+
+    // Reads the value that begins with event into a tree of Nodes, which is useful for parts of
+    // the input that can't be handled one event at a time. Returns an invalid Node if there's an
+    // error.
+    Node readNode(const Event& event);
+};
+
+} // namespace pylon
@@ -0,0 +1,343 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <pylon/Core.h>
+#include <pylon/Tokenizer.h>
+#include <string.h>
+
+namespace pylon {
+
+bool isAlnumUnit(u32 c) {
+    return (c == '_') || (c == '$') || (c == '-') || (c == '.') || (c >= 'a' && c <= 'z') ||
+           (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || (c >= 128);
+}
+
+Tokenizer::Tokenizer(InStream* ins) : ins{ins} {
+    this->nextUnit = ins->tryMakeBytesAvailable() ? (u8) ins->readByte() : -1;
+}
+
+Token Tokenizer::fail(Location location, HybridString&& message) {
+    this->errorLocation = location;
+    this->errorMessage = std::move(message);
+    return {};
+}
+
+void Tokenizer::advanceChar() {
+    switch (nextUnit) {
+        case '\r':
+        case -1:
+            break;
+
+        case '\t':
+            location.column = ((location.column + tabSize - 1) / tabSize) * tabSize + 1;
+            break;
+
+        case '\n':
+            location.line++;
+            location.column = 1;
+            break;
+
+        default:
+            location.column++;
+            break;
+    }
+
+    nextUnit = ins->tryMakeBytesAvailable() ? (u8) ins->readByte() : -1;
+}
+
+Token Tokenizer::readPlainToken(Token::Type type) {
+    Token result = {type, location};
+    advanceChar();
+    return result;
+}
+
+bool Tokenizer::readEscapedHex(Location escapeLoc) {
+    // Exactly two hex digits, which encode a single byte
+    u32 value = 0;
+    for (u32 i = 0; i < 2; i++) {
+        u32 digit;
+        if (nextUnit >= '0' && nextUnit <= '9') {
+            digit = nextUnit - '0';
+        } else if (nextUnit >= 'a' && nextUnit <= 'f') {
+            digit = nextUnit - 'a' + 10;
+        } else if (nextUnit >= 'A' && nextUnit <= 'F') {
+            digit = nextUnit - 'A' + 10;
+        } else {
+            fail(escapeLoc, "Expected two hex digits after \"\\x\"");
+            return false;
+        }
+        value = value * 16 + digit;
+        advanceChar();
+    }
+    appendText((char) value);
+    return true;
+}
+
+Token Tokenizer::readQuotedString() {
+    PLY_ASSERT(nextUnit == '"' || nextUnit == '\'');
+    Token token = {Token::Type::Text, location};
+    s32 endByte = nextUnit;
+
+    {
+        // Fast path: A non-empty, single-line string without escape sequences whose closing quote
+        // is already in the InStream's buffer. If the InStream is a view, the text points into the
+        // source.
+        const u8* start = ins->curByte;
+        const u8* end = start;
+        while (end < ins->endByte) {
+            u8 c = *end;
+            if (c == endByte || c == '\\' || c == '\r' || c == '\n')
+                break;
+            end++;
+        }
+        if (end > start && end < ins->endByte && *end == endByte) {
+            u32 numBytes = safeDemote<u32>(end - start);
+            if (ins->isView()) {
+                this->text_ = {(const char*) start, numBytes};
+                this->isTextInSource_ = true;
+            } else {
+                // Copy before advancing, since advancing can replace the buffer
+                this->textLength = 0;
+                if (numBytes > this->textBuffer.numBytes) {
+                    this->textBuffer.resize(numBytes);
+                }
+                memcpy(this->textBuffer.bytes, start, numBytes);
+                this->textLength = numBytes;
+                endText();
+            }
+            // Advance past the opening quote, the contents and the closing quote
+            for (u32 i = 0; i < numBytes + 2; i++) {
+                advanceChar();
+            }
+            return token;
+        }
+    }
+
+    this->textLength = 0;
+    u32 quoteRun = 1;
+    bool multiline = false;
+    advanceChar();
+
+    for (;;) {
+        if (nextUnit == endByte) {
+            advanceChar();
+            if (quoteRun == 0) {
+                if (multiline) {
+                    quoteRun++;
+                } else {
+                    break; // end of string
+                }
+            } else {
+                quoteRun++;
+                if (quoteRun == 3) {
+                    if (multiline) {
+                        break; // end of string
+                    } else {
+                        multiline = true;
+                        quoteRun = 0;
+                    }
+                }
+            }
+        } else {
+            if (quoteRun > 0) {
+                if (multiline) {
+                    for (u32 i = 0; i < quoteRun; i++) {
+                        appendText((char) endByte);
+                    }
+                } else if (quoteRun == 2) {
+                    break; // empty string
+                }
+                quoteRun = 0;
+            }
+
+            switch (nextUnit) {
+                case -1: {
+                    return fail(location, "Unexpected end of file in string literal");
+                }
+
+                case '\r':
+                case '\n': {
+                    if (multiline) {
+                        if (nextUnit == '\n') {
+                            appendText((char) nextUnit);
+                        }
+                        advanceChar();
+                    } else {
+                        return fail(location, "Unexpected end of line in string literal");
+                    }
+                    break;
+                }
+
+                case '\\': {
+                    // Escape sequence
+                    Location escapeLoc = location;
+                    advanceChar();
+                    s32 code = nextUnit;
+                    advanceChar();
+                    switch (code) {
+                        case -1: {
+                            return fail(location, "Unexpected end of file in string literal");
+                        }
+
+                        case '\r':
+                        case '\n': {
+                            return fail(location, "Unexpected end of line in string literal");
+                        }
+
+                        case '\\':
+                        case '\'':
+                        case '"': {
+                            appendText((char) code);
+                            break;
+                        }
+
+                        case 'r': {
+                            appendText('\r');
+                            break;
+                        }
+
+                        case 'n': {
+                            appendText('\n');
+                            break;
+                        }
+
+                        case 't': {
+                            appendText('\t');
+                            break;
+                        }
+
+                        case 'x': {
+                            if (!readEscapedHex(escapeLoc))
+                                return {}; // FIXME: Would be better to continue reading the
+                                           // rest of the string
+                            break;
+                        }
+
+                        default: {
+                            return fail(escapeLoc,
+                                        String::format("Unrecognized escape sequence \"\\{}\"",
+                                                       (char) code));
+                        }
+                    }
+                    break;
+                }
+
+                default: {
+                    appendText((char) nextUnit);
+                    advanceChar();
+                    break;
+                }
+            }
+        }
+    }
+
+    endText();
+    return token;
+}
+
+Token Tokenizer::readLiteral() {
+    PLY_ASSERT(isAlnumUnit(nextUnit));
+    Token token = {Token::Text, location};
+    if (ins->isView()) {
+        // nextUnit was the last byte read from the view
+        const u8* start = ins->curByte - 1;
+        while (nextUnit >= 0 && isAlnumUnit(nextUnit)) {
+            advanceChar();
+        }
+        const u8* end = (nextUnit >= 0) ? ins->curByte - 1 : ins->curByte;
+        this->text_ = {(const char*) start, safeDemote<u32>(end - start)};
+        this->isTextInSource_ = true;
+    } else {
+        this->textLength = 0;
+        while (nextUnit >= 0 && isAlnumUnit(nextUnit)) {
+            appendText((char) nextUnit);
+            advanceChar();
+        }
+        endText();
+    }
+    return token;
+}
+
+Token Tokenizer::readToken(bool tokenizeNewLine) {
+    for (;;) {
+        switch (nextUnit) {
+            case ' ':
+            case '\t':
+            case '\r':
+                advanceChar();
+                break;
+
+            case '\n': {
+                Location newLineLoc = location;
+                advanceChar();
+                if (tokenizeNewLine)
+                    return {Token::NewLine, newLineLoc};
+                break;
+            }
+
+            case -1:
+                return {Token::EndOfFile, location};
+            case '{':
+                return readPlainToken(Token::OpenCurly);
+            case '}':
+                return readPlainToken(Token::CloseCurly);
+            case '[':
+                return readPlainToken(Token::OpenSquare);
+            case ']':
+                return readPlainToken(Token::CloseSquare);
+            case ':':
+                return readPlainToken(Token::Colon);
+            case '=':
+                return readPlainToken(Token::Equals);
+            case ',':
+                return readPlainToken(Token::Comma);
+            case ';':
+                return readPlainToken(Token::Semicolon);
+
+            case '"':
+            case '\'':
+                return readQuotedString();
+
+            default:
+                if (isAlnumUnit(nextUnit))
+                    return readLiteral();
+                else
+                    return {Token::Junk, location};
+        }
+    }
+}
+
+HybridString Tokenizer::toString(const Token& token, StringView text) {
+    switch (token.type) {
+        case Token::OpenCurly:
+            return "\"{\"";
+        case Token::CloseCurly:
+            return "\"}\"";
+        case Token::OpenSquare:
+            return "\"[\"";
+        case Token::CloseSquare:
+            return "\"]\"";
+        case Token::Colon:
+            return "\":\"";
+        case Token::Equals:
+            return "\"=\"";
+        case Token::Comma:
+            return "\",\"";
+        case Token::Semicolon:
+            return "\";\"";
+        case Token::Text:
+            return String::format("text \"{}\"", fmt::EscapedString{text, 20});
+        case Token::Junk:
+            return "junk";
+        case Token::NewLine:
+            return "newline";
+        case Token::EndOfFile:
+            return "end of file";
+        default:
+            PLY_ASSERT(0);
+            return "???";
+    }
+}
+
+} // namespace pylon
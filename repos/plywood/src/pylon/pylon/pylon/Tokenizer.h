@@ -0,0 +1,95 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <pylon/Core.h>
+#include <pylon/Node.h>
+#include <ply-runtime/io/InStream.h>
+
+namespace pylon {
+
+// Returns true if c can appear in an unquoted literal.
+bool isAlnumUnit(u32 c);
+
+struct Token {
+    enum Type {
+        Invalid,
+        OpenCurly,
+        CloseCurly,
+        OpenSquare,
+        CloseSquare,
+        Colon,
+        Equals,
+        Comma,
+        Semicolon,
+        Text, // Contents are returned by Tokenizer::text()
+        Junk,
+        NewLine,
+        EndOfFile
+    };
+    Type type = Invalid;
+    Location location;
+
+    PLY_INLINE bool isValid() const {
+        return type != Type::Invalid;
+    }
+};
+
+// Splits Pylon source into tokens. Used by both Parser and Reader.
+//
+// The text of a Text token is returned by text() and is only valid until the next call to
+// readToken(), unless isTextInSource() returns true. That happens when the InStream is a view and
+// the text needed no unescaping, in which case text() points into the source memory.
+//
+// If there's an error, readToken() returns an Invalid token and fills in errorLocation and
+// errorMessage. It's up to the caller to report it.
+class Tokenizer {
+private:
+    InStream* ins = nullptr;
+    s32 nextUnit = 0;
+    String textBuffer;
+    u32 textLength = 0;
+    StringView text_;
+    bool isTextInSource_ = false;
+
+    PLY_INLINE void appendText(char c) {
+        if (this->textLength >= this->textBuffer.numBytes) {
+            this->textBuffer.resize(max<u32>(this->textBuffer.numBytes * 2, 64));
+        }
+        this->textBuffer.bytes[this->textLength++] = c;
+    }
+    PLY_INLINE void endText() {
+        this->text_ = {this->textBuffer.bytes, this->textLength};
+        this->isTextInSource_ = false;
+    }
+
+    Token fail(Location location, HybridString&& message);
+    void advanceChar();
+    Token readPlainToken(Token::Type type);
+    bool readEscapedHex(Location escapeLoc);
+    Token readQuotedString();
+    Token readLiteral();
+
+public:
+    u32 tabSize = 4;
+    Location location = {1, 1};
+    Location errorLocation = {0, 0};
+    HybridString errorMessage;
+
+    Tokenizer(InStream* ins);
+
+    Token readToken(bool tokenizeNewLine = false);
+
+    PLY_INLINE StringView text() const {
+        return this->text_;
+    }
+    PLY_INLINE bool isTextInSource() const {
+        return this->isTextInSource_;
+    }
+
+    // text is only used for Text tokens.
+    static HybridString toString(const Token& token, StringView text);
+};
+
+} // namespace pylon
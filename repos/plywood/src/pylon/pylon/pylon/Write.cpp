@@ -7,63 +7,98 @@
 
 namespace pylon {
 
-struct WriteContext {
-    StringWriter* sw;
-    int depth = 0;
+PLY_NO_INLINE void Writer::indent() {
+    for (u32 i = 0; i < this->frames.numItems(); i++) {
+        *this->sw << "  ";
+    }
+}
 
-    PLY_INLINE WriteContext(OutStream* outs) : sw{outs->strWriter()} {
+// Starts a new line for the next property or array item.
+PLY_NO_INLINE void Writer::beginItem() {
+    Frame& frame = this->frames.back();
+    if (frame.numItems > 0) {
+        *this->sw << ',';
     }
+    *this->sw << '\n';
+    indent();
+    frame.numItems++;
+}
 
-    PLY_NO_INLINE void indent() {
-        for (int i = 0; i < depth; i++) {
-            *this->sw << "  ";
-        }
+PLY_NO_INLINE void Writer::beginValue() {
+    if (this->frames.isEmpty())
+        return;
+    if (this->frames.back().isObject) {
+        PLY_ASSERT(this->afterKey);
+        this->afterKey = false;
+    } else {
+        beginItem();
     }
+}
+
+PLY_NO_INLINE void Writer::endContainer(char closeChar) {
+    this->frames.pop();
+    *this->sw << '\n';
+    indent();
+    *this->sw << closeChar;
+}
+
+PLY_NO_INLINE void Writer::beginObject() {
+    beginValue();
+    *this->sw << '{';
+    this->frames.append({true, 0});
+}
+
+PLY_NO_INLINE void Writer::endObject() {
+    PLY_ASSERT(this->frames.back().isObject);
+    this->afterKey = false;
+    endContainer('}');
+}
 
-    PLY_NO_INLINE void write(const Node& aNode) {
-        if (aNode.isObject()) {
-            *this->sw << "{\n";
-            this->depth++;
-            const Node::Object& objNode = aNode.object();
-            u32 numItems = objNode.items.numItems();
-            for (u32 i : range(numItems)) {
-                const Node::Object::Item& objItem = objNode.items[i];
-                indent();
-                this->sw->format("\"{}\": ", fmt::EscapedString{objItem.name});
-                write(objItem.value);
-                if (i + 1 < numItems) {
-                    *this->sw << ',';
-                }
-                *this->sw << '\n';
-            }
-            this->depth--;
-            indent();
-            *this->sw << '}';
-        } else if (aNode.isArray()) {
-            *this->sw << "[\n";
-            this->depth++;
-            const ply::Array<Node>& arrNode = aNode.array();
-            u32 numItems = arrNode.numItems();
-            for (u32 i : range(numItems)) {
-                indent();
-                write(arrNode[i]);
-                if (i + 1 < numItems) {
-                    *this->sw << ',';
-                }
-                *this->sw << '\n';
-            }
-            this->depth--;
-            indent();
-            *this->sw << ']';
-        } else if (aNode.isText()) {
-            this->sw->format("\"{}\"", fmt::EscapedString{aNode.text()});
+PLY_NO_INLINE void Writer::key(StringView name) {
+    PLY_ASSERT(this->frames.back().isObject);
+    beginItem();
+    this->sw->format("\"{}\": ", fmt::EscapedString{name});
+    this->afterKey = true;
+}
+
+PLY_NO_INLINE void Writer::beginArray() {
+    beginValue();
+    *this->sw << '[';
+    this->frames.append({false, 0});
+}
+
+PLY_NO_INLINE void Writer::endArray() {
+    PLY_ASSERT(!this->frames.back().isObject);
+    endContainer(']');
+}
+
+PLY_NO_INLINE void Writer::text(StringView text) {
+    beginValue();
+    this->sw->format("\"{}\"", fmt::EscapedString{text});
+}
+
+PLY_NO_INLINE void writeNode(Writer& writer, const Node& aNode) {
+    if (aNode.isObject()) {
+        writer.beginObject();
+        for (const Node::Object::Item& objItem : aNode.object().items) {
+            writer.key(objItem.name);
+            writeNode(writer, objItem.value);
         }
+        writer.endObject();
+    } else if (aNode.isArray()) {
+        writer.beginArray();
+        for (const Node& item : aNode.array()) {
+            writeNode(writer, item);
+        }
+        writer.endArray();
+    } else if (aNode.isText()) {
+        writer.text(aNode.text());
     }
-};
+}
 
 PLY_NO_INLINE void write(OutStream* outs, const Node& aNode) {
-    WriteContext ctx{outs};
-    ctx.write(aNode);
+    Writer writer{outs};
+    writeNode(writer, aNode);
 }
 
 PLY_NO_INLINE String toString(const Node& aNode) {
@@ -9,6 +9,37 @@
 
 namespace pylon {
 
+// A Writer writes Pylon to an OutStream one value at a time, without building a tree of Nodes.
+// Every beginObject() or beginArray() must have a matching endObject() or endArray(), and inside
+// an object, each value must be preceded by a call to key(). The output is the same as write().
+class Writer {
+private:
+    struct Frame {
+        bool isObject;
+        u32 numItems;
+    };
+
+    StringWriter* sw;
+    Array<Frame> frames;
+    bool afterKey = false;
+
+    void indent();
+    void beginItem();
+    void beginValue();
+    void endContainer(char closeChar);
+
+public:
+    PLY_INLINE Writer(OutStream* outs) : sw{outs->strWriter()} {
+    }
+
+    void beginObject();
+    void endObject();
+    void key(StringView name);
+    void beginArray();
+    void endArray();
+    void text(StringView text);
+};
+
 void write(OutStream* outs, const Node& aNode);
 String toString(const Node& aNode);
 
@@ -4,69 +4,153 @@
 ------------------------------------*/
 #include <pylon-reflect/Core.h>
 #include <pylon-reflect/Export.h>
+#include <pylon-reflect/TypePlan.h>
 
 namespace pylon {
 
-PLY_NO_INLINE void exportObjTo(Node& aNode, TypedPtr obj, const FilterFunc& filter) {
-    if (filter && filter(aNode, obj))
+PLY_NO_INLINE u32 readEnumValue(const void* ptr, u32 fixedSize) {
+    if (fixedSize == 1) {
+        return *(const u8*) ptr;
+    } else if (fixedSize == 2) {
+        return *(const u16*) ptr;
+    } else if (fixedSize == 4) {
+        return *(const u32*) ptr;
+    } else {
+        PLY_ASSERT(0);
+        return 0;
+    }
+}
+
+PLY_NO_INLINE void exportTo(Node& aNode, const TypePlan* plan, void* ptr,
+                            const FilterFunc& filter) {
+    if (filter && filter(aNode, {ptr, plan->type}))
         return;
 
-    if (obj.type->typeKey == &TypeKey_Struct) {
-        const TypeDescriptor_Struct* structType = obj.type->cast<TypeDescriptor_Struct>();
-        auto objNode = aNode.type.object().switchTo();
-        for (const TypeDescriptor_Struct::Member& member : structType->members) {
-            Node::Object::Item& objItem = objNode->obj.add(member.name.view());
-            exportObjTo(objItem.value, {PLY_PTR_OFFSET(obj.ptr, member.offset), member.type},
-                        filter);
+    switch (plan->kind) {
+        case TypePlan::Struct: {
+            auto objNode = aNode.type.object().switchTo();
+            for (const TypePlan::Member& member : plan->members) {
+                Node::Object::Item& objItem = objNode->obj.add(member.name);
+                exportTo(objItem.value, member.plan, PLY_PTR_OFFSET(ptr, member.offset), filter);
+            }
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_String) {
-        auto text = aNode.type.text().switchTo();
-        text->str = ((String*) obj.ptr)->view();
-    } else if (obj.type->typeKey == &TypeKey_Array) {
-        const TypeDescriptor_Array* arrayType = obj.type->cast<TypeDescriptor_Array>();
-        TypeDescriptor* itemType = arrayType->itemType;
-        u32 itemSize = itemType->fixedSize;
-        details::BaseArray* arr = (details::BaseArray*) obj.ptr;
-        auto arrNode = aNode.type.array().switchTo();
-        arrNode->arr.resize(arr->m_numItems);
-        for (u32 i : range(arr->m_numItems)) {
-            exportObjTo(arrNode->arr[i], {PLY_PTR_OFFSET(arr->m_items, itemSize * i), itemType},
-                        filter);
+
+        case TypePlan::String: {
+            auto text = aNode.type.text().switchTo();
+            text->str = ((String*) ptr)->view();
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_Switch) {
-        const TypeDescriptor_Switch* switchType = obj.type->cast<TypeDescriptor_Switch>();
-        u16 id = *(u16*) obj.ptr;
-        auto objNode = aNode.type.object().switchTo();
-        Node::Object::Item& objItem = objNode->obj.add(switchType->states[id].name.view());
-        TypedPtr typedState{PLY_PTR_OFFSET(obj.ptr, switchType->storageOffset),
-                            switchType->states[id].structType};
-        exportObjTo(objItem.value, typedState, filter);
-    } else if (obj.type->typeKey == &TypeKey_Bool) {
-        auto text = aNode.type.text().switchTo();
-        text->str = *(bool*) obj.ptr ? "true" : "false";
-    } else if (obj.type->typeKey == &TypeKey_Enum) {
-        const TypeDescriptor_Enum* enumType = obj.type->cast<TypeDescriptor_Enum>();
-        // FIXME: Make this a function
-        u32 enumValue = 0;
-        if (enumType->fixedSize == 1) {
-            enumValue = *(u8*) obj.ptr;
-        } else if (enumType->fixedSize == 2) {
-            enumValue = *(u16*) obj.ptr;
-        } else if (enumType->fixedSize == 4) {
-            enumValue = *(u32*) obj.ptr;
-        } else {
-            PLY_ASSERT(0);
+
+        case TypePlan::Array: {
+            u32 itemSize = plan->itemPlan->type->fixedSize;
+            details::BaseArray* arr = (details::BaseArray*) ptr;
+            auto arrNode = aNode.type.array().switchTo();
+            arrNode->arr.resize(arr->m_numItems);
+            for (u32 i : range(arr->m_numItems)) {
+                exportTo(arrNode->arr[i], plan->itemPlan,
+                         PLY_PTR_OFFSET(arr->m_items, itemSize * i), filter);
+            }
+            break;
+        }
+
+        case TypePlan::Switch: {
+            u16 id = *(u16*) ptr;
+            const TypePlan::Member& state = plan->members[id];
+            auto objNode = aNode.type.object().switchTo();
+            Node::Object::Item& objItem = objNode->obj.add(state.name);
+            exportTo(objItem.value, state.plan, PLY_PTR_OFFSET(ptr, plan->storageOffset), filter);
+            break;
+        }
+
+        case TypePlan::Bool: {
+            auto text = aNode.type.text().switchTo();
+            text->str = *(bool*) ptr ? "true" : "false";
+            break;
+        }
+
+        case TypePlan::Enum: {
+            u32 enumValue = readEnumValue(ptr, plan->type->fixedSize);
+            aNode = pylon::Node::createText(
+                plan->type->cast<TypeDescriptor_Enum>()->findValue(enumValue)->name.view(), {});
+            break;
+        }
+
+        default: {
+            PLY_ASSERT(0); // Unsupported
+            break;
         }
-        aNode = pylon::Node::createText(enumType->findValue(enumValue)->name.view(), {});
-    } else {
-        PLY_ASSERT(0); // Unsupported
     }
 }
 
+PLY_NO_INLINE void writeTo(Writer& writer, const TypePlan* plan, void* ptr) {
+    switch (plan->kind) {
+        case TypePlan::Struct: {
+            writer.beginObject();
+            for (const TypePlan::Member& member : plan->members) {
+                writer.key(member.name);
+                writeTo(writer, member.plan, PLY_PTR_OFFSET(ptr, member.offset));
+            }
+            writer.endObject();
+            break;
+        }
+
+        case TypePlan::String: {
+            writer.text(*(String*) ptr);
+            break;
+        }
+
+        case TypePlan::Array: {
+            u32 itemSize = plan->itemPlan->type->fixedSize;
+            details::BaseArray* arr = (details::BaseArray*) ptr;
+            writer.beginArray();
+            for (u32 i : range(arr->m_numItems)) {
+                writeTo(writer, plan->itemPlan, PLY_PTR_OFFSET(arr->m_items, itemSize * i));
+            }
+            writer.endArray();
+            break;
+        }
+
+        case TypePlan::Switch: {
+            u16 id = *(u16*) ptr;
+            const TypePlan::Member& state = plan->members[id];
+            writer.beginObject();
+            writer.key(state.name);
+            writeTo(writer, state.plan, PLY_PTR_OFFSET(ptr, plan->storageOffset));
+            writer.endObject();
+            break;
+        }
+
+        case TypePlan::Bool: {
+            writer.text(*(bool*) ptr ? "true" : "false");
+            break;
+        }
+
+        case TypePlan::Enum: {
+            u32 enumValue = readEnumValue(ptr, plan->type->fixedSize);
+            writer.text(plan->type->cast<TypeDescriptor_Enum>()->findValue(enumValue)->name);
+            break;
+        }
+
+        default: {
+            PLY_ASSERT(0); // Unsupported
+            break;
+        }
+    }
+}
+
+PLY_NO_INLINE void exportObjTo(Node& aNode, TypedPtr obj, const FilterFunc& filter) {
+    exportTo(aNode, g_typePlans.get(obj.type), obj.ptr, filter);
+}
+
 PLY_NO_INLINE pylon::Node exportObj(TypedPtr obj, const FilterFunc& filter) {
     pylon::Node node;
     exportObjTo(node, obj, filter);
     return node;
 }
 
+PLY_NO_INLINE void exportObjTo(Writer& writer, TypedPtr obj) {
+    writeTo(writer, g_typePlans.get(obj.type), obj.ptr);
+}
+
 } // namespace pylon
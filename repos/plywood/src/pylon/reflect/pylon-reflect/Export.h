@@ -5,6 +5,7 @@
 #pragma once
 #include <pylon-reflect/Core.h>
 #include <pylon/Node.h>
+#include <pylon/Write.h>
 #include <ply-reflect/TypeDescriptor.h>
 
 namespace pylon {
@@ -12,5 +13,7 @@ namespace pylon {
 using FilterFunc = HiddenArgFunctor<bool(Node&, TypedPtr)>;
 void exportObjTo(Node& aNode, TypedPtr obj, const FilterFunc& filter);
 Node exportObj(TypedPtr obj, const FilterFunc& filter = {});
+// Writes obj directly to writer, without building a tree of Nodes.
+void exportObjTo(Writer& writer, TypedPtr obj);
 
 } // namespace pylon
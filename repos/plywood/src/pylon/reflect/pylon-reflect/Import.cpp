@@ -4,6 +4,7 @@
 ------------------------------------*/
 #include <pylon-reflect/Core.h>
 #include <pylon-reflect/Import.h>
+#include <pylon-reflect/TypePlan.h>
 #include <ply-reflect/SavedTypedPtr.h>
 #include <ply-reflect/TypeDescriptorOwner.h>
 #include <ply-reflect/TypedArray.h>
@@ -98,162 +99,349 @@ PLY_NO_INLINE TypeDescriptorOwner* convertTypeFrom(const Node& aNode,
     return importer.typeOwner;
 }
 
-PLY_NO_INLINE void convertFrom(TypedPtr obj, const Node& aNode,
+PLY_NO_INLINE void writeEnumValue(void* ptr, u32 fixedSize, u32 value) {
+    if (fixedSize == 1) {
+        PLY_ASSERT(value <= UINT8_MAX);
+        *(u8*) ptr = (u8) value;
+    } else if (fixedSize == 2) {
+        PLY_ASSERT(value <= UINT16_MAX);
+        *(u16*) ptr = (u16) value;
+    } else if (fixedSize == 4) {
+        *(u32*) ptr = value;
+    } else {
+        PLY_ASSERT(0);
+    }
+}
+
+void convertFrom(const TypePlan* plan, void* ptr, const Node& aNode,
+                 const Functor<TypeFromName>& typeFromName);
+
+// SavedTypedPtr and TypedArray contain types that are synthesized during import. Their plans go in
+// a temporary cache so that g_typePlans never refers to a destroyed type.
+PLY_NO_INLINE void convertSynthesizedFrom(TypedPtr obj, const Node& aNode,
+                                          const Functor<TypeFromName>& typeFromName) {
+    TypePlanCache localPlans;
+    convertFrom(localPlans.get(obj.type), obj.ptr, aNode, typeFromName);
+}
+
+PLY_NO_INLINE void convertFrom(const TypePlan* plan, void* ptr, const Node& aNode,
                                const Functor<TypeFromName>& typeFromName) {
     auto error = [&] {}; // FIXME: Decide where these go
 
     PLY_ASSERT(aNode.isValid());
     // FIXME: Handle errors gracefully by logging a message, returning false and marking the
     // cook as failed (instead of asserting).
-    if (obj.type->typeKey == &TypeKey_Struct) {
-        PLY_ASSERT(aNode.isObject());
-        auto* structDesc = obj.type->cast<TypeDescriptor_Struct>();
-        for (const TypeDescriptor_Struct::Member& member : structDesc->members) {
-            const auto& aMember = aNode[member.name];
-            if (aMember.isValid()) {
-                TypedPtr m{PLY_PTR_OFFSET(obj.ptr, member.offset), member.type};
-                convertFrom(m, aMember, typeFromName);
+    switch (plan->kind) {
+        case TypePlan::Struct: {
+            PLY_ASSERT(aNode.isObject());
+            u32 hint = 0;
+            for (const Node::Object::Item& item : aNode.object().items) {
+                s32 i = plan->findMember(item.name, hint);
+                if (i >= 0) {
+                    const TypePlan::Member& member = plan->members[i];
+                    convertFrom(member.plan, PLY_PTR_OFFSET(ptr, member.offset), item.value,
+                                typeFromName);
+                    hint = i + 1;
+                }
             }
+            break;
+        }
+
+        case TypePlan::Float: {
+            PLY_ASSERT(aNode.isNumeric());
+            *(float*) ptr = aNode.numeric<float>();
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_Float) {
-        PLY_ASSERT(aNode.isNumeric());
-        *(float*) obj.ptr = aNode.numeric<float>();
-    } else if (obj.type->typeKey == &TypeKey_U8) {
-        PLY_ASSERT(aNode.isNumeric());
-        *(u8*) obj.ptr = aNode.numeric<u8>();
-    } else if (obj.type->typeKey == &TypeKey_U16) {
-        PLY_ASSERT(aNode.isNumeric());
-        *(u16*) obj.ptr = aNode.numeric<u16>();
-    } else if (obj.type->typeKey == &TypeKey_Bool) {
-        *(bool*) obj.ptr = aNode.text() == "true";
-    } else if (obj.type->typeKey == &TypeKey_U32) {
-        PLY_ASSERT(aNode.isNumeric());
-        *(u32*) obj.ptr = aNode.numeric<u32>();
-    } else if (obj.type->typeKey == &TypeKey_S32) {
-        PLY_ASSERT(aNode.isNumeric());
-        *(s32*) obj.ptr = aNode.numeric<s32>();
-    } else if (obj.type->typeKey == &TypeKey_FixedArray) {
-        PLY_ASSERT(aNode.isArray());
-        const auto& aNodeArr = aNode.array();
-        auto* fixedArrType = obj.type->cast<TypeDescriptor_FixedArray>();
-        u32 itemSize = fixedArrType->itemType->fixedSize;
-        for (u32 i = 0; i < fixedArrType->numItems; i++) {
-            TypedPtr elem{PLY_PTR_OFFSET(obj.ptr, itemSize * i), fixedArrType->itemType};
-            convertFrom(elem, aNodeArr[i], typeFromName);
+
+        case TypePlan::U8: {
+            PLY_ASSERT(aNode.isNumeric());
+            *(u8*) ptr = aNode.numeric<u8>();
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_String) {
-        if (aNode.isText()) {
-            *(String*) obj.ptr = aNode.text();
-        } else {
-            error();
+
+        case TypePlan::U16: {
+            PLY_ASSERT(aNode.isNumeric());
+            *(u16*) ptr = aNode.numeric<u16>();
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_Array) {
-        PLY_ASSERT(aNode.isArray());
-        const auto& aNodeArr = aNode.array();
-        auto* arrType = static_cast<TypeDescriptor_Array*>(obj.type);
-        details::BaseArray* arr = (details::BaseArray*) obj.ptr;
-        u32 oldArrSize = arr->m_numItems;
-        u32 newArrSize = aNodeArr.numItems();
-        u32 itemSize = arrType->itemType->fixedSize;
-        for (u32 i = newArrSize; i < oldArrSize; i++) {
-            TypedPtr{PLY_PTR_OFFSET(arr->m_items, itemSize * i), arrType->itemType}.destruct();
+
+        case TypePlan::Bool: {
+            *(bool*) ptr = aNode.text() == "true";
+            break;
         }
-        arr->realloc(newArrSize, itemSize);
-        for (u32 i = oldArrSize; i < newArrSize; i++) {
-            TypedPtr{PLY_PTR_OFFSET(arr->m_items, itemSize * i), arrType->itemType}.construct();
+
+        case TypePlan::U32: {
+            PLY_ASSERT(aNode.isNumeric());
+            *(u32*) ptr = aNode.numeric<u32>();
+            break;
         }
-        for (u32 i = 0; i < newArrSize; i++) {
-            TypedPtr elem{PLY_PTR_OFFSET(arr->m_items, itemSize * i), arrType->itemType};
-            convertFrom(elem, aNodeArr[i], typeFromName);
+
+        case TypePlan::S32: {
+            PLY_ASSERT(aNode.isNumeric());
+            *(s32*) ptr = aNode.numeric<s32>();
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_EnumIndexedArray) {
-        PLY_ASSERT(aNode.isObject());
-        auto* arrayDesc = obj.type->cast<TypeDescriptor_EnumIndexedArray>();
-        for (const TypeDescriptor_Enum::Identifier& identifier : arrayDesc->enumType->identifiers) {
-            const auto& aMember = aNode[identifier.name];
-            if (aMember.isValid()) {
-                TypedPtr m{
-                    PLY_PTR_OFFSET(obj.ptr, arrayDesc->itemType->fixedSize * identifier.value),
-                    arrayDesc->itemType};
-                convertFrom(m, aMember, typeFromName);
+
+        case TypePlan::FixedArray: {
+            PLY_ASSERT(aNode.isArray());
+            const auto& aNodeArr = aNode.array();
+            u32 itemSize = plan->itemPlan->type->fixedSize;
+            for (u32 i = 0; i < plan->numItems; i++) {
+                convertFrom(plan->itemPlan, PLY_PTR_OFFSET(ptr, itemSize * i), aNodeArr[i],
+                            typeFromName);
             }
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_Enum) {
-        PLY_ASSERT(aNode.isText());
-        auto* enumDesc = obj.type->cast<TypeDescriptor_Enum>();
-        bool found = false;
-        for (const auto& identifier : enumDesc->identifiers) {
-            if (identifier.name == aNode) {
-                if (enumDesc->fixedSize == 1) {
-                    PLY_ASSERT(identifier.value <= UINT8_MAX);
-                    *(u8*) obj.ptr = (u8) identifier.value;
-                } else if (enumDesc->fixedSize == 2) {
-                    PLY_ASSERT(identifier.value <= UINT16_MAX);
-                    *(u16*) obj.ptr = (u16) identifier.value;
-                } else if (enumDesc->fixedSize == 4) {
-                    *(u32*) obj.ptr = identifier.value;
-                } else {
-                    PLY_ASSERT(0);
+
+        case TypePlan::String: {
+            if (aNode.isText()) {
+                *(String*) ptr = aNode.text();
+            } else {
+                error();
+            }
+            break;
+        }
+
+        case TypePlan::Array: {
+            PLY_ASSERT(aNode.isArray());
+            const auto& aNodeArr = aNode.array();
+            TypeDescriptor* itemType = plan->itemPlan->type;
+            details::BaseArray* arr = (details::BaseArray*) ptr;
+            u32 oldArrSize = arr->m_numItems;
+            u32 newArrSize = aNodeArr.numItems();
+            u32 itemSize = itemType->fixedSize;
+            for (u32 i = newArrSize; i < oldArrSize; i++) {
+                TypedPtr{PLY_PTR_OFFSET(arr->m_items, itemSize * i), itemType}.destruct();
+            }
+            arr->realloc(newArrSize, itemSize);
+            for (u32 i = oldArrSize; i < newArrSize; i++) {
+                TypedPtr{PLY_PTR_OFFSET(arr->m_items, itemSize * i), itemType}.construct();
+            }
+            for (u32 i = 0; i < newArrSize; i++) {
+                convertFrom(plan->itemPlan, PLY_PTR_OFFSET(arr->m_items, itemSize * i),
+                            aNodeArr[i], typeFromName);
+            }
+            break;
+        }
+
+        case TypePlan::EnumIndexedArray: {
+            PLY_ASSERT(aNode.isObject());
+            u32 hint = 0;
+            for (const Node::Object::Item& item : aNode.object().items) {
+                s32 i = plan->findMember(item.name, hint);
+                if (i >= 0) {
+                    convertFrom(plan->itemPlan, PLY_PTR_OFFSET(ptr, plan->members[i].offset),
+                                item.value, typeFromName);
+                    hint = i + 1;
                 }
-                found = true;
-                break;
             }
+            break;
+        }
+
+        case TypePlan::Enum: {
+            PLY_ASSERT(aNode.isText());
+            s32 i = plan->findMember(aNode.text(), 0);
+            PLY_ASSERT(i >= 0);
+            if (i >= 0) {
+                writeEnumValue(ptr, plan->type->fixedSize, plan->members[i].offset);
+            }
+            break;
         }
-        PLY_ASSERT(found);
-        PLY_UNUSED(found);
-    } else if (obj.type->typeKey == &TypeKey_SavedTypedPtr) {
-        PLY_ASSERT(aNode.isObject());
-        TypeDescriptorOwner* targetTypeOwner = convertTypeFrom(aNode["type"], typeFromName);
-        SavedTypedPtr* savedTypedPtr = (SavedTypedPtr*) obj.ptr;
-        savedTypedPtr->typeOwner = targetTypeOwner;
-        savedTypedPtr->owned = TypedPtr::create(targetTypeOwner->getRootType());
-        convertFrom(savedTypedPtr->owned, aNode["value"], typeFromName);
-    } else if (obj.type->typeKey == &TypeKey_TypedArray) {
-        PLY_ASSERT(aNode.isObject());
-        TypeDescriptorOwner* itemTypeOwner = convertTypeFrom(aNode["type"], typeFromName);
-        const auto& aData = aNode["data"];
-        const auto& aDataArr = aData.array();
-        TypedArray* arr = (TypedArray*) obj.ptr;
-        arr->create(itemTypeOwner, aDataArr.numItems());
-        TypedPtr item = {arr->m_array.m_items, itemTypeOwner->getRootType()};
-        for (u32 i = 0; i < aDataArr.numItems(); i++) {
-            convertFrom(item, aDataArr[i], typeFromName);
-            item.ptr = PLY_PTR_OFFSET(item.ptr, itemTypeOwner->getRootType()->fixedSize);
+
+        case TypePlan::SavedTypedPtr: {
+            PLY_ASSERT(aNode.isObject());
+            TypeDescriptorOwner* targetTypeOwner = convertTypeFrom(aNode["type"], typeFromName);
+            SavedTypedPtr* savedTypedPtr = (SavedTypedPtr*) ptr;
+            savedTypedPtr->typeOwner = targetTypeOwner;
+            savedTypedPtr->owned = TypedPtr::create(targetTypeOwner->getRootType());
+            convertSynthesizedFrom(savedTypedPtr->owned, aNode["value"], typeFromName);
+            break;
         }
-    } else if (obj.type->typeKey == &TypeKey_Switch) {
-        PLY_ASSERT(aNode.isObject());
-        auto* switchDesc = obj.type->cast<TypeDescriptor_Switch>();
-        PLY_ASSERT(aNode.object().items.numItems() == 1);
-        auto iter = aNode.object().items.begin();
-        const StringView& stateName = iter->name;
-        bool found = false;
-        for (u32 i = 0; i < switchDesc->states.numItems(); i++) {
-            const TypeDescriptor_Switch::State& state = switchDesc->states[i];
-            if (state.name == stateName) {
-                switchDesc->ensureStateIs(obj, (u16) i);
-                TypedPtr m{PLY_PTR_OFFSET(obj.ptr, switchDesc->storageOffset), state.structType};
-                convertFrom(m, iter->value, typeFromName);
-                found = true;
-                break;
+
+        case TypePlan::TypedArray: {
+            PLY_ASSERT(aNode.isObject());
+            TypeDescriptorOwner* itemTypeOwner = convertTypeFrom(aNode["type"], typeFromName);
+            const auto& aData = aNode["data"];
+            const auto& aDataArr = aData.array();
+            TypedArray* arr = (TypedArray*) ptr;
+            arr->create(itemTypeOwner, aDataArr.numItems());
+            TypedPtr item = {arr->m_array.m_items, itemTypeOwner->getRootType()};
+            TypePlanCache localPlans;
+            const TypePlan* itemPlan = localPlans.get(item.type);
+            for (u32 i = 0; i < aDataArr.numItems(); i++) {
+                convertFrom(itemPlan, item.ptr, aDataArr[i], typeFromName);
+                item.ptr = PLY_PTR_OFFSET(item.ptr, item.type->fixedSize);
             }
+            break;
+        }
+
+        case TypePlan::Switch: {
+            PLY_ASSERT(aNode.isObject());
+            PLY_ASSERT(aNode.object().items.numItems() == 1);
+            const Node::Object::Item& item = aNode.object().items[0];
+            s32 i = plan->findMember(item.name, 0);
+            PLY_ASSERT(i >= 0);
+            if (i >= 0) {
+                const TypePlan::Member& state = plan->members[i];
+                plan->type->cast<TypeDescriptor_Switch>()->ensureStateIs({ptr, plan->type},
+                                                                        (u16) state.offset);
+                convertFrom(state.plan, PLY_PTR_OFFSET(ptr, plan->storageOffset), item.value,
+                            typeFromName);
+            }
+            break;
+        }
+
+        default: {
+            PLY_ASSERT(0); // Unsupported member type
+            break;
+        }
+    }
+}
+
+// Reads the members of a Struct or EnumIndexedArray. Unknown members are skipped.
+PLY_NO_INLINE bool readMembersFrom(const TypePlan* plan, void* ptr, Reader& reader,
+                                   const Functor<TypeFromName>& typeFromName);
+
+PLY_NO_INLINE bool readFrom(const TypePlan* plan, void* ptr, Reader& reader,
+                            const Reader::Event& event, const Functor<TypeFromName>& typeFromName) {
+    if (event.type == Reader::Event::Text) {
+        // Scalars are converted the same way as when importing from a Node. Creating a Node for
+        // the text doesn't allocate any memory.
+        convertFrom(plan, ptr, Node::createText(event.text, event.location), typeFromName);
+        return true;
+    }
+
+    switch (plan->kind) {
+        case TypePlan::Struct:
+        case TypePlan::EnumIndexedArray: {
+            PLY_ASSERT(event.type == Reader::Event::BeginObject);
+            return readMembersFrom(plan, ptr, reader, typeFromName);
+        }
+
+        case TypePlan::FixedArray: {
+            PLY_ASSERT(event.type == Reader::Event::BeginArray);
+            u32 itemSize = plan->itemPlan->type->fixedSize;
+            for (u32 i = 0;; i++) {
+                Reader::Event itemEvent = reader.next();
+                if (itemEvent.type == Reader::Event::EndArray)
+                    return true;
+                if (i < plan->numItems) {
+                    if (!readFrom(plan->itemPlan, PLY_PTR_OFFSET(ptr, itemSize * i), reader,
+                                  itemEvent, typeFromName))
+                        return false;
+                } else if (!reader.skipValue(itemEvent)) {
+                    return false;
+                }
+            }
+        }
+
+        case TypePlan::Array: {
+            PLY_ASSERT(event.type == Reader::Event::BeginArray);
+            TypeDescriptor* itemType = plan->itemPlan->type;
+            details::BaseArray* arr = (details::BaseArray*) ptr;
+            u32 oldArrSize = arr->m_numItems;
+            u32 itemSize = itemType->fixedSize;
+            // The number of items isn't known in advance, so the array grows as items are read.
+            // Existing items are reused, and leftover items are destroyed at the end.
+            u32 newArrSize = 0;
+            for (;;) {
+                Reader::Event itemEvent = reader.next();
+                if (itemEvent.type == Reader::Event::EndArray)
+                    break;
+                if (newArrSize >= arr->m_numItems) {
+                    arr->reserve(newArrSize + 1, itemSize);
+                    arr->m_numItems = newArrSize + 1;
+                    TypedPtr{PLY_PTR_OFFSET(arr->m_items, itemSize * newArrSize), itemType}
+                        .construct();
+                }
+                void* item = PLY_PTR_OFFSET(arr->m_items, itemSize * newArrSize);
+                newArrSize++;
+                if (!readFrom(plan->itemPlan, item, reader, itemEvent, typeFromName))
+                    return false;
+            }
+            for (u32 i = newArrSize; i < oldArrSize; i++) {
+                TypedPtr{PLY_PTR_OFFSET(arr->m_items, itemSize * i), itemType}.destruct();
+            }
+            arr->realloc(newArrSize, itemSize);
+            return true;
+        }
+
+        case TypePlan::Switch: {
+            PLY_ASSERT(event.type == Reader::Event::BeginObject);
+            Reader::Event keyEvent = reader.next();
+            if (keyEvent.type != Reader::Event::Key)
+                return false;
+            s32 i = plan->findMember(keyEvent.text, 0);
+            PLY_ASSERT(i >= 0);
+            if (i >= 0) {
+                const TypePlan::Member& state = plan->members[i];
+                plan->type->cast<TypeDescriptor_Switch>()->ensureStateIs({ptr, plan->type},
+                                                                        (u16) state.offset);
+                if (!readFrom(state.plan, PLY_PTR_OFFSET(ptr, plan->storageOffset), reader,
+                              reader.next(), typeFromName))
+                    return false;
+            } else if (!reader.skipValue(reader.next())) {
+                return false;
+            }
+            return reader.next().type == Reader::Event::EndObject;
+        }
+
+        default: {
+            if (!event.isValid())
+                return false;
+            // SavedTypedPtr and TypedArray need their type description before their contents,
+            // which can appear in either order. Read the whole value into a Node first.
+            Node aNode = reader.readNode(event);
+            if (!aNode.isValid())
+                return false;
+            convertFrom(plan, ptr, aNode, typeFromName);
+            return true;
+        }
+    }
+}
+
+PLY_NO_INLINE bool readMembersFrom(const TypePlan* plan, void* ptr, Reader& reader,
+                                   const Functor<TypeFromName>& typeFromName) {
+    u32 hint = 0;
+    for (;;) {
+        Reader::Event keyEvent = reader.next();
+        if (keyEvent.type == Reader::Event::EndObject)
+            return true;
+        if (keyEvent.type != Reader::Event::Key)
+            return false;
+        s32 i = plan->findMember(keyEvent.text, hint);
+        Reader::Event valueEvent = reader.next();
+        if (i >= 0) {
+            const TypePlan::Member& member = plan->members[i];
+            const TypePlan* memberPlan =
+                (plan->kind == TypePlan::Struct) ? member.plan : plan->itemPlan;
+            if (!readFrom(memberPlan, PLY_PTR_OFFSET(ptr, member.offset), reader, valueEvent,
+                          typeFromName))
+                return false;
+            hint = i + 1;
+        } else if (!reader.skipValue(valueEvent)) {
+            return false;
         }
-        PLY_ASSERT(found);
-        PLY_UNUSED(found);
-    } else {
-        PLY_ASSERT(0); // Unsupported member type
     }
 }
 
 PLY_NO_INLINE OwnTypedPtr import(TypeDescriptor* typeDesc, const Node& aRoot,
                                  const Functor<TypeFromName>& typeFromName) {
     OwnTypedPtr result = TypedPtr::create(typeDesc);
-    convertFrom(result, aRoot, typeFromName);
+    convertFrom(g_typePlans.get(typeDesc), result.ptr, aRoot, typeFromName);
     return result;
 }
 
 PLY_NO_INLINE void importInto(TypedPtr obj, const Node& aRoot,
                               const Functor<TypeFromName>& typeFromName) {
-    convertFrom(obj, aRoot, typeFromName);
+    convertFrom(g_typePlans.get(obj.type), obj.ptr, aRoot, typeFromName);
+}
+
+PLY_NO_INLINE bool importInto(TypedPtr obj, Reader& reader,
+                              const Functor<TypeFromName>& typeFromName) {
+    if (!readFrom(g_typePlans.get(obj.type), obj.ptr, reader, reader.next(), typeFromName))
+        return false;
+    return reader.next().type == Reader::Event::EndOfFile;
 }
 
 } // namespace pylon
@@ -5,6 +5,7 @@
 #pragma once
 #include <pylon-reflect/Core.h>
 #include <pylon/Node.h>
+#include <pylon/Reader.h>
 #include <ply-reflect/TypeDescriptor.h>
 #include <ply-reflect/TypeKey.h>
 #include <ply-runtime/container/Owned.h>
@@ -12,11 +13,19 @@
 namespace pylon {
 
 typedef TypeDescriptor* TypeFromName(StringView);
+
+// Import and export use a TypePlan for each type, which is cached in g_typePlans the first time the
+// type is seen. Synthesized types are evicted from g_typePlans when their TypeDescriptorOwner
+// destroys them.
 OwnTypedPtr import(TypeDescriptor* typeDesc, const pylon::Node& aRoot,
                    const Functor<TypeFromName>& typeFromName = {});
 void importInto(TypedPtr obj, const pylon::Node& aRoot,
                 const Functor<TypeFromName>& typeFromName = {});
 
+// Reads the next value from reader directly into obj, without building a tree of Nodes. Returns
+// false if there's an error.
+bool importInto(TypedPtr obj, Reader& reader, const Functor<TypeFromName>& typeFromName = {});
+
 template <typename T>
 PLY_INLINE Owned<T> import(const pylon::Node& aRoot,
                            const Functor<TypeFromName>& typeFromName = {}) {
@@ -0,0 +1,130 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <pylon-reflect/Core.h>
+#include <pylon-reflect/TypePlan.h>
+#include <ply-reflect/TypeDescriptorOwner.h>
+
+namespace pylon {
+
+TypePlanCache g_typePlans;
+
+// Evicts synthesized types from g_typePlans when they're destroyed. It's defined after g_typePlans
+// so that it stops evicting before g_typePlans is destroyed at exit.
+struct TypePlanEviction {
+    TypePlanEviction() {
+        TypeDescriptorOwner::onDestroyType = [](TypeDescriptor* type) { g_typePlans.evict(type); };
+    }
+    ~TypePlanEviction() {
+        TypeDescriptorOwner::onDestroyType = nullptr;
+    }
+};
+TypePlanEviction typePlanEviction;
+
+s32 TypePlan::findMemberSlow(StringView name) const {
+    if (this->memberIndex) {
+        auto cursor = this->memberIndex->find(name, &this->members);
+        return cursor.wasFound() ? (s32) *cursor : -1;
+    }
+    for (u32 i = 0; i < this->members.numItems(); i++) {
+        if (this->members[i].name == name)
+            return (s32) i;
+    }
+    return -1;
+}
+
+TypePlan* TypePlanCache::getLocked(TypeDescriptor* type) {
+    auto cursor = this->plans.insertOrFind(type);
+    if (cursor.wasFound())
+        return *cursor;
+
+    // Add the plan to the cache before filling it in, so that recursive types can refer to it
+    TypePlan* plan = new TypePlan;
+    *cursor = plan;
+    plan->type = type;
+
+    TypeKey* typeKey = type->typeKey;
+    if (typeKey == &TypeKey_Struct) {
+        plan->kind = TypePlan::Struct;
+        for (const TypeDescriptor_Struct::Member& member :
+             type->cast<TypeDescriptor_Struct>()->members) {
+            plan->members.append({member.name, member.offset, this->getLocked(member.type)});
+        }
+    } else if (typeKey == &TypeKey_Float) {
+        plan->kind = TypePlan::Float;
+    } else if (typeKey == &TypeKey_U8) {
+        plan->kind = TypePlan::U8;
+    } else if (typeKey == &TypeKey_U16) {
+        plan->kind = TypePlan::U16;
+    } else if (typeKey == &TypeKey_U32) {
+        plan->kind = TypePlan::U32;
+    } else if (typeKey == &TypeKey_S32) {
+        plan->kind = TypePlan::S32;
+    } else if (typeKey == &TypeKey_Bool) {
+        plan->kind = TypePlan::Bool;
+    } else if (typeKey == &TypeKey_String) {
+        plan->kind = TypePlan::String;
+    } else if (typeKey == &TypeKey_FixedArray) {
+        auto* fixedArrType = type->cast<TypeDescriptor_FixedArray>();
+        plan->kind = TypePlan::FixedArray;
+        plan->numItems = fixedArrType->numItems;
+        plan->itemPlan = this->getLocked(fixedArrType->itemType);
+    } else if (typeKey == &TypeKey_Array) {
+        plan->kind = TypePlan::Array;
+        plan->itemPlan = this->getLocked(static_cast<TypeDescriptor_Array*>(type)->itemType);
+    } else if (typeKey == &TypeKey_EnumIndexedArray) {
+        auto* arrayDesc = type->cast<TypeDescriptor_EnumIndexedArray>();
+        plan->kind = TypePlan::EnumIndexedArray;
+        plan->itemPlan = this->getLocked(arrayDesc->itemType);
+        for (const TypeDescriptor_Enum::Identifier& identifier : arrayDesc->enumType->identifiers) {
+            plan->members.append({identifier.name,
+                                  arrayDesc->itemType->fixedSize * identifier.value, nullptr});
+        }
+    } else if (typeKey == &TypeKey_Enum) {
+        plan->kind = TypePlan::Enum;
+        for (const TypeDescriptor_Enum::Identifier& identifier :
+             type->cast<TypeDescriptor_Enum>()->identifiers) {
+            plan->members.append({identifier.name, identifier.value, nullptr});
+        }
+    } else if (typeKey == &TypeKey_SavedTypedPtr) {
+        plan->kind = TypePlan::SavedTypedPtr;
+    } else if (typeKey == &TypeKey_TypedArray) {
+        plan->kind = TypePlan::TypedArray;
+    } else if (typeKey == &TypeKey_Switch) {
+        auto* switchDesc = type->cast<TypeDescriptor_Switch>();
+        plan->kind = TypePlan::Switch;
+        plan->storageOffset = switchDesc->storageOffset;
+        for (u32 i = 0; i < switchDesc->states.numItems(); i++) {
+            const TypeDescriptor_Switch::State& state = switchDesc->states[i];
+            plan->members.append({state.name, i, this->getLocked(state.structType)});
+        }
+    }
+
+    if (plan->members.numItems() > TypePlan::LinearSearchLimit) {
+        plan->memberIndex = new HashMap<TypePlan::MemberIndexTraits>;
+        for (u32 i = 0; i < plan->members.numItems(); i++) {
+            auto memberCursor = plan->memberIndex->insertOrFind(plan->members[i].name,
+                                                                &plan->members);
+            if (!memberCursor.wasFound()) {
+                *memberCursor = i;
+            }
+        }
+    }
+    return plan;
+}
+
+TypePlan* TypePlanCache::get(TypeDescriptor* type) {
+    LockGuard<Mutex> guard{this->mutex};
+    return this->getLocked(type);
+}
+
+void TypePlanCache::evict(TypeDescriptor* type) {
+    LockGuard<Mutex> guard{this->mutex};
+    auto cursor = this->plans.find(type);
+    if (cursor.wasFound()) {
+        cursor.erase();
+    }
+}
+
+} // namespace pylon
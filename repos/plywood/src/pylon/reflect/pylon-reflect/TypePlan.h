@@ -0,0 +1,103 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <pylon-reflect/Core.h>
+#include <ply-reflect/TypeDescriptor.h>
+#include <ply-runtime/container/Owned.h>
+#include <ply-runtime/thread/Mutex.h>
+
+namespace pylon {
+
+// A TypePlan holds everything that import and export need to know about a TypeDescriptor, worked
+// out once instead of once per object: which kind of type it is, the plans of nested types, and a
+// table of member names. TypePlans are built by a TypePlanCache.
+struct TypePlan {
+    enum Kind : u8 {
+        Unsupported,
+        Struct,
+        Float,
+        U8,
+        U16,
+        U32,
+        S32,
+        Bool,
+        String,
+        FixedArray,
+        Array,
+        EnumIndexedArray,
+        Enum,
+        SavedTypedPtr,
+        TypedArray,
+        Switch,
+    };
+
+    // Struct: offset is the member offset.
+    // EnumIndexedArray: offset is the item offset.
+    // Enum: offset is the enum value.
+    // Switch: offset is the state ID, and plan is the plan of the state's struct.
+    struct Member {
+        StringView name;
+        u32 offset;
+        TypePlan* plan;
+    };
+
+    struct MemberIndexTraits {
+        using Key = StringView;
+        using Item = u32;
+        using Context = ply::Array<Member>;
+        static PLY_INLINE StringView comparand(u32 item, const ply::Array<Member>& members) {
+            return members[item].name;
+        }
+    };
+
+    // Objects with more members than this are looked up using memberIndex:
+    static const u32 LinearSearchLimit = 8;
+
+    TypeDescriptor* type = nullptr;
+    Kind kind = Unsupported;
+    u32 storageOffset = 0;       // Switch only
+    u32 numItems = 0;            // FixedArray only
+    TypePlan* itemPlan = nullptr; // FixedArray, Array and EnumIndexedArray
+    ply::Array<Member> members;
+    Owned<HashMap<MemberIndexTraits>> memberIndex;
+
+    // Returns the index of the member with the given name, or -1. Members usually appear in the
+    // same order as they're declared, so the member at hint is checked first.
+    PLY_INLINE s32 findMember(StringView name, u32 hint) const {
+        if (hint < this->members.numItems() && this->members[hint].name == name)
+            return (s32) hint;
+        return this->findMemberSlow(name);
+    }
+    s32 findMemberSlow(StringView name) const;
+};
+
+// Builds and owns TypePlans. A plan is built for each TypeDescriptor the first time it's needed.
+//
+// TypePlans refer to their TypeDescriptors, so a plan must be evicted before its type is destroyed.
+// g_typePlans evicts synthesized types when their TypeDescriptorOwner destroys them. Types that
+// are synthesized while importing, such as those of a SavedTypedPtr, use a temporary cache.
+class TypePlanCache {
+private:
+    struct Traits {
+        using Key = TypeDescriptor*;
+        using Item = Owned<TypePlan>;
+        static PLY_INLINE TypeDescriptor* comparand(const Owned<TypePlan>& plan) {
+            return plan->type;
+        }
+    };
+
+    Mutex mutex;
+    HashMap<Traits> plans;
+
+    TypePlan* getLocked(TypeDescriptor* type);
+
+public:
+    TypePlan* get(TypeDescriptor* type);
+    void evict(TypeDescriptor* type);
+};
+
+extern TypePlanCache g_typePlans;
+
+} // namespace pylon
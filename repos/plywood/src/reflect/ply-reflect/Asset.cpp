@@ -32,9 +32,8 @@ void writeAsset(OutStream* out, TypedPtr obj) {
 //
 
 TypedPtr readAsset(InStream* ins, PersistentTypeResolver* resolver) {
-    Schema schema;
-    readSchema(schema, ins);
-    ReadObjectContext context{&schema, ins, resolver};
+    Reference<CachedSchema> cached = readCachedSchema(ins);
+    ReadObjectContext context{&cached->schema, ins, resolver, &cached->planCache};
     readLinkTable(&context.in, &context.ptrResolver);
     context.ptrResolver.objDataOffset = safeDemote<u32>(ins->getSeekPos());
     TypedPtr obj = readObject(&context);
@@ -0,0 +1,235 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <ply-reflect/Core.h>
+#include <ply-reflect/InPlaceAsset.h>
+#include <ply-reflect/TypeKey.h>
+#include <ply-reflect/FormatDescriptor.h>
+#include <ply-runtime/filesystem/FileSystem.h>
+
+namespace ply {
+
+PLY_STATIC_ASSERT(sizeof(InPlaceArray<u32>) == sizeof(Array<u32>));
+PLY_STATIC_ASSERT(sizeof(InPlaceString) == sizeof(String));
+PLY_STATIC_ASSERT(sizeof(InPlaceOwned<u32>) == sizeof(Owned<u32>));
+
+// Blocks that aren't string bytes are aligned to this:
+static const u32 InPlaceBlockAlignment = 8;
+
+//--------------------------------------------------------------------
+// Layout hash
+//
+
+bool appendInPlaceLayout(Hasher& hasher, TypeDescriptor* type,
+                         Array<TypeDescriptor*>& typeStack) {
+    // Recursive types refer back to a type that's already being hashed
+    for (u32 i = 0; i < typeStack.numItems(); i++) {
+        if (typeStack[i] == type) {
+            hasher.append(i);
+            return true;
+        }
+    }
+
+    // TypeKey addresses differ between processes, so the hash identifies each TypeKey by its
+    // FormatKey instead
+    TypeKey* typeKey = type->typeKey;
+    FormatKey numericKey = getNumericFormatKey(typeKey);
+    hasher.append(type->fixedSize);
+    if (numericKey != FormatKey::None) {
+        hasher.append((u32) numericKey);
+        return true;
+    } else if (typeKey == &TypeKey_String) {
+        hasher.append((u32) FormatKey::String);
+        return true;
+    }
+
+    typeStack.append(type);
+    bool supported = true;
+    if (typeKey == &TypeKey_Enum) {
+        hasher.append((u32) FormatKey::Enum);
+        for (const TypeDescriptor_Enum::Identifier& identifier :
+             type->cast<TypeDescriptor_Enum>()->identifiers) {
+            identifier.name.view().appendTo(hasher);
+            hasher.append(identifier.value);
+        }
+    } else if (typeKey == &TypeKey_FixedArray) {
+        auto* fixedArrayType = type->cast<TypeDescriptor_FixedArray>();
+        hasher.append((u32) FormatKey::FixedArray);
+        hasher.append(fixedArrayType->numItems);
+        hasher.append(fixedArrayType->stride);
+        supported = appendInPlaceLayout(hasher, fixedArrayType->itemType, typeStack);
+    } else if (typeKey == &TypeKey_Array) {
+        hasher.append((u32) FormatKey::Array);
+        supported = appendInPlaceLayout(hasher, type->cast<TypeDescriptor_Array>()->itemType,
+                                        typeStack);
+    } else if (typeKey == &TypeKey_Owned) {
+        hasher.append((u32) FormatKey::Owned);
+        supported = appendInPlaceLayout(hasher, type->cast<TypeDescriptor_Owned>()->targetType,
+                                        typeStack);
+    } else if (typeKey == &TypeKey_Struct) {
+        auto* structType = type->cast<TypeDescriptor_Struct>();
+        hasher.append((u32) FormatKey::Struct);
+        hasher.append(structType->members.numItems());
+        for (const TypeDescriptor_Struct::Member& member : structType->members) {
+            member.name.view().appendTo(hasher);
+            hasher.append(member.offset);
+            if (!appendInPlaceLayout(hasher, member.type, typeStack)) {
+                supported = false;
+                break;
+            }
+        }
+    } else {
+        supported = false;
+    }
+    typeStack.pop();
+    return supported;
+}
+
+PLY_NO_INLINE u32 getInPlaceLayoutHash(TypeDescriptor* type) {
+    Hasher hasher;
+    hasher.append((u32) InPlaceAssetHeader::CurrentVersion);
+    Array<TypeDescriptor*> typeStack;
+    if (!appendInPlaceLayout(hasher, type, typeStack))
+        return 0;
+    u32 hash = hasher.result();
+    return hash ? hash : 1;
+}
+
+//--------------------------------------------------------------------
+// Write
+//
+
+struct InPlaceWriter {
+    Array<char> image;
+
+    // Returns the offset of a new zero-filled block in the image.
+    u32 allocBlock(u32 numBytes, u32 alignment) {
+        u32 start = alignPowerOf2(this->image.numItems(), alignment);
+        u32 end = start + numBytes;
+        u32 oldSize = this->image.numItems();
+        this->image.resize(end);
+        memset(this->image.get() + oldSize, 0, end - oldSize);
+        return start;
+    }
+
+    void setOffset(u32 field, u32 target) {
+        sptr relOffset = (sptr) target - (sptr) field;
+        memcpy(this->image.get() + field, &relOffset, sizeof(relOffset));
+    }
+
+    // Copies a native value, whose type was accepted by getInPlaceLayoutHash(), to dst in the
+    // image. Bytes that aren't part of any reflected member stay zero.
+    void copyValue(u32 dst, const void* src, TypeDescriptor* type) {
+        TypeKey* typeKey = type->typeKey;
+        if (typeKey == &TypeKey_Struct) {
+            for (const TypeDescriptor_Struct::Member& member :
+                 type->cast<TypeDescriptor_Struct>()->members) {
+                this->copyValue(dst + member.offset, PLY_PTR_OFFSET(src, member.offset),
+                                member.type);
+            }
+        } else if (typeKey == &TypeKey_FixedArray) {
+            auto* fixedArrayType = type->cast<TypeDescriptor_FixedArray>();
+            for (u32 i = 0; i < fixedArrayType->numItems; i++) {
+                u32 itemOffset = i * fixedArrayType->stride;
+                this->copyValue(dst + itemOffset, PLY_PTR_OFFSET(src, itemOffset),
+                                fixedArrayType->itemType);
+            }
+        } else if (typeKey == &TypeKey_Array) {
+            TypeDescriptor* itemType = type->cast<TypeDescriptor_Array>()->itemType;
+            const details::BaseArray* arr = (const details::BaseArray*) src;
+            u32 itemSize = itemType->fixedSize;
+            u32 block = this->allocBlock(arr->m_numItems * itemSize, InPlaceBlockAlignment);
+            this->setOffset(dst, block);
+            memcpy(this->image.get() + dst + offsetof(InPlaceArray<u8>, numItems_),
+                   &arr->m_numItems, sizeof(u32));
+            if (hasPackedLayout(itemType)) {
+                memcpy(this->image.get() + block, arr->m_items, arr->m_numItems * itemSize);
+            } else {
+                for (u32 i = 0; i < arr->m_numItems; i++) {
+                    u32 itemOffset = i * itemSize;
+                    this->copyValue(block + itemOffset, PLY_PTR_OFFSET(arr->m_items, itemOffset),
+                                    itemType);
+                }
+            }
+        } else if (typeKey == &TypeKey_String) {
+            const String* str = (const String*) src;
+            u32 block = this->allocBlock(str->numBytes, 1);
+            this->setOffset(dst, block);
+            memcpy(this->image.get() + dst + offsetof(InPlaceString, numBytes), &str->numBytes,
+                   sizeof(u32));
+            memcpy(this->image.get() + block, str->bytes, str->numBytes);
+        } else if (typeKey == &TypeKey_Owned) {
+            TypeDescriptor* targetType = type->cast<TypeDescriptor_Owned>()->targetType;
+            const void* target = *(void* const*) src;
+            if (target) {
+                u32 block = this->allocBlock(targetType->fixedSize, InPlaceBlockAlignment);
+                this->setOffset(dst, block);
+                this->copyValue(block, target, targetType);
+            }
+        } else {
+            // Numbers and enums
+            memcpy(this->image.get() + dst, src, type->fixedSize);
+        }
+    }
+};
+
+PLY_NO_INLINE bool writeInPlaceAsset(OutStream* out, TypedPtr obj) {
+    InPlaceAssetHeader header;
+    header.pointerSize = sizeof(void*);
+    header.layoutHash = getInPlaceLayoutHash(obj.type);
+    if (!header.layoutHash)
+        return false;
+
+    InPlaceWriter writer;
+    writer.allocBlock(sizeof(InPlaceAssetHeader), 1);
+    header.rootOffset = writer.allocBlock(obj.type->fixedSize, InPlaceBlockAlignment);
+    writer.copyValue(header.rootOffset, obj.ptr, obj.type);
+    header.totalSize = writer.image.numItems();
+    memcpy(writer.image.get(), &header, sizeof(header));
+    out->write(writer.image.view().bufferView());
+    return true;
+}
+
+//--------------------------------------------------------------------
+// Read
+//
+
+PLY_NO_INLINE Owned<InPlaceAsset> InPlaceAsset::open(StringView path, TypeDescriptor* type) {
+    return open(FileSystem::native()->openMappedStreamForRead(path), type);
+}
+
+PLY_NO_INLINE Owned<InPlaceAsset> InPlaceAsset::open(Owned<InStream>&& ins,
+                                                     TypeDescriptor* type) {
+    if (!ins)
+        return nullptr;
+    u32 layoutHash = getInPlaceLayoutHash(type);
+    if (!layoutHash)
+        return nullptr;
+
+    Owned<InPlaceAsset> asset = new InPlaceAsset;
+    ConstBufferView data;
+    if (ins->isView() && isAlignedPowerOf2(uptr(ins->curByte), InPlaceBlockAlignment)) {
+        // Use the mapping directly
+        data = ins->viewAvailable();
+        asset->ins = std::move(ins);
+    } else {
+        asset->buffer = ins->readRemainingContents();
+        data = asset->buffer;
+    }
+
+    if (data.numBytes < sizeof(InPlaceAssetHeader))
+        return nullptr;
+    const InPlaceAssetHeader* header = (const InPlaceAssetHeader*) data.bytes;
+    if (header->magic != InPlaceAssetHeader::Magic ||
+        header->version != InPlaceAssetHeader::CurrentVersion ||
+        header->pointerSize != sizeof(void*) || header->layoutHash != layoutHash ||
+        header->totalSize != data.numBytes ||
+        (u64) header->rootOffset + type->fixedSize > data.numBytes)
+        return nullptr;
+
+    asset->root = data.bytes + header->rootOffset;
+    return asset;
+}
+
+} // namespace ply
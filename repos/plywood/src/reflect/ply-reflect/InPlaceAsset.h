@@ -0,0 +1,165 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-reflect/Core.h>
+#include <ply-reflect/TypeDescriptor.h>
+
+namespace ply {
+
+//--------------------------------------------------------------------
+// In-place assets
+//
+// An in-place asset is a relocatable image of an object that can be memory-mapped and used
+// directly, without deserializing anything. Loading one only maps the file and checks its header,
+// so it takes the same amount of time no matter how large the asset is, and processes that map
+// the same file share its pages in the page cache.
+//
+// Every value in the image has the same size and member offsets as the native object it was
+// written from. The only difference is that the pointers held by Array, String and Owned are
+// replaced by offsets relative to the address of the field itself. Those fields are read through
+// InPlaceArray, InPlaceString and InPlaceOwned, which have the same size as the types they stand
+// in for, so a struct that mirrors a native struct using these types has the same layout. Types
+// that contain only those three types and numbers can use InPlace<T> as their mirror directly.
+//
+// The image is written in native byte order and pointer size. Files written on a machine with a
+// different byte order or pointer size are rejected when loaded. Only the header is validated, so
+// in-place assets must come from a trusted source, such as the cooker.
+//
+// Supported types are numbers, enums, FixedArray, Array, String, Owned and structs made of those.
+//
+
+template <typename T>
+struct InPlaceOwned {
+    sptr offset; // Relative to &offset; 0 means null
+
+    PLY_INLINE const T* get() const {
+        return this->offset ? (const T*) PLY_PTR_OFFSET(this, this->offset) : nullptr;
+    }
+    PLY_INLINE const T* operator->() const {
+        PLY_ASSERT(this->offset);
+        return this->get();
+    }
+    PLY_INLINE const T& operator*() const {
+        PLY_ASSERT(this->offset);
+        return *this->get();
+    }
+    PLY_INLINE explicit operator bool() const {
+        return this->offset != 0;
+    }
+};
+
+template <typename T>
+struct InPlaceArray {
+    sptr offset; // Relative to &offset
+    u32 numItems_;
+    u32 reserved;
+
+    PLY_INLINE const T* items() const {
+        return (const T*) PLY_PTR_OFFSET(this, this->offset);
+    }
+    PLY_INLINE u32 numItems() const {
+        return this->numItems_;
+    }
+    PLY_INLINE bool isEmpty() const {
+        return this->numItems_ == 0;
+    }
+    PLY_INLINE const T& operator[](u32 index) const {
+        PLY_ASSERT(index < this->numItems_);
+        return this->items()[index];
+    }
+    PLY_INLINE ArrayView<const T> view() const {
+        return {this->items(), this->numItems_};
+    }
+    PLY_INLINE operator ArrayView<const T>() const {
+        return this->view();
+    }
+    PLY_INLINE const T* begin() const {
+        return this->items();
+    }
+    PLY_INLINE const T* end() const {
+        return this->items() + this->numItems_;
+    }
+};
+
+struct InPlaceString {
+    sptr offset; // Relative to &offset
+    u32 numBytes;
+
+    PLY_INLINE StringView view() const {
+        return {(const char*) PLY_PTR_OFFSET(this, this->offset), this->numBytes};
+    }
+    PLY_INLINE operator StringView() const {
+        return this->view();
+    }
+};
+
+template <typename T>
+struct InPlaceType {
+    using Type = T;
+};
+template <typename T>
+struct InPlaceType<Array<T>> {
+    using Type = InPlaceArray<typename InPlaceType<T>::Type>;
+};
+template <typename T>
+struct InPlaceType<Owned<T>> {
+    using Type = InPlaceOwned<typename InPlaceType<T>::Type>;
+};
+template <>
+struct InPlaceType<String> {
+    using Type = InPlaceString;
+};
+
+// For example, InPlace<Array<String>> is InPlaceArray<InPlaceString>:
+template <typename T>
+using InPlace = typename InPlaceType<T>::Type;
+
+struct InPlaceAssetHeader {
+    static const u32 Magic = 0x504c5049; // "IPLP" in little-endian byte order
+    static const u16 CurrentVersion = 1;
+
+    u32 magic = Magic;
+    u16 version = CurrentVersion;
+    u8 pointerSize = 0; // Set to sizeof(void*) by writeInPlaceAsset()
+    u8 reserved = 0;
+    u32 layoutHash = 0; // Computed by getInPlaceLayoutHash()
+    u32 rootOffset = 0;
+    u64 totalSize = 0;
+};
+
+// Returns a hash of everything that determines the in-place layout of the given type, or 0 if
+// the type isn't supported.
+PLY_DLL_ENTRY u32 getInPlaceLayoutHash(TypeDescriptor* type);
+
+// Writes an in-place image of obj. Returns false, and writes nothing, if the type of obj (or of
+// anything it contains) isn't supported.
+PLY_DLL_ENTRY bool writeInPlaceAsset(OutStream* out, TypedPtr obj);
+
+class InPlaceAsset {
+private:
+    Owned<InStream> ins; // Holds the mapping
+    Buffer buffer;       // Holds the file contents if the file couldn't be mapped
+    const void* root = nullptr;
+
+public:
+    // Maps the file at the given path and returns an InPlaceAsset whose root has the given type,
+    // or nullptr if the file can't be opened or wasn't written from an object of that type. If
+    // the file can't be mapped, its contents are loaded into memory instead.
+    static PLY_DLL_ENTRY Owned<InPlaceAsset> open(StringView path, TypeDescriptor* type);
+    static PLY_DLL_ENTRY Owned<InPlaceAsset> open(Owned<InStream>&& ins, TypeDescriptor* type);
+
+    template <typename T>
+    static PLY_INLINE Owned<InPlaceAsset> open(StringView path) {
+        return open(path, TypeResolver<T>::get());
+    }
+
+    // T is the in-place mirror of the type the asset was opened with, such as InPlace<T>.
+    template <typename T>
+    PLY_INLINE const T* getRoot() const {
+        return (const T*) this->root;
+    }
+};
+
+} // namespace ply
@@ -0,0 +1,182 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-reflect/Core.h>
+#include <ply-reflect/PersistWrite.h>
+#include <ply-reflect/PersistRead.h>
+#include <ply-runtime/container/Boxed.h>
+
+namespace ply {
+
+//--------------------------------------------------------------------
+// Generated serializers
+//
+// plytool generates a pair of serializers for each struct declared with
+// PLY_REFLECT_WITH_SERIALIZERS(), using the macros at the bottom of this file. Each member is
+// written and read by a GeneratedSerializer that's chosen at compile time from the member's C++
+// type, so numbers, strings, arrays and other structs with generated serializers are handled
+// inline, without walking TypeDescriptors or calling through TypeKeys. The bytes written are
+// identical to those written by the TypeKeys.
+//
+// Members of any other type are serialized through their TypeKey, as usual.
+//
+
+namespace details {
+
+struct HasGeneratedSerializers {
+    PLY_SFINAE_EXPR_1(Value, &T0::writeGenerated)
+};
+
+template <typename T>
+PLY_INLINE auto callOnPostSerialize(T* obj) -> decltype(obj->onPostSerialize()) {
+    obj->onPostSerialize();
+}
+PLY_INLINE void callOnPostSerialize(...) {
+}
+
+// Serializes a value through its TypeKey.
+template <typename T, typename = void>
+struct GeneratedSerializer {
+    static PLY_NO_INLINE void write(const T& value, WriteObjectContext* context) {
+        TypeDescriptor* type = TypeResolver<T>::get();
+        type->typeKey->write(TypedPtr{(void*) &value, type}, context);
+    }
+    static PLY_NO_INLINE void read(T& value, ReadObjectContext* context,
+                                   FormatDescriptor* formatDesc) {
+        TypeDescriptor* type = TypeResolver<T>::get();
+        type->typeKey->read(TypedPtr{&value, type}, context, formatDesc);
+    }
+};
+
+template <typename T>
+struct GeneratedSerializer<T, std::enable_if_t<std::is_arithmetic<T>::value>> {
+    static PLY_INLINE void write(const T& value, WriteObjectContext* context) {
+        context->out.write<T>(value);
+    }
+    static PLY_INLINE void read(T& value, ReadObjectContext* context, FormatDescriptor*) {
+        value = context->in.read<T>();
+    }
+};
+
+template <>
+struct GeneratedSerializer<String> {
+    static PLY_INLINE void write(const String& value, WriteObjectContext* context) {
+        Boxed<String>::write(context->out, value);
+    }
+    static PLY_INLINE void read(String& value, ReadObjectContext* context, FormatDescriptor*) {
+        value = Boxed<String>::read(context->in);
+    }
+};
+
+template <typename T>
+struct GeneratedSerializer<T, std::enable_if_t<HasGeneratedSerializers::Value<T>>> {
+    static PLY_INLINE void write(const T& value, WriteObjectContext* context) {
+        T::writeGenerated(&value, context);
+    }
+    static PLY_INLINE void read(T& value, ReadObjectContext* context,
+                                FormatDescriptor* formatDesc) {
+        T::readGenerated(&value, context, formatDesc);
+    }
+};
+
+template <typename T>
+struct GeneratedItemSerializer {
+    static PLY_INLINE void write(const T* items, u32 numItems, WriteObjectContext* context) {
+        if (std::is_arithmetic<T>::value) {
+            context->out.outs->write({items, numItems * (u32) sizeof(T)});
+        } else {
+            for (u32 i = 0; i < numItems; i++) {
+                GeneratedSerializer<T>::write(items[i], context);
+            }
+        }
+    }
+    static PLY_INLINE void read(T* items, u32 numItems, ReadObjectContext* context,
+                                FormatDescriptor* itemFormat) {
+        if (std::is_arithmetic<T>::value) {
+            context->in.ins->read({items, numItems * (u32) sizeof(T)});
+        } else {
+            for (u32 i = 0; i < numItems; i++) {
+                GeneratedSerializer<T>::read(items[i], context, itemFormat);
+            }
+        }
+    }
+};
+
+template <typename T, int numItems>
+struct GeneratedSerializer<T[numItems]> {
+    static PLY_INLINE void write(const T (&value)[numItems], WriteObjectContext* context) {
+        GeneratedItemSerializer<T>::write(value, numItems, context);
+    }
+    static PLY_INLINE void read(T (&value)[numItems], ReadObjectContext* context,
+                                FormatDescriptor* formatDesc) {
+        GeneratedItemSerializer<T>::read(value, numItems, context,
+                                         ((FormatDescriptor_FixedArray*) formatDesc)->itemFormat);
+    }
+};
+
+template <typename T, u32 Size>
+struct GeneratedSerializer<FixedArray<T, Size>> {
+    static PLY_INLINE void write(const FixedArray<T, Size>& value, WriteObjectContext* context) {
+        GeneratedItemSerializer<T>::write(value.items, Size, context);
+    }
+    static PLY_INLINE void read(FixedArray<T, Size>& value, ReadObjectContext* context,
+                                FormatDescriptor* formatDesc) {
+        GeneratedItemSerializer<T>::read(value.items, Size, context,
+                                         ((FormatDescriptor_FixedArray*) formatDesc)->itemFormat);
+    }
+};
+
+template <typename T>
+struct GeneratedSerializer<Array<T>> {
+    static PLY_INLINE void write(const Array<T>& value, WriteObjectContext* context) {
+        context->out.write<u32>(value.numItems());
+        GeneratedItemSerializer<T>::write(value.begin(), value.numItems(), context);
+    }
+    static PLY_INLINE void read(Array<T>& value, ReadObjectContext* context,
+                                FormatDescriptor* formatDesc) {
+        u32 numItems = context->in.read<u32>();
+        PLY_ASSERT(numItems < 10000000);
+        if (std::is_arithmetic<T>::value) {
+            // Every item gets overwritten, so there's no need to construct them
+            ((BaseArray&) value).realloc(numItems, (u32) sizeof(T));
+        } else {
+            value.resize(numItems);
+        }
+        GeneratedItemSerializer<T>::read(value.begin(), numItems, context,
+                                         ((FormatDescriptor_Array*) formatDesc)->itemFormat);
+    }
+};
+
+} // namespace details
+
+#define PLY_STRUCT_WRITE_BEGIN(type) \
+    void type::writeGenerated(const void* ptr, ply::WriteObjectContext* context) { \
+        const type* obj = (const type*) ptr;
+
+#define PLY_STRUCT_WRITE_MEMBER(name) \
+    ply::details::GeneratedSerializer<decltype(obj->name)>::write(obj->name, context);
+
+#define PLY_STRUCT_WRITE_END() }
+
+#define PLY_STRUCT_READ_BEGIN(type) \
+    ply::Initializer type::initSerializersObj{[] { \
+        type::getReflection()->generatedWrite = type::writeGenerated; \
+        type::getReflection()->generatedRead = type::readGenerated; \
+    }}; \
+    void type::readGenerated(void* ptr, ply::ReadObjectContext* context, \
+                             ply::FormatDescriptor* formatDesc) { \
+        type* obj = (type*) ptr; \
+        const ply::FormatDescriptor_Struct::Member* formatMember = \
+            ((ply::FormatDescriptor_Struct*) formatDesc)->members.begin();
+
+#define PLY_STRUCT_READ_MEMBER(name) \
+    ply::details::GeneratedSerializer<decltype(obj->name)>::read(obj->name, context, \
+                                                                 (formatMember++)->formatDesc);
+
+#define PLY_STRUCT_READ_END() \
+    ply::details::callOnPostSerialize(obj); \
+    }
+
+} // namespace ply
@@ -6,6 +6,8 @@
 #include <ply-reflect/Core.h>
 #include <ply-reflect/TypeDescriptor.h>
 #include <ply-reflect/FormatDescriptor.h>
+#include <ply-reflect/TypeDescriptorOwner.h>
+#include <ply-runtime/thread/Mutex.h>
 
 namespace ply {
 
@@ -15,6 +17,31 @@ struct FormatDescriptor;
 // Read
 //
 
+struct ReadPlanKey {
+    TypeDescriptor* typeDesc = nullptr;
+    FormatDescriptor* formatDesc = nullptr;
+
+    PLY_INLINE bool operator==(const ReadPlanKey& other) const {
+        return this->typeDesc == other.typeDesc && this->formatDesc == other.formatDesc;
+    }
+    PLY_INLINE void appendTo(Hasher& hasher) const {
+        hasher.appendPtr(this->typeDesc);
+        hasher.appendPtr(this->formatDesc);
+    }
+};
+
+// Everything needed to read values saved with a given FormatDescriptor into a given native type
+// that can be worked out ahead of time. ReadPlans are built by ReadPlanCache::getReadPlan().
+struct ReadPlan {
+    ReadPlanKey key;
+    bool isPacked = false; // matchesPackedLayout(key.typeDesc, key.formatDesc)
+    // Struct only. True if the struct has generated serializers that can read the format:
+    bool useGeneratedRead = false;
+    // Struct only. For each member of the FormatDescriptor, the matching member of the native
+    // struct, or nullptr if there isn't one:
+    Array<const TypeDescriptor_Struct::Member*> structMembers;
+};
+
 struct Schema {
     Array<Owned<FormatDescriptor>> userFormatDescs;
 
@@ -26,8 +53,72 @@ public:
     virtual TypeDescriptor* getType(FormatDescriptor* formatDesc) = 0;
 };
 
+// ReadPlans and synthesized types built for a single Schema, shared by every ReadObjectContext
+// that reads with that Schema. ReadPlans are keyed by TypeDescriptor*, so a ReadPlanCache keeps
+// every synthesized type it hands out alive for as long as it exists. Otherwise, a destroyed
+// type's address could be reused by a new type, which would then get the stale ReadPlan. Native
+// types passed to the ReadPlanCache must outlive it, as reflected types do.
+struct ReadPlanCache {
+    struct ReadPlanTraits {
+        using Key = ReadPlanKey;
+        using Item = Owned<ReadPlan>;
+        static PLY_INLINE const ReadPlanKey& comparand(const Owned<ReadPlan>& plan) {
+            return plan->key;
+        }
+    };
+    struct SynthTraits {
+        using Key = FormatDescriptor*;
+        struct Item {
+            FormatDescriptor* formatDesc;
+            Reference<TypeDescriptorOwner> typeOwner;
+        };
+        static PLY_INLINE FormatDescriptor* comparand(const Item& item) {
+            return item.formatDesc;
+        }
+    };
+
+    // getSynthesizedType() stops sharing a TypeDescriptorOwner once it has this many references,
+    // so that its 16-bit strong reference count can't overflow:
+    static const u32 MaxSynthesizedTypeRefs = 16384;
+
+    Mutex mutex;
+    HashMap<ReadPlanTraits> readPlans;
+    HashMap<SynthTraits> synthesizedTypes;
+    // Synthesized types that getSynthesizedType() no longer hands out. ReadPlans may still be
+    // keyed by them:
+    Array<Reference<TypeDescriptorOwner>> retiredTypeOwners;
+
+    // Returns the ReadPlan for reading values having formatDesc into typeDesc, building it the
+    // first time.
+    const ReadPlan* getReadPlan(TypeDescriptor* typeDesc, FormatDescriptor* formatDesc);
+
+    // Returns a TypeDescriptorOwner synthesized from formatDesc. Equivalent synthesized types are
+    // shared, up to MaxSynthesizedTypeRefs references each.
+    TypeDescriptorOwner* getSynthesizedType(FormatDescriptor* formatDesc);
+};
+
+// A Schema returned by readCachedSchema(), along with the ReadPlans and synthesized types built
+// for it so far.
+struct CachedSchema : RefCounted<CachedSchema> {
+    String bytes; // The schema as it appears in the stream
+    Schema schema;
+    ReadPlanCache planCache;
+    u64 lastUsed = 0; // Used to evict the least recently used CachedSchema
+
+    void onRefCountZero() {
+        delete this;
+    }
+};
+
 void readSchema(Schema& schema, InStream* in);
 
+// Reads a schema from in, like readSchema(), but returns a CachedSchema that's shared with every
+// other stream containing an identical schema. Only the first stream with a given schema actually
+// builds its FormatDescriptors, and the ReadPlans and synthesized types in its planCache are
+// reused by every load that follows. Only a limited number of the most recently used
+// CachedSchemas are kept; older ones are destroyed once no load is using them.
+Reference<CachedSchema> readCachedSchema(InStream* in);
+
 #define PLY_VALIDATE_RESOLVED_PTR_TYPES 1
 
 struct LoadPtrResolver {
@@ -63,13 +154,35 @@ struct LoadPtrResolver {
 };
 
 struct ReadObjectContext {
+    struct ReadPlanTraits {
+        using Key = ReadPlanKey;
+        using Item = const ReadPlan*;
+        static PLY_INLINE const ReadPlanKey& comparand(const ReadPlan* plan) {
+            return plan->key;
+        }
+    };
+
     const Schema* schema;
     NativeEndianReader in;
     PersistentTypeResolver* typeResolver;
     LoadPtrResolver ptrResolver;
+    ReadPlanCache* planCache;
+    Owned<ReadPlanCache> ownPlanCache; // Used when no planCache is passed to the constructor
+    HashMap<ReadPlanTraits> readPlans; // Avoids locking the planCache for every lookup
+
+    ReadObjectContext(const Schema* schema, InStream* in, PersistentTypeResolver* typeResolver,
+                      ReadPlanCache* planCache = nullptr)
+        : schema(schema), in(in), typeResolver(typeResolver), planCache(planCache) {
+        if (!this->planCache) {
+            this->ownPlanCache = new ReadPlanCache;
+            this->planCache = this->ownPlanCache;
+        }
+    }
+
+    const ReadPlan* getReadPlan(TypeDescriptor* typeDesc, FormatDescriptor* formatDesc);
 
-    ReadObjectContext(const Schema* schema, InStream* in, PersistentTypeResolver* typeResolver)
-        : schema(schema), in(in), typeResolver(typeResolver) {
+    PLY_INLINE TypeDescriptorOwner* getSynthesizedType(FormatDescriptor* formatDesc) {
+        return this->planCache->getSynthesizedType(formatDesc);
     }
 };
 
@@ -5,11 +5,14 @@
 #include <ply-reflect/Core.h>
 #include <ply-reflect/PersistRead.h>
 #include <ply-reflect/TypeKey.h>
+#include <ply-reflect/TypeSynthesizer.h>
 #include <ply-runtime/container/Boxed.h>
 #include <map>
 
 namespace ply {
 
+SLOG_DECLARE_CHANNEL(Load)
+
 // Note: Many FormatDescriptor* in this file (and others) could use a "const" qualifier. Worth
 // fixing?
 
@@ -129,6 +132,57 @@ void skip(ReadObjectContext* context, FormatDescriptor* formatDesc) {
     }
 }
 
+const ReadPlan* ReadPlanCache::getReadPlan(TypeDescriptor* typeDesc, FormatDescriptor* formatDesc) {
+    LockGuard<Mutex> guard{this->mutex};
+    auto cursor = this->readPlans.insertOrFind({typeDesc, formatDesc});
+    if (cursor.wasFound())
+        return *cursor;
+
+    ReadPlan* plan = new ReadPlan;
+    *cursor = plan;
+    plan->key = {typeDesc, formatDesc};
+    plan->isPacked = matchesPackedLayout(typeDesc, formatDesc);
+    if (typeDesc->typeKey == &TypeKey_Struct &&
+        (FormatKey) formatDesc->formatKey == FormatKey::Struct) {
+        TypeDescriptor_Struct* structType = typeDesc->cast<TypeDescriptor_Struct>();
+        plan->useGeneratedRead =
+            structType->generatedRead && matchesGeneratedSerializers(typeDesc, formatDesc);
+        for (const FormatDescriptor_Struct::Member& member :
+             ((FormatDescriptor_Struct*) formatDesc)->members) {
+            const TypeDescriptor_Struct::Member* dstMember = structType->findMember(member.name);
+            if (!dstMember) {
+                SLOG(Load, "Can't find member \"{}\"", member.name);
+            }
+            plan->structMembers.append(dstMember);
+        }
+    }
+    return plan;
+}
+
+TypeDescriptorOwner* ReadPlanCache::getSynthesizedType(FormatDescriptor* formatDesc) {
+    LockGuard<Mutex> guard{this->mutex};
+    auto cursor = this->synthesizedTypes.insertOrFind(formatDesc);
+    if (!cursor.wasFound()) {
+        cursor->formatDesc = formatDesc;
+        cursor->typeOwner = synthesizeType(formatDesc);
+    }
+    if (cursor->typeOwner->getRefCount() >= MaxSynthesizedTypeRefs) {
+        // The deduplicated type is shared by too many objects. Switch to a private copy.
+        this->retiredTypeOwners.append(std::move(cursor->typeOwner));
+        cursor->typeOwner = synthesizeType(formatDesc, false);
+    }
+    return cursor->typeOwner;
+}
+
+const ReadPlan* ReadObjectContext::getReadPlan(TypeDescriptor* typeDesc,
+                                               FormatDescriptor* formatDesc) {
+    auto cursor = this->readPlans.insertOrFind({typeDesc, formatDesc});
+    if (!cursor.wasFound()) {
+        *cursor = this->planCache->getReadPlan(typeDesc, formatDesc);
+    }
+    return *cursor;
+}
+
 void readLinkTable(NativeEndianReader* in, LoadPtrResolver* ptrResolver) {
     u32 numLinkItems = in->read<u32>();
     ptrResolver->linkTable.resize(numLinkItems);
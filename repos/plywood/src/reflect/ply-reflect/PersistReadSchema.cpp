@@ -5,7 +5,6 @@
 #include <ply-reflect/Core.h>
 #include <ply-reflect/PersistRead.h>
 #include <ply-reflect/FormatDescriptor.h>
-#include <ply-runtime/container/Boxed.h>
 
 namespace ply {
 
@@ -31,117 +30,212 @@ Array<BuiltInFormatPair> BuiltInFormats = {{FormatKey::None, nullptr},
                                            {FormatKey::TypedArray, &FormatDescriptor_TypedArray},
                                            {FormatKey::Typed, &FormatDescriptor_Typed}};
 
+// Reads the FormatDescriptors of a schema and adds them to m_schema. If m_schema is null, the
+// schema is only scanned: nothing is built, and if m_bytes isn't null, every byte read is appended
+// to it instead. readCachedSchema() scans a schema to look it up in g_schemaCache before building
+// it.
 class SchemaLoader {
 public:
     Schema* m_schema;
-    NativeEndianReader m_in;
+    InStream* m_in;
+    Array<char>* m_bytes = nullptr;
 
-    SchemaLoader(Schema* schema, InStream* in) : m_schema(schema), m_in(in) {
+    SchemaLoader(Schema* schema, InStream* in, Array<char>* bytes = nullptr)
+        : m_schema(schema), m_in(in), m_bytes(bytes) {
         PLY_ASSERT(BuiltInFormats.numItems() == int(FormatKey::StartUserKeyRange));
+        PLY_ASSERT(!m_schema || !m_bytes);
     }
 
-    FormatDescriptor* readFormatDescriptor(bool topLevel = false) {
-        u8 formatKey = m_in.read<u8>();
-        if (formatKey == (u8) FormatKey::None) {
+    template <typename T>
+    T read() {
+        T value = 0;
+        m_in->read({&value, sizeof(value)});
+        if (m_bytes) {
+            m_bytes->extend({(const char*) &value, sizeof(value)});
+        }
+        return value;
+    }
+
+    String readString() {
+        u32 numBytes = read<u32>();
+        if (m_in->atEOF())
+            return {};
+        if (m_schema) {
+            String result = String::allocate(numBytes);
+            m_in->read(result.bufferView());
+            return result;
+        }
+        if (m_bytes) {
+            u32 oldSize = m_bytes->numItems();
+            m_bytes->resize(oldSize + numBytes);
+            m_in->read({m_bytes->begin() + oldSize, numBytes});
+        } else {
+            while (numBytes > 0 && m_in->tryMakeBytesAvailable()) {
+                u32 n = min<u32>(numBytes, (u32) m_in->numBytesAvailable());
+                m_in->advanceByte(n);
+                numBytes -= n;
+            }
+        }
+        return {};
+    }
+
+    // Stores the FormatDescriptor to *result, or nullptr when scanning. Returns false at the end
+    // of the schema, which is only expected when topLevel is true.
+    bool readFormatDescriptor(FormatDescriptor** result, bool topLevel = false) {
+        *result = nullptr;
+        u8 formatKey = read<u8>();
+        if (formatKey == (u8) FormatKey::None || m_in->atEOF()) {
             PLY_ASSERT(topLevel);
-            return nullptr;
+            return false;
         }
 
         if (formatKey == (u8) FormatKey::Indirect) {
-            u32 formatID = m_in.read<u32>();
+            u32 formatID = read<u32>();
+            if (!m_schema)
+                return true;
             if (formatID < FormatID_StartUserRange) {
                 PLY_ASSERT(formatID < (u32) FormatKey::StartUserKeyRange);
                 BuiltInFormatPair& pair = BuiltInFormats[formatID];
                 PLY_ASSERT((u32) pair.key == formatID);
                 PLY_ASSERT(pair.formatDesc);
-                return pair.formatDesc;
+                *result = pair.formatDesc;
             } else {
-                return m_schema->userFormatDescs[formatID - FormatID_StartUserRange];
+                *result = m_schema->userFormatDescs[formatID - FormatID_StartUserRange];
             }
+            return true;
         }
 
         if (formatKey < (u8) FormatKey::StartUserKeyRange) {
             PLY_ASSERT(!topLevel);
+            if (!m_schema)
+                return true;
             BuiltInFormatPair& pair = BuiltInFormats[formatKey];
             PLY_ASSERT((u8) pair.key == formatKey);
-            return pair.formatDesc;
+            *result = pair.formatDesc;
+            return true;
         }
 
         FormatDescriptor* newFormat = nullptr;
-        u32 userFormatIndex =
-            m_schema->userFormatDescs
-                .numItems(); // actual formatID is FormatID_StartUserRange + userFormatIndex
-        m_schema->userFormatDescs.append(nullptr);
+        // The actual formatID is FormatID_StartUserRange + userFormatIndex:
+        u32 userFormatIndex = 0;
+        if (m_schema) {
+            userFormatIndex = m_schema->userFormatDescs.numItems();
+            m_schema->userFormatDescs.append(nullptr);
+        }
         if (formatKey == (u8) FormatKey::FixedArray) {
-            u32 numItems = m_in.read<u32>();
-            FormatDescriptor* itemFormat = readFormatDescriptor();
-            newFormat = new FormatDescriptor_FixedArray{numItems, itemFormat};
+            u32 numItems = read<u32>();
+            FormatDescriptor* itemFormat;
+            readFormatDescriptor(&itemFormat);
+            if (m_schema) {
+                newFormat = new FormatDescriptor_FixedArray{numItems, itemFormat};
+            }
         } else if (formatKey == (u8) FormatKey::Array) {
-            FormatDescriptor* itemFormat = readFormatDescriptor();
-            newFormat = new FormatDescriptor_Array{itemFormat};
+            FormatDescriptor* itemFormat;
+            readFormatDescriptor(&itemFormat);
+            if (m_schema) {
+                newFormat = new FormatDescriptor_Array{itemFormat};
+            }
         } else if (formatKey == (u8) FormatKey::Owned) {
-            FormatDescriptor* childFormat = readFormatDescriptor();
-            newFormat = new FormatDescriptor_Owned{childFormat};
+            FormatDescriptor* childFormat;
+            readFormatDescriptor(&childFormat);
+            if (m_schema) {
+                newFormat = new FormatDescriptor_Owned{childFormat};
+            }
         } else if (formatKey == (u8) FormatKey::WeakPtr) {
-            FormatDescriptor* childFormat = readFormatDescriptor();
-            newFormat = new FormatDescriptor_WeakPtr{childFormat};
+            FormatDescriptor* childFormat;
+            readFormatDescriptor(&childFormat);
+            if (m_schema) {
+                newFormat = new FormatDescriptor_WeakPtr{childFormat};
+            }
         } else if (formatKey == (u8) FormatKey::Struct) {
-            FormatDescriptor_Struct* structFormat = new FormatDescriptor_Struct;
-            structFormat->name = Boxed<String>::read(m_in);
-            u16 numTemplateParams = m_in.read<u16>();
-            u16 numMembers = m_in.read<u16>();
-            structFormat->templateParams.resize(numTemplateParams);
-            for (FormatDescriptor_Struct::Member& templateParam : structFormat->templateParams) {
-                templateParam.name = Boxed<String>::read(m_in);
-                templateParam.formatDesc = readFormatDescriptor();
+            FormatDescriptor_Struct* structFormat = nullptr;
+            String name = readString();
+            u16 numTemplateParams = read<u16>();
+            u16 numMembers = read<u16>();
+            if (m_schema) {
+                structFormat = new FormatDescriptor_Struct;
+                structFormat->name = std::move(name);
+                structFormat->templateParams.resize(numTemplateParams);
+                structFormat->members.resize(numMembers);
             }
-            structFormat->members.resize(numMembers);
-            for (FormatDescriptor_Struct::Member& member : structFormat->members) {
-                member.name = Boxed<String>::read(m_in);
-                member.formatDesc = readFormatDescriptor();
+            for (u32 i = 0; i < (u32) numTemplateParams + numMembers; i++) {
+                String memberName = readString();
+                FormatDescriptor* memberFormat;
+                readFormatDescriptor(&memberFormat);
+                if (structFormat) {
+                    FormatDescriptor_Struct::Member& member =
+                        (i < numTemplateParams) ? structFormat->templateParams[i]
+                                                : structFormat->members[i - numTemplateParams];
+                    member.name = std::move(memberName);
+                    member.formatDesc = memberFormat;
+                }
             }
             newFormat = structFormat;
         } else if (formatKey == (u8) FormatKey::Enum) {
-            FormatDescriptor_Enum* enumFormat = new FormatDescriptor_Enum;
-            enumFormat->name = Boxed<String>::read(m_in);
-            enumFormat->fixedSize = m_in.read<u8>();
-            u32 numEntries = m_in.read<u32>();
-            enumFormat->identifiers.resize(numEntries);
-            for (String& name : enumFormat->identifiers) {
-                name = Boxed<String>::read(m_in);
+            FormatDescriptor_Enum* enumFormat = nullptr;
+            String name = readString();
+            u8 fixedSize = read<u8>();
+            u32 numEntries = read<u32>();
+            if (m_schema) {
+                enumFormat = new FormatDescriptor_Enum;
+                enumFormat->name = std::move(name);
+                enumFormat->fixedSize = fixedSize;
+            }
+            for (u32 i = 0; i < numEntries && !m_in->atEOF(); i++) {
+                String identifier = readString();
+                if (enumFormat) {
+                    enumFormat->identifiers.append(std::move(identifier));
+                }
             }
             newFormat = enumFormat;
         } else if (formatKey == (u8) FormatKey::EnumIndexedArray) {
-            FormatDescriptor_EnumIndexedArray* arrFormat = new FormatDescriptor_EnumIndexedArray;
-            arrFormat->itemFormat = readFormatDescriptor();
-            FormatDescriptor* enumFormat = readFormatDescriptor();
-            PLY_ASSERT(enumFormat->formatKey == (u8) FormatKey::Enum);
-            arrFormat->enumFormat = static_cast<FormatDescriptor_Enum*>(enumFormat);
-            newFormat = arrFormat;
+            FormatDescriptor* itemFormat;
+            readFormatDescriptor(&itemFormat);
+            FormatDescriptor* enumFormat;
+            readFormatDescriptor(&enumFormat);
+            if (m_schema) {
+                PLY_ASSERT(enumFormat->formatKey == (u8) FormatKey::Enum);
+                FormatDescriptor_EnumIndexedArray* arrFormat =
+                    new FormatDescriptor_EnumIndexedArray;
+                arrFormat->itemFormat = itemFormat;
+                arrFormat->enumFormat = static_cast<FormatDescriptor_Enum*>(enumFormat);
+                newFormat = arrFormat;
+            }
         } else if (formatKey == (u8) FormatKey::Switch) {
-            FormatDescriptor_Switch* switchFormat = new FormatDescriptor_Switch;
-            switchFormat->name = Boxed<String>::read(m_in);
-            u16 numStates = m_in.read<u16>();
-            switchFormat->states.resize(numStates);
-            for (FormatDescriptor_Switch::State& state : switchFormat->states) {
-                state.name = Boxed<String>::read(m_in);
-                FormatDescriptor* stateFormat = readFormatDescriptor();
-                PLY_ASSERT(stateFormat->formatKey == (u8) FormatKey::Struct);
-                state.structFormat = static_cast<FormatDescriptor_Struct*>(stateFormat);
+            FormatDescriptor_Switch* switchFormat = nullptr;
+            String name = readString();
+            u16 numStates = read<u16>();
+            if (m_schema) {
+                switchFormat = new FormatDescriptor_Switch;
+                switchFormat->name = std::move(name);
+                switchFormat->states.resize(numStates);
+            }
+            for (u32 i = 0; i < numStates; i++) {
+                String stateName = readString();
+                FormatDescriptor* stateFormat;
+                readFormatDescriptor(&stateFormat);
+                if (switchFormat) {
+                    PLY_ASSERT(stateFormat->formatKey == (u8) FormatKey::Struct);
+                    switchFormat->states[i].name = std::move(stateName);
+                    switchFormat->states[i].structFormat =
+                        static_cast<FormatDescriptor_Struct*>(stateFormat);
+                }
             }
             newFormat = switchFormat;
         } else {
             PLY_ASSERT(0);
         }
-        m_schema->userFormatDescs[userFormatIndex] = newFormat;
-        return newFormat;
+        if (m_schema) {
+            m_schema->userFormatDescs[userFormatIndex] = newFormat;
+        }
+        *result = newFormat;
+        return true;
     }
 
     void readSchema() {
         // Read all the user FormatDescriptors
-        for (;;) {
-            if (!readFormatDescriptor(true))
-                break;
+        FormatDescriptor* formatDesc;
+        while (readFormatDescriptor(&formatDesc, true)) {
         }
     }
 };
@@ -151,6 +245,63 @@ void readSchema(Schema& schema, InStream* in) {
     loader.readSchema();
 }
 
+struct SchemaCache {
+    struct Traits {
+        using Key = StringView;
+        using Item = Reference<CachedSchema>;
+        static PLY_INLINE StringView comparand(const Reference<CachedSchema>& item) {
+            return item->bytes;
+        }
+    };
+
+    static const u32 MaxSchemas = 64;
+
+    Mutex mutex;
+    HashMap<Traits> schemas;
+    u64 useCount = 0;
+};
+
+SchemaCache g_schemaCache;
+
+Reference<CachedSchema> readCachedSchema(InStream* in) {
+    // Scan the schema to find its bytes. When reading from a view, the bytes are used in place.
+    Array<char> copiedBytes;
+    StringView bytes;
+    if (in->isView()) {
+        ViewInStream* vin = in->asViewInStream();
+        ViewInStream::SavePoint savePoint = vin->savePoint();
+        SchemaLoader{nullptr, in}.readSchema();
+        bytes = StringView::fromBufferView(vin->getViewFrom(savePoint));
+    } else {
+        SchemaLoader{nullptr, in, &copiedBytes}.readSchema();
+        bytes = {copiedBytes.begin(), copiedBytes.numItems()};
+    }
+
+    LockGuard<Mutex> guard{g_schemaCache.mutex};
+    auto cursor = g_schemaCache.schemas.find(bytes);
+    if (!cursor.wasFound()) {
+        if (g_schemaCache.schemas.numItems() >= SchemaCache::MaxSchemas) {
+            // Evict the least recently used CachedSchema. Loads that are still using it hold
+            // their own Reference to it.
+            CachedSchema* lru = nullptr;
+            for (const Reference<CachedSchema>& cached : g_schemaCache.schemas) {
+                if (!lru || cached->lastUsed < lru->lastUsed) {
+                    lru = cached;
+                }
+            }
+            g_schemaCache.schemas.find(lru->bytes).erase();
+        }
+        cursor = g_schemaCache.schemas.insertOrFind(bytes);
+        CachedSchema* cached = new CachedSchema;
+        cached->bytes = bytes;
+        ViewInStream schemaIn{cached->bytes.bufferView()};
+        readSchema(cached->schema, &schemaIn);
+        *cursor = cached;
+    }
+    (*cursor)->lastUsed = ++g_schemaCache.useCount;
+    return *cursor;
+}
+
 FormatDescriptor* Schema::getFormatDesc(u32 formatID) const {
     if (formatID < FormatID_StartUserRange) {
         // To avoid this assert, and make the serialization system forward-compatible and easy
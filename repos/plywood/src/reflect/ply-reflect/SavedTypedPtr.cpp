@@ -50,8 +50,8 @@ TypeKey TypeKey_SavedTypedPtr{
         // context->typeResolver->getType(targetFormat);
 
         // Synthesize TypeDescriptor with all its child types, and give the whole group a
-        // TypeDescriptorOwner.
-        Reference<TypeDescriptorOwner> targetTypeOwner = synthesizeType(targetFormat);
+        // TypeDescriptorOwner. Equivalent synthesized types are shared.
+        Reference<TypeDescriptorOwner> targetTypeOwner = context->getSynthesizedType(targetFormat);
         TypeDescriptor* targetType = targetTypeOwner->getRootType();
 
         // Read the target
@@ -5,6 +5,7 @@
 #include <ply-reflect/Core.h>
 #include <ply-reflect/TypeConverter.h>
 #include <ply-reflect/TypeKey.h>
+#include <ply-reflect/FormatDescriptor.h>
 
 // FIXME: Remove this declaration when textures are removed from the uniform objects:
 namespace assetBank {
@@ -67,8 +68,7 @@ struct TypeConverter {
     enum class Cmd : u16 {
         SetRootSourceIndex,
         IterateArrayToFixedArray,
-        Copy32,
-        Copy32Range,
+        Convert,
         EndScope
     };
 
@@ -86,27 +86,246 @@ struct TypeConverter {
         u16 dstSize;
     };
 
-    struct BaseCmd {
-        Cmd cmd;
-        u16 dstOffset;
-        u16 srcOffset;
-    };
-
-    struct Copy32Range {
+    // Converts count numbers spaced dstStride and srcStride bytes apart. dstKey and srcKey are
+    // numeric FormatKeys; when they're the same, the numbers are copied.
+    struct Convert {
         Cmd cmd;
+        u8 dstKey;
+        u8 srcKey;
         u16 dstOffset;
         u16 srcOffset;
+        u16 dstStride;
+        u16 srcStride;
         u16 count;
     };
 };
 
-void makeConversionRecipe(OutStream* outs, const TypeConverter::WriteContext& writeCtx,
+//--------------------------------------------------------------------
+// Number conversion
+//
+using ConvertFunc = void (*)(void* dst, const void* src, u32 dstStride, u32 srcStride,
+                             u32 count);
+
+template <typename D, typename S>
+struct NumberConverter {
+    static PLY_INLINE D convert(S value) {
+        return (D) value;
+    }
+};
+
+template <typename S>
+struct NumberConverter<bool, S> {
+    static PLY_INLINE bool convert(S value) {
+        return value != 0;
+    }
+};
+
+template <typename D, typename S>
+struct ItemConverter {
+    static void run(void* dst, const void* src, u32 dstStride, u32 srcStride, u32 count) {
+        if (dstStride == sizeof(D) && srcStride == sizeof(S)) {
+            D* d = (D*) dst;
+            const S* s = (const S*) src;
+            for (u32 i = 0; i < count; i++) {
+                d[i] = NumberConverter<D, S>::convert(s[i]);
+            }
+        } else {
+            for (u32 i = 0; i < count; i++) {
+                const S* s = (const S*) PLY_PTR_OFFSET(src, (uptr) i * srcStride);
+                D* d = (D*) PLY_PTR_OFFSET(dst, (uptr) i * dstStride);
+                *d = NumberConverter<D, S>::convert(*s);
+            }
+        }
+    }
+};
+
+template <typename T>
+struct ItemConverter<T, T> {
+    static void run(void* dst, const void* src, u32 dstStride, u32 srcStride, u32 count) {
+        if (dstStride == sizeof(T) && srcStride == sizeof(T)) {
+            memcpy(dst, src, count * sizeof(T));
+        } else {
+            for (u32 i = 0; i < count; i++) {
+                *(T*) PLY_PTR_OFFSET(dst, (uptr) i * dstStride) =
+                    *(const T*) PLY_PTR_OFFSET(src, (uptr) i * srcStride);
+            }
+        }
+    }
+};
+
+template <typename D>
+ConvertFunc getConvertFunc(FormatKey srcKey) {
+    switch (srcKey) {
+        case FormatKey::Bool:
+            return ItemConverter<D, bool>::run;
+        case FormatKey::S8:
+            return ItemConverter<D, s8>::run;
+        case FormatKey::S16:
+            return ItemConverter<D, s16>::run;
+        case FormatKey::S32:
+            return ItemConverter<D, s32>::run;
+        case FormatKey::S64:
+            return ItemConverter<D, s64>::run;
+        case FormatKey::U8:
+            return ItemConverter<D, u8>::run;
+        case FormatKey::U16:
+            return ItemConverter<D, u16>::run;
+        case FormatKey::U32:
+            return ItemConverter<D, u32>::run;
+        case FormatKey::U64:
+            return ItemConverter<D, u64>::run;
+        case FormatKey::Float:
+            return ItemConverter<D, float>::run;
+        case FormatKey::Double:
+            return ItemConverter<D, double>::run;
+        default: {
+            PLY_FORCE_CRASH(); // Not a numeric FormatKey
+            return nullptr;
+        }
+    }
+}
+
+ConvertFunc getConvertFunc(FormatKey dstKey, FormatKey srcKey) {
+    switch (dstKey) {
+        case FormatKey::Bool:
+            return getConvertFunc<bool>(srcKey);
+        case FormatKey::S8:
+            return getConvertFunc<s8>(srcKey);
+        case FormatKey::S16:
+            return getConvertFunc<s16>(srcKey);
+        case FormatKey::S32:
+            return getConvertFunc<s32>(srcKey);
+        case FormatKey::S64:
+            return getConvertFunc<s64>(srcKey);
+        case FormatKey::U8:
+            return getConvertFunc<u8>(srcKey);
+        case FormatKey::U16:
+            return getConvertFunc<u16>(srcKey);
+        case FormatKey::U32:
+            return getConvertFunc<u32>(srcKey);
+        case FormatKey::U64:
+            return getConvertFunc<u64>(srcKey);
+        case FormatKey::Float:
+            return getConvertFunc<float>(srcKey);
+        case FormatKey::Double:
+            return getConvertFunc<double>(srcKey);
+        default: {
+            PLY_FORCE_CRASH(); // Not a numeric FormatKey
+            return nullptr;
+        }
+    }
+}
+
+u32 getNumberSize(FormatKey key) {
+    switch (key) {
+        case FormatKey::Bool:
+            return sizeof(bool);
+        case FormatKey::S8:
+        case FormatKey::U8:
+            return 1;
+        case FormatKey::S16:
+        case FormatKey::U16:
+            return 2;
+        case FormatKey::S32:
+        case FormatKey::U32:
+        case FormatKey::Float:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+//--------------------------------------------------------------------
+// Creating recipes
+//
+struct RecipeWriter {
+    OutStream* outs;
+    s32 sourceIndex = -1;
+    TypeConverter::Convert pending;
+    bool hasPending = false;
+
+    RecipeWriter(OutStream* outs) : outs{outs} {
+    }
+
+    // Returns the stride that places an item at the given offset right after the pending run, or
+    // 0 if there isn't one.
+    static u32 getExtendedStride(u32 pendingOffset, u32 pendingStride, u32 pendingCount,
+                                 u32 offset, u32 stride, u32 count) {
+        if (pendingCount == 1) {
+            if (offset <= pendingOffset || offset - pendingOffset > UINT16_MAX)
+                return 0;
+            pendingStride = offset - pendingOffset;
+        } else if (offset != pendingOffset + pendingCount * pendingStride) {
+            return 0;
+        }
+        return (count == 1 || stride == pendingStride) ? pendingStride : 0;
+    }
+
+    void convert(FormatKey dstKey, FormatKey srcKey, u32 dstOffset, u32 srcOffset, u32 dstStride,
+                 u32 srcStride, u32 count) {
+        if (this->hasPending && this->pending.dstKey == (u8) dstKey &&
+            this->pending.srcKey == (u8) srcKey && this->pending.count + count <= UINT16_MAX) {
+            // Try to append these numbers to the pending run
+            u32 mergedDstStride =
+                getExtendedStride(this->pending.dstOffset, this->pending.dstStride,
+                                  this->pending.count, dstOffset, dstStride, count);
+            u32 mergedSrcStride =
+                getExtendedStride(this->pending.srcOffset, this->pending.srcStride,
+                                  this->pending.count, srcOffset, srcStride, count);
+            if (mergedDstStride && mergedSrcStride) {
+                this->pending.dstStride = safeDemote<u16>(mergedDstStride);
+                this->pending.srcStride = safeDemote<u16>(mergedSrcStride);
+                this->pending.count += safeDemote<u16>(count);
+                return;
+            }
+        }
+        this->flush();
+        this->pending = {TypeConverter::Cmd::Convert,   (u8) dstKey,
+                         (u8) srcKey,                   safeDemote<u16>(dstOffset),
+                         safeDemote<u16>(srcOffset),    safeDemote<u16>(dstStride),
+                         safeDemote<u16>(srcStride),    safeDemote<u16>(count)};
+        this->hasPending = true;
+    }
+
+    void flush() {
+        if (this->hasPending) {
+            NativeEndianWriter{this->outs}.write(this->pending);
+            this->hasPending = false;
+        }
+    }
+
+    template <typename T>
+    void write(const T& cmd) {
+        this->flush();
+        NativeEndianWriter{this->outs}.write(cmd);
+    }
+
+    void setRootSourceIndex(u32 sourceIndex) {
+        if (this->sourceIndex != (s32) sourceIndex) {
+            this->write(TypeConverter::SetRootSourceIndex{TypeConverter::Cmd::SetRootSourceIndex,
+                                                          safeDemote<u16>(sourceIndex)});
+            this->sourceIndex = sourceIndex;
+        }
+    }
+};
+
+const TypeDescriptor_Struct::Member* findSourceMember(const TypeDescriptor_Struct* srcStruct,
+                                                      StringView name) {
+    for (const TypeDescriptor_Struct::Member& srcMember : srcStruct->members) {
+        if (srcMember.name == name)
+            return &srcMember;
+    }
+    return nullptr;
+}
+
+void makeConversionRecipe(RecipeWriter& writer, const TypeConverter::WriteContext& writeCtx,
                           const TypeDescriptor* typeDesc, const TypeDescriptor* srcTypeDesc) {
-    if (typeDesc->typeKey == &TypeKey_Float) {
-        PLY_ASSERT(srcTypeDesc->typeKey == &TypeKey_Float);
-        NativeEndianWriter{outs}.write(TypeConverter::BaseCmd{TypeConverter::Cmd::Copy32,
-                                                              safeDemote<u16>(writeCtx.dstOffset),
-                                                              safeDemote<u16>(writeCtx.srcOffset)});
+    FormatKey dstKey = getNumericFormatKey(typeDesc->typeKey);
+    if (dstKey != FormatKey::None) {
+        FormatKey srcKey = getNumericFormatKey(srcTypeDesc->typeKey);
+        PLY_ASSERT(srcKey != FormatKey::None); // unsupported srcTypeDesc
+        writer.convert(dstKey, srcKey, writeCtx.dstOffset, writeCtx.srcOffset,
+                       typeDesc->fixedSize, srcTypeDesc->fixedSize, 1);
     } else if (typeDesc->typeKey == &TypeKey_FixedArray) {
         const TypeDescriptor_FixedArray* dstFixedArrayType =
             typeDesc->cast<TypeDescriptor_FixedArray>();
@@ -115,19 +334,18 @@ void makeConversionRecipe(OutStream* outs, const TypeConverter::WriteContext& wr
                 srcTypeDesc->cast<TypeDescriptor_FixedArray>();
             // FIXME: Warn on size mismatch
             u32 itemsToCopy = min<u32>(dstFixedArrayType->numItems, srcFixedArrayType->numItems);
-            if (dstFixedArrayType->itemType->typeKey == &TypeKey_Float &&
-                srcFixedArrayType->itemType->typeKey == &TypeKey_Float &&
-                dstFixedArrayType->stride == sizeof(float) &&
-                srcFixedArrayType->stride == sizeof(float)) {
-                // Fast path: FixedArray of float with default stride
-                NativeEndianWriter{outs}.write(TypeConverter::Copy32Range{
-                    TypeConverter::Cmd::Copy32Range, safeDemote<u16>(writeCtx.dstOffset),
-                    safeDemote<u16>(writeCtx.srcOffset), safeDemote<u16>(itemsToCopy)});
+            FormatKey dstItemKey = getNumericFormatKey(dstFixedArrayType->itemType->typeKey);
+            FormatKey srcItemKey = getNumericFormatKey(srcFixedArrayType->itemType->typeKey);
+            if (dstItemKey != FormatKey::None && srcItemKey != FormatKey::None) {
+                // Fast path: FixedArray of numbers with any stride
+                writer.convert(dstItemKey, srcItemKey, writeCtx.dstOffset, writeCtx.srcOffset,
+                               dstFixedArrayType->stride, srcFixedArrayType->stride,
+                               itemsToCopy);
             } else {
                 // Slow path
                 TypeConverter::WriteContext childWriteCtx = writeCtx;
                 for (u32 i = 0; i < itemsToCopy; i++) {
-                    makeConversionRecipe(outs, childWriteCtx, dstFixedArrayType->itemType,
+                    makeConversionRecipe(writer, childWriteCtx, dstFixedArrayType->itemType,
                                          srcFixedArrayType->itemType);
                     childWriteCtx.dstOffset += dstFixedArrayType->stride;
                     childWriteCtx.srcOffset += srcFixedArrayType->stride;
@@ -135,7 +353,7 @@ void makeConversionRecipe(OutStream* outs, const TypeConverter::WriteContext& wr
             }
         } else if (srcTypeDesc->typeKey == &TypeKey_Array) {
             const TypeDescriptor_Array* srcArrType = srcTypeDesc->cast<TypeDescriptor_Array>();
-            NativeEndianWriter{outs}.write(TypeConverter::IterateArrayToFixedArray{
+            writer.write(TypeConverter::IterateArrayToFixedArray{
                 TypeConverter::Cmd::IterateArrayToFixedArray,
                 safeDemote<u16>(writeCtx.dstOffset),
                 safeDemote<u16>(writeCtx.srcOffset),
@@ -143,11 +361,24 @@ void makeConversionRecipe(OutStream* outs, const TypeConverter::WriteContext& wr
                 safeDemote<u16>(srcArrType->itemType->fixedSize),
                 safeDemote<u16>(dstFixedArrayType->numItems),
             });
-            makeConversionRecipe(outs, {0, 0}, dstFixedArrayType->itemType, srcArrType->itemType);
-            NativeEndianWriter{outs}.write(TypeConverter::Cmd::EndScope);
+            makeConversionRecipe(writer, {0, 0}, dstFixedArrayType->itemType,
+                                 srcArrType->itemType);
+            writer.write(TypeConverter::Cmd::EndScope);
         } else {
             PLY_FORCE_CRASH(); // unsupported srcTypeDesc
         }
+    } else if (typeDesc->typeKey == &TypeKey_Struct) {
+        PLY_ASSERT(srcTypeDesc->typeKey == &TypeKey_Struct); // unsupported srcTypeDesc
+        const TypeDescriptor_Struct* srcStruct = srcTypeDesc->cast<TypeDescriptor_Struct>();
+        for (const auto& dstMember : typeDesc->cast<TypeDescriptor_Struct>()->members) {
+            const TypeDescriptor_Struct::Member* srcMember =
+                findSourceMember(srcStruct, dstMember.name);
+            PLY_ASSERT(srcMember); // No match for dstMember
+            makeConversionRecipe(writer,
+                                 {writeCtx.dstOffset + dstMember.offset,
+                                  writeCtx.srcOffset + srcMember->offset},
+                                 dstMember.type, srcMember->type);
+        }
     } else {
         PLY_FORCE_CRASH(); // unsupported destination typeDesc
     }
@@ -155,32 +386,85 @@ void makeConversionRecipe(OutStream* outs, const TypeConverter::WriteContext& wr
 
 void createConversionRecipe(OutStream* outs, const TypeDescriptor_Struct* dstStruct,
                             const ArrayView<TypeDescriptor_Struct*>& srcStructs) {
+    RecipeWriter writer{outs};
     for (const auto& dstMember : dstStruct->members) {
         for (u32 s = 0; s < srcStructs.numItems; s++) {
-            TypeDescriptor_Struct* srcStruct = srcStructs[s];
-            for (const auto& srcMember : srcStruct->members) {
-                if (dstMember.name == srcMember.name) {
-                    NativeEndianWriter{outs}.write(TypeConverter::SetRootSourceIndex{
-                        TypeConverter::Cmd::SetRootSourceIndex, safeDemote<u16>(s)});
-                    TypeConverter::WriteContext writeCtx = {dstMember.offset, srcMember.offset};
-                    makeConversionRecipe(outs, writeCtx, dstMember.type, srcMember.type);
-                    goto found;
-                }
+            const TypeDescriptor_Struct::Member* srcMember =
+                findSourceMember(srcStructs[s], dstMember.name);
+            if (srcMember) {
+                writer.setRootSourceIndex(s);
+                TypeConverter::WriteContext writeCtx = {dstMember.offset, srcMember->offset};
+                makeConversionRecipe(writer, writeCtx, dstMember.type, srcMember->type);
+                goto found;
             }
         }
         PLY_ASSERT(0); // No match for dstMember
     found:;
     }
-    NativeEndianWriter{outs}.write(TypeConverter::Cmd::EndScope);
+    writer.write(TypeConverter::Cmd::EndScope);
 }
 
+//--------------------------------------------------------------------
+// Applying recipes
+//
 template <class T>
 const T* safeCast(ConstBufferView view) {
     PLY_ASSERT(sizeof(T) <= view.numBytes);
     return (const T*) view.bytes;
 }
 
-void convert(ChunkCursor& cursor, void* dstPtr, ArrayView<void*> srcPtrs, void* srcPtr = nullptr) {
+// Advances the cursor past the EndScope that closes the current scope.
+void skipScope(ChunkCursor& cursor) {
+    u32 depth = 0;
+    for (;;) {
+        ConstBufferView view = cursor.viewAvailable();
+        switch (*safeCast<TypeConverter::Cmd>(view)) {
+            case TypeConverter::Cmd::SetRootSourceIndex: {
+                cursor.advanceBytes(sizeof(TypeConverter::SetRootSourceIndex));
+                break;
+            }
+            case TypeConverter::Cmd::IterateArrayToFixedArray: {
+                cursor.advanceBytes(sizeof(TypeConverter::IterateArrayToFixedArray));
+                depth++;
+                break;
+            }
+            case TypeConverter::Cmd::Convert: {
+                cursor.advanceBytes(sizeof(TypeConverter::Convert));
+                break;
+            }
+            case TypeConverter::Cmd::EndScope: {
+                cursor.advanceBytes(sizeof(TypeConverter::Cmd));
+                if (depth-- == 0)
+                    return;
+                break;
+            }
+            default: {
+                PLY_FORCE_CRASH(); // Unsupported
+            }
+        }
+    }
+}
+
+void convert(ChunkCursor& cursor, void* dstPtr, ArrayView<void*> srcPtrs, void* srcPtr = nullptr);
+
+// scope points just past the IterateArrayToFixedArray command.
+void iterateArrayToFixedArray(const ChunkCursor& scope,
+                              const TypeConverter::IterateArrayToFixedArray& cmd, void* dstPtr,
+                              ArrayView<void*> srcPtrs, void* srcPtr) {
+    details::BaseArray* baseArr = (details::BaseArray*) PLY_PTR_OFFSET(srcPtr, cmd.srcOffset);
+    // FIXME: Warn if baseArr has too many source elements
+    u32 itemsToCopy = min<u32>(cmd.dstSize, baseArr->m_numItems);
+    void* childDstPtr = PLY_PTR_OFFSET(dstPtr, cmd.dstOffset);
+    void* childSrcPtr = baseArr->m_items;
+    for (u32 i = 0; i < itemsToCopy; i++) {
+        ChunkCursor childCursor = scope; // Copy child cursor
+        convert(childCursor, childDstPtr, srcPtrs, childSrcPtr);
+        childDstPtr = PLY_PTR_OFFSET(childDstPtr, cmd.dstStride);
+        childSrcPtr = PLY_PTR_OFFSET(childSrcPtr, cmd.srcStride);
+    }
+}
+
+void convert(ChunkCursor& cursor, void* dstPtr, ArrayView<void*> srcPtrs, void* srcPtr) {
     for (;;) {
         ConstBufferView view = cursor.viewAvailable();
         switch (*safeCast<TypeConverter::Cmd>(view)) {
@@ -196,47 +480,92 @@ void convert(ChunkCursor& cursor, void* dstPtr, ArrayView<void*> srcPtrs, void*
             case TypeConverter::Cmd::IterateArrayToFixedArray: {
                 auto cmd = *safeCast<TypeConverter::IterateArrayToFixedArray>(view);
                 cursor.advanceBytes(sizeof(TypeConverter::IterateArrayToFixedArray));
+                iterateArrayToFixedArray(cursor, cmd, dstPtr, srcPtrs, srcPtr);
+                skipScope(cursor);
+                break;
+            }
 
-                details::BaseArray* baseArr =
-                    (details::BaseArray*) PLY_PTR_OFFSET(srcPtr, cmd.srcOffset);
-                // FIXME: Warn if baseArr has too many source elements
-                u32 itemsToCopy = min<u32>(cmd.dstSize, baseArr->m_numItems);
-                void* childDstPtr = PLY_PTR_OFFSET(dstPtr, cmd.dstOffset);
-                void* childSrcPtr = baseArr->m_items;
-                while (itemsToCopy) {
-                    ChunkCursor childCursor = cursor; // Copy child cursor
-                    convert(childCursor, childDstPtr, srcPtrs, childSrcPtr);
-                    childDstPtr = PLY_PTR_OFFSET(childDstPtr, cmd.dstStride);
-                    childSrcPtr = PLY_PTR_OFFSET(childSrcPtr, cmd.srcStride);
-                    if (--itemsToCopy == 0) {
-                        cursor = childCursor;
-                    }
-                }
+            case TypeConverter::Cmd::Convert: {
+                auto cmd = *safeCast<TypeConverter::Convert>(view);
+                getConvertFunc((FormatKey) cmd.dstKey, (FormatKey) cmd.srcKey)(
+                    PLY_PTR_OFFSET(dstPtr, cmd.dstOffset), PLY_PTR_OFFSET(srcPtr, cmd.srcOffset),
+                    cmd.dstStride, cmd.srcStride, cmd.count);
+                cursor.advanceBytes(sizeof(TypeConverter::Convert));
+                break;
+            }
+
+            case TypeConverter::Cmd::EndScope: {
+                cursor.advanceBytes(sizeof(TypeConverter::Cmd));
+                return;
+            }
+
+            default: {
+                PLY_FORCE_CRASH(); // Unsupported
+            }
+        }
+    }
+}
+
+void applyConversionRecipe(ChunkCursor recipe, void* dstPtr, ArrayView<void*> srcPtrs) {
+    convert(recipe, dstPtr, srcPtrs);
+}
+
+// Converts the objects numbered [first, first + numObjects).
+void convertBatch(ChunkCursor recipe, StridedPtr dst, ArrayView<const StridedPtr> srcs, u32 first,
+                  u32 numObjects) {
+    dst.ptr = PLY_PTR_OFFSET(dst.ptr, (uptr) first * dst.stride);
+    StridedPtr src = {nullptr, 0};
+    for (;;) {
+        ConstBufferView view = recipe.viewAvailable();
+        switch (*safeCast<TypeConverter::Cmd>(view)) {
+            case TypeConverter::Cmd::SetRootSourceIndex: {
+                src = srcs[safeCast<TypeConverter::SetRootSourceIndex>(view)->sourceIndex];
+                src.ptr = PLY_PTR_OFFSET(src.ptr, (uptr) first * src.stride);
+                recipe.advanceBytes(sizeof(TypeConverter::SetRootSourceIndex));
                 break;
             }
 
-            case TypeConverter::Cmd::Copy32: {
-                auto* cmd = safeCast<TypeConverter::BaseCmd>(view);
-                *(u32*) PLY_PTR_OFFSET(dstPtr, cmd->dstOffset) =
-                    *(u32*) PLY_PTR_OFFSET(srcPtr, cmd->srcOffset);
-                cursor.advanceBytes(sizeof(TypeConverter::BaseCmd));
+            case TypeConverter::Cmd::IterateArrayToFixedArray: {
+                // Each object's source Array has its own length, so the objects are converted
+                // one at a time
+                auto cmd = *safeCast<TypeConverter::IterateArrayToFixedArray>(view);
+                recipe.advanceBytes(sizeof(TypeConverter::IterateArrayToFixedArray));
+                for (u32 i = 0; i < numObjects; i++) {
+                    iterateArrayToFixedArray(recipe, cmd,
+                                             PLY_PTR_OFFSET(dst.ptr, (uptr) i * dst.stride), {},
+                                             PLY_PTR_OFFSET(src.ptr, (uptr) i * src.stride));
+                }
+                skipScope(recipe);
                 break;
             }
 
-            case TypeConverter::Cmd::Copy32Range: {
-                auto* cmd = safeCast<TypeConverter::Copy32Range>(view);
-                u32* dst = (u32*) PLY_PTR_OFFSET(dstPtr, cmd->dstOffset);
-                u32* dstEnd = dst + cmd->count;
-                u32* src = (u32*) PLY_PTR_OFFSET(srcPtr, cmd->srcOffset);
-                while (dst < dstEnd) {
-                    *dst++ = *src++;
+            case TypeConverter::Cmd::Convert: {
+                auto cmd = *safeCast<TypeConverter::Convert>(view);
+                ConvertFunc func = getConvertFunc((FormatKey) cmd.dstKey, (FormatKey) cmd.srcKey);
+                void* dstPtr = PLY_PTR_OFFSET(dst.ptr, cmd.dstOffset);
+                void* srcPtr = PLY_PTR_OFFSET(src.ptr, cmd.srcOffset);
+                bool isContiguous = cmd.dstStride == getNumberSize((FormatKey) cmd.dstKey) &&
+                                    cmd.srcStride == getNumberSize((FormatKey) cmd.srcKey);
+                if (isContiguous || cmd.count >= numObjects) {
+                    // Convert each object's run of numbers in a single call
+                    for (u32 i = 0; i < numObjects; i++) {
+                        func(PLY_PTR_OFFSET(dstPtr, (uptr) i * dst.stride),
+                             PLY_PTR_OFFSET(srcPtr, (uptr) i * src.stride), cmd.dstStride,
+                             cmd.srcStride, cmd.count);
+                    }
+                } else {
+                    // Convert the same number in every object in a single call
+                    for (u32 j = 0; j < cmd.count; j++) {
+                        func(PLY_PTR_OFFSET(dstPtr, j * cmd.dstStride),
+                             PLY_PTR_OFFSET(srcPtr, j * cmd.srcStride), dst.stride, src.stride,
+                             numObjects);
+                    }
                 }
-                cursor.advanceBytes(sizeof(TypeConverter::Copy32Range));
+                recipe.advanceBytes(sizeof(TypeConverter::Convert));
                 break;
             }
 
             case TypeConverter::Cmd::EndScope: {
-                cursor.advanceBytes(sizeof(TypeConverter::Cmd));
                 return;
             }
 
@@ -247,8 +576,14 @@ void convert(ChunkCursor& cursor, void* dstPtr, ArrayView<void*> srcPtrs, void*
     }
 }
 
-void applyConversionRecipe(ChunkCursor recipe, void* dstPtr, ArrayView<void*> srcPtrs) {
-    convert(recipe, dstPtr, srcPtrs);
+void applyConversionRecipe(ChunkCursor recipe, StridedPtr dst, ArrayView<const StridedPtr> srcs,
+                           u32 numObjects) {
+    // Objects are converted in blocks that are small enough to stay in the cache while every
+    // command in the recipe is applied to them
+    static const u32 BlockSize = 64;
+    for (u32 first = 0; first < numObjects; first += BlockSize) {
+        convertBatch(recipe, dst, srcs, first, min<u32>(numObjects - first, BlockSize));
+    }
 }
 
 } // namespace ply
@@ -10,8 +10,25 @@ namespace ply {
 
 // void writeTypeSignature(BinaryBuffer& sig, const TypeDescriptor* typeDesc); disabled for now
 
+// A conversion recipe copies the members of one or more source structs into the members of a
+// destination struct with the same names. Numbers are converted between any of the built-in numeric
+// types, and FixedArrays can have any stride on either side, so members can be moved between
+// interleaved and separate layouts. Runs of numbers that are evenly spaced in both structs are
+// merged into a single command when the recipe is created.
 void createConversionRecipe(OutStream* outs, const TypeDescriptor_Struct* dstStruct,
                             const ArrayView<TypeDescriptor_Struct*>& srcStructs);
 void applyConversionRecipe(ChunkCursor recipe, void* dstPtr, ArrayView<void*> srcPtrs);
 
+// Objects of the same type spaced stride bytes apart.
+struct StridedPtr {
+    void* ptr;
+    u32 stride;
+};
+
+// Applies a conversion recipe to numObjects objects at once. Each command in the recipe is applied
+// to every object before moving on to the next command, so each number in the recipe becomes a
+// single tight loop over all the objects, which the compiler can vectorize.
+void applyConversionRecipe(ChunkCursor recipe, StridedPtr dst, ArrayView<const StridedPtr> srcs,
+                           u32 numObjects);
+
 } // namespace ply
@@ -420,14 +420,25 @@ struct TypeDescriptor_Struct : TypeDescriptor {
     Array<TemplateParam> templateParams;
     Array<Member> members;
 
-    // Use expression SFINAE to invoke the object's onPostSerialize() function, if present:
+    // Use expression SFINAE to find the object's onPostSerialize() function, if present:
+    using PostSerializeFunc = void (*)(void* ptr);
     template <class T>
-    static auto invokePostSerialize(T* obj) -> decltype(obj->onPostSerialize()) {
-        return obj->onPostSerialize();
+    static auto getPostSerialize(T* obj) -> decltype(obj->onPostSerialize(), PostSerializeFunc{}) {
+        return [](void* ptr) { ((T*) ptr)->onPostSerialize(); };
     }
-    inline static void invokePostSerialize(...) {
+    inline static PostSerializeFunc getPostSerialize(...) {
+        return nullptr;
     }
-    void (*onPostSerialize)(void* ptr) = [](void*) {};
+    PostSerializeFunc onPostSerialize = nullptr; // Null if there's no onPostSerialize()
+
+    // Set for structs declared with PLY_REFLECT_WITH_SERIALIZERS(). These functions are generated
+    // by plytool and serialize each member directly, instead of walking the members. generatedRead
+    // is only called for formats accepted by matchesGeneratedSerializers().
+    using GeneratedWriteFunc = void (*)(const void* ptr, WriteObjectContext* context);
+    using GeneratedReadFunc = void (*)(void* ptr, ReadObjectContext* context,
+                                       FormatDescriptor* formatDesc);
+    GeneratedWriteFunc generatedWrite = nullptr;
+    GeneratedReadFunc generatedRead = nullptr;
 
     // Constructor for synthesized TypeDescriptor_Struct:
     TypeDescriptor_Struct(u32 fixedSize, StringView name)
@@ -439,7 +450,7 @@ struct TypeDescriptor_Struct : TypeDescriptor {
     TypeDescriptor_Struct(T*, StringView name, std::initializer_list<Member> members = {})
         : TypeDescriptor{&TypeKey_Struct, sizeof(T), NativeBindings::make<T>()}, name{name},
           members{members} {
-        onPostSerialize = [](void* ptr) { invokePostSerialize((T*) ptr); };
+        onPostSerialize = getPostSerialize((T*) nullptr);
     }
 
     void appendMember(StringView name, TypeDescriptor* type) {
@@ -488,6 +499,16 @@ struct Initializer {
     static ply::Initializer initReflectionObj; \
     static void initReflectionMembers();
 
+// Like PLY_REFLECT(), but also makes plytool generate serializers for the struct. The generated
+// code uses macros from <ply-reflect/PersistGenerated.h>, which the .cpp file that includes the
+// generated .inl file must include.
+#define PLY_REFLECT_WITH_SERIALIZERS(...) \
+    PLY_REFLECT(__VA_ARGS__) \
+    static void writeGenerated(const void* ptr, ply::WriteObjectContext* context); \
+    static void readGenerated(void* ptr, ply::ReadObjectContext* context, \
+                              ply::FormatDescriptor* formatDesc); \
+    static ply::Initializer initSerializersObj;
+
 #define PLY_STATE_REFLECT(name) \
     PLY_STATE(name) \
     PLY_REFLECT()
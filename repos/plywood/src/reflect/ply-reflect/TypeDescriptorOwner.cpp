@@ -5,4 +5,10 @@
 #include <ply-reflect/Core.h>
 #include <ply-reflect/TypeDescriptorOwner.h>
 
+namespace ply {
+
+void (*TypeDescriptorOwner::onDestroyType)(TypeDescriptor* type) = nullptr;
+
+} // namespace ply
+
 #include "codegen/TypeDescriptorOwner.inl" //%%
@@ -25,6 +25,11 @@ protected:
                                           // m_synthesizedTypes; eg. index buffers just contain u16
 
     void onPartialRefCountZero() { // Called from DualRefCounted mixin
+        if (onDestroyType) {
+            for (TypeDescriptor* type : m_synthesizedTypes) {
+                onDestroyType(type);
+            }
+        }
         m_synthesizedTypes.clear();
         m_rootType = nullptr;
     }
@@ -34,6 +39,10 @@ protected:
     }
 
 public:
+    // If set, called for each synthesized type just before it's destroyed, so that caches keyed by
+    // TypeDescriptor*, such as pylon's TypePlanCache, can evict it.
+    static PLY_DLL_ENTRY void (*onDestroyType)(TypeDescriptor* type);
+
     void adoptType(TypeDescriptor* type) {
         m_synthesizedTypes.append(type);
     }
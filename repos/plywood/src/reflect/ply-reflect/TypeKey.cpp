@@ -174,6 +174,139 @@ TypeKey TypeKey_String{[](TypedPtr obj, WriteObjectContext* context) {
                        },
                        TypeKey::hashEmptyDescriptor, TypeKey::alwaysEqualDescriptors};
 
+//-----------------------------------------------------------------
+// Packed layouts
+//
+FormatKey getNumericFormatKey(const TypeKey* typeKey) {
+    if (typeKey == &TypeKey_Bool) {
+        return FormatKey::Bool;
+    } else if (typeKey == &TypeKey_S8) {
+        return FormatKey::S8;
+    } else if (typeKey == &TypeKey_S16) {
+        return FormatKey::S16;
+    } else if (typeKey == &TypeKey_S32) {
+        return FormatKey::S32;
+    } else if (typeKey == &TypeKey_S64) {
+        return FormatKey::S64;
+    } else if (typeKey == &TypeKey_U8) {
+        return FormatKey::U8;
+    } else if (typeKey == &TypeKey_U16) {
+        return FormatKey::U16;
+    } else if (typeKey == &TypeKey_U32) {
+        return FormatKey::U32;
+    } else if (typeKey == &TypeKey_U64) {
+        return FormatKey::U64;
+    } else if (typeKey == &TypeKey_Float) {
+        return FormatKey::Float;
+    } else if (typeKey == &TypeKey_Double) {
+        return FormatKey::Double;
+    }
+    return FormatKey::None;
+}
+
+bool hasPackedLayout(const TypeDescriptor* typeDesc) {
+    if (getNumericFormatKey(typeDesc->typeKey) != FormatKey::None)
+        return true;
+    if (typeDesc->typeKey == &TypeKey_FixedArray) {
+        const auto* fixedArrayType = typeDesc->cast<const TypeDescriptor_FixedArray>();
+        return (fixedArrayType->stride == fixedArrayType->itemType->fixedSize) &&
+               hasPackedLayout(fixedArrayType->itemType);
+    }
+    if (typeDesc->typeKey == &TypeKey_Struct) {
+        const auto* structType = typeDesc->cast<const TypeDescriptor_Struct>();
+        if (structType->onPostSerialize)
+            return false;
+        u32 offset = 0;
+        for (const TypeDescriptor_Struct::Member& member : structType->members) {
+            if (member.offset != offset || !hasPackedLayout(member.type))
+                return false;
+            offset += member.type->fixedSize;
+        }
+        return offset == structType->fixedSize;
+    }
+    return false;
+}
+
+bool matchesPackedLayout(const TypeDescriptor* typeDesc, const FormatDescriptor* formatDesc) {
+    FormatKey formatKey = (FormatKey) formatDesc->formatKey;
+    FormatKey numericKey = getNumericFormatKey(typeDesc->typeKey);
+    if (numericKey != FormatKey::None)
+        return formatKey == numericKey;
+    if (typeDesc->typeKey == &TypeKey_FixedArray) {
+        if (formatKey != FormatKey::FixedArray)
+            return false;
+        const auto* fixedArrayType = typeDesc->cast<const TypeDescriptor_FixedArray>();
+        const auto* fixedFormat = (const FormatDescriptor_FixedArray*) formatDesc;
+        return (fixedFormat->numItems == fixedArrayType->numItems) &&
+               (fixedArrayType->stride == fixedArrayType->itemType->fixedSize) &&
+               matchesPackedLayout(fixedArrayType->itemType, fixedFormat->itemFormat);
+    }
+    if (typeDesc->typeKey == &TypeKey_Struct) {
+        if (formatKey != FormatKey::Struct)
+            return false;
+        const auto* structType = typeDesc->cast<const TypeDescriptor_Struct>();
+        const auto* structFormat = (const FormatDescriptor_Struct*) formatDesc;
+        if (structType->onPostSerialize ||
+            structFormat->members.numItems() != structType->members.numItems())
+            return false;
+        u32 offset = 0;
+        for (u32 i = 0; i < structType->members.numItems(); i++) {
+            const TypeDescriptor_Struct::Member& member = structType->members[i];
+            const FormatDescriptor_Struct::Member& formatMember = structFormat->members[i];
+            if (member.offset != offset || member.name != formatMember.name ||
+                !matchesPackedLayout(member.type, formatMember.formatDesc))
+                return false;
+            offset += member.type->fixedSize;
+        }
+        return offset == structType->fixedSize;
+    }
+    return false;
+}
+
+bool matchesGeneratedSerializers(const TypeDescriptor* typeDesc,
+                                 const FormatDescriptor* formatDesc) {
+    FormatKey formatKey = (FormatKey) formatDesc->formatKey;
+    FormatKey numericKey = getNumericFormatKey(typeDesc->typeKey);
+    if (numericKey != FormatKey::None)
+        return formatKey == numericKey;
+    if (typeDesc->typeKey == &TypeKey_String)
+        return formatKey == FormatKey::String;
+    if (typeDesc->typeKey == &TypeKey_FixedArray) {
+        if (formatKey != FormatKey::FixedArray)
+            return false;
+        const auto* fixedArrayType = typeDesc->cast<const TypeDescriptor_FixedArray>();
+        const auto* fixedFormat = (const FormatDescriptor_FixedArray*) formatDesc;
+        return (fixedFormat->numItems == fixedArrayType->numItems) &&
+               matchesGeneratedSerializers(fixedArrayType->itemType, fixedFormat->itemFormat);
+    }
+    if (typeDesc->typeKey == &TypeKey_Array) {
+        if (formatKey != FormatKey::Array)
+            return false;
+        const auto* arrayFormat = (const FormatDescriptor_Array*) formatDesc;
+        return matchesGeneratedSerializers(typeDesc->cast<const TypeDescriptor_Array>()->itemType,
+                                           arrayFormat->itemFormat);
+    }
+    if (typeDesc->typeKey == &TypeKey_Struct) {
+        const auto* structType = typeDesc->cast<const TypeDescriptor_Struct>();
+        if (!structType->generatedRead)
+            return true;
+        if (formatKey != FormatKey::Struct)
+            return false;
+        const auto* structFormat = (const FormatDescriptor_Struct*) formatDesc;
+        if (structFormat->members.numItems() != structType->members.numItems())
+            return false;
+        for (u32 i = 0; i < structType->members.numItems(); i++) {
+            const TypeDescriptor_Struct::Member& member = structType->members[i];
+            const FormatDescriptor_Struct::Member& formatMember = structFormat->members[i];
+            if (member.name != formatMember.name ||
+                !matchesGeneratedSerializers(member.type, formatMember.formatDesc))
+                return false;
+        }
+        return true;
+    }
+    return true;
+}
+
 //-----------------------------------------------------------------
 // TypeKey_FixedArray
 //
@@ -183,6 +316,10 @@ TypeKey TypeKey_FixedArray{
         TypeDescriptor_FixedArray* fixedArrayType = obj.type->cast<TypeDescriptor_FixedArray>();
         TypeDescriptor* itemType = fixedArrayType->itemType;
         u32 itemSize = itemType->fixedSize;
+        if (hasPackedLayout(fixedArrayType)) {
+            context->out.outs->write({obj.ptr, fixedArrayType->fixedSize});
+            return;
+        }
         void* item = obj.ptr;
         for (u32 i : range(fixedArrayType->numItems)) {
             PLY_UNUSED(i);
@@ -211,6 +348,10 @@ TypeKey TypeKey_FixedArray{
             skip(context, formatDesc);
             return;
         }
+        if (context->getReadPlan(fixedArrayType, fixedFormat)->isPacked) {
+            context->in.ins->read({obj.ptr, fixedArrayType->fixedSize});
+            return;
+        }
         FormatDescriptor* itemFormat = fixedFormat->itemFormat;
         TypeDescriptor* itemType = fixedArrayType->itemType;
         u32 itemSize = itemType->fixedSize;
@@ -253,6 +394,10 @@ TypeKey TypeKey_Array{
         void* item = arr->m_items;
         PLY_ASSERT(arr->m_numItems <= UINT32_MAX);
         context->out.write<u32>((u32) arr->m_numItems);
+        if (hasPackedLayout(itemType)) {
+            context->out.outs->write({item, arr->m_numItems * itemSize});
+            return;
+        }
         for (u32 i : range(arr->m_numItems)) {
             PLY_UNUSED(i);
             itemType->typeKey->write(TypedPtr{item, itemType}, context);
@@ -283,6 +428,11 @@ TypeKey TypeKey_Array{
         details::BaseArray* arr = (details::BaseArray*) obj.ptr;
         // FIXME: Destruct existing elements if array not empty
         arr->realloc(arrSize, itemSize);
+        if (context->getReadPlan(itemType, itemFormat)->isPacked) {
+            // Every byte of each item gets overwritten, so there's no need to construct them
+            context->in.ins->read({arr->m_items, arrSize * itemSize});
+            return;
+        }
         void* item = arr->m_items;
         for (u32 i : range((u32) arrSize)) {
             PLY_UNUSED(i);
@@ -452,20 +602,14 @@ TypeKey* TypeDescriptor_Reference::typeKey = &TypeKey_Reference;
 //-----------------------------------------------------------------
 // TypeKey_Struct
 //
-TypeDescriptor_Struct::Member* findMember(TypeDescriptor_Struct* structType, const String& name) {
-    // FIXME: Improve TypeDescriptor_Struct with lookup table
-    for (TypeDescriptor_Struct::Member& member : structType->members) {
-        // FIXME: Avoid implicit conversion of member.name (char *) to String
-        if (name == member.name)
-            return &member;
-    }
-    return nullptr;
-}
-
 TypeKey TypeKey_Struct{
     // write
     [](TypedPtr obj, WriteObjectContext* context) {
         TypeDescriptor_Struct* structType = obj.type->cast<TypeDescriptor_Struct>();
+        if (structType->generatedWrite) {
+            structType->generatedWrite(obj.ptr, context);
+            return;
+        }
         for (const TypeDescriptor_Struct::Member& member : structType->members) {
             TypedPtr typedMember{PLY_PTR_OFFSET(obj.ptr, member.offset), member.type};
             member.type->typeKey->write(typedMember, context);
@@ -494,20 +638,25 @@ TypeKey TypeKey_Struct{
         }
         FormatDescriptor_Struct* structFormat = (FormatDescriptor_Struct*) formatDesc;
         TypeDescriptor_Struct* structType = obj.type->cast<TypeDescriptor_Struct>();
-        for (const FormatDescriptor_Struct::Member& member : structFormat->members) {
-            // FIXME: Improve this by finding all the matching struct members ahead of time,
-            // and caching them, in a separate pass
-            TypeDescriptor_Struct::Member* dstMember = findMember(structType, member.name);
+        const ReadPlan* plan = context->getReadPlan(structType, structFormat);
+        if (plan->useGeneratedRead) {
+            structType->generatedRead(obj.ptr, context, structFormat);
+            return;
+        }
+        for (u32 i = 0; i < structFormat->members.numItems(); i++) {
+            FormatDescriptor* memberFormat = structFormat->members[i].formatDesc;
+            const TypeDescriptor_Struct::Member* dstMember = plan->structMembers[i];
             if (!dstMember) {
-                SLOG(Load, "Can't find member \"{}\"", member.name);
-                skip(context, member.formatDesc);
+                skip(context, memberFormat);
                 continue;
             }
             TypedPtr typedMember{PLY_PTR_OFFSET(obj.ptr, dstMember->offset), dstMember->type};
-            dstMember->type->typeKey->read(typedMember, context, member.formatDesc);
+            dstMember->type->typeKey->read(typedMember, context, memberFormat);
         }
         // FIXME: Identify any members of the structType that *weren't* serialized.
-        structType->onPostSerialize(obj.ptr);
+        if (structType->onPostSerialize) {
+            structType->onPostSerialize(obj.ptr);
+        }
     },
     // hashDescriptor
     [](Hasher& hasher, const TypeDescriptor* typeDesc) {
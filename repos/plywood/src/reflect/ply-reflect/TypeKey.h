@@ -12,6 +12,7 @@ class WriteFormatContext;
 struct WriteObjectContext;
 struct ReadObjectContext;
 struct FormatDescriptor;
+enum class FormatKey;
 
 //-----------------------------------------------------------------------
 // TypeKey
@@ -39,4 +40,31 @@ struct TypeKey {
                                        const TypeDescriptor* typeDesc1);
 };
 
+//-----------------------------------------------------------------------
+// Packed layouts
+//
+// A type has a packed layout if it consists only of numeric values, with no padding between them
+// and no onPostSerialize() hook. Its serialized form is then identical to its bytes in memory, so
+// arrays of such items are written and read with a single call instead of one call per item.
+//
+bool hasPackedLayout(const TypeDescriptor* typeDesc);
+
+// Returns true if typeDesc has a packed layout and formatDesc describes the same layout, which
+// means that saved data having formatDesc can be read directly into memory.
+bool matchesPackedLayout(const TypeDescriptor* typeDesc, const FormatDescriptor* formatDesc);
+
+// Returns the FormatKey of a numeric type's TypeKey, or FormatKey::None for any other TypeKey.
+FormatKey getNumericFormatKey(const TypeKey* typeKey);
+
+//-----------------------------------------------------------------------
+// Generated serializers
+//
+// Returns true if saved data having formatDesc can be read by the serializers that plytool
+// generates for structs declared with PLY_REFLECT_WITH_SERIALIZERS(). Those serializers expect
+// numbers, strings, arrays and such structs to be saved in exactly the format they're written
+// in. Anything else is read through its TypeKey, which accepts any format.
+//
+bool matchesGeneratedSerializers(const TypeDescriptor* typeDesc,
+                                 const FormatDescriptor* formatDesc);
+
 } // namespace ply
@@ -103,11 +103,13 @@ void append(TypeSynthesizer* synth, TypeDescriptor* typeDesc) {
     synth->m_typeDescOwner->adoptType(typeDesc);
 }
 
-Reference<TypeDescriptorOwner> synthesizeType(FormatDescriptor* formatDesc) {
+Reference<TypeDescriptorOwner> synthesizeType(FormatDescriptor* formatDesc, bool deduplicate) {
     Reference<TypeDescriptorOwner> typeDescOwner = new TypeDescriptorOwner;
     TypeSynthesizer synth;
     synth.m_typeDescOwner = typeDescOwner;
     typeDescOwner->setRootType(synthesize(&synth, formatDesc));
+    if (!deduplicate)
+        return typeDescOwner;
     return getUniqueType(&g_typeDedup, typeDescOwner);
 }
 
@@ -11,8 +11,9 @@
 namespace ply {
 
 // Might actually be a built-in FormatDescriptor, like FormatDescriptor_U16 (in the case of
-// index buffers):
-Reference<TypeDescriptorOwner> synthesizeType(FormatDescriptor* format);
+// index buffers). If deduplicate is true, returns the same TypeDescriptorOwner as every earlier
+// call that synthesized an equivalent type.
+Reference<TypeDescriptorOwner> synthesizeType(FormatDescriptor* format, bool deduplicate = true);
 
 // Currently, we just use a global hook for the app to install custom type synthesizers.
 // If needed, we could use a more flexible approach in the future:
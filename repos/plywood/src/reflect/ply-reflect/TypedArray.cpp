@@ -99,6 +99,10 @@ TypeKey TypeKey_TypedArray{
         void* item = arr->m_array.m_items;
         PLY_ASSERT(arr->m_array.m_numItems <= UINT32_MAX);
         context->out.write<u32>((u32) arr->m_array.m_numItems);
+        if (hasPackedLayout(itemType)) {
+            context->out.outs->write({item, arr->m_array.m_numItems * itemSize});
+            return;
+        }
         for (u32 i : range(arr->m_array.m_numItems)) {
             PLY_UNUSED(i);
             itemType->typeKey->write(TypedPtr{item, itemType}, context);
@@ -126,8 +130,8 @@ TypeKey TypeKey_TypedArray{
         FormatDescriptor* itemFormat = context->schema->getFormatDesc(itemFormatID);
 
         // Synthesize TypeDescriptor with all its child types, and give the whole group a
-        // TypeDescriptorOwner.
-        Reference<TypeDescriptorOwner> itemTypeOwner = synthesizeType(itemFormat);
+        // TypeDescriptorOwner. Equivalent synthesized types are shared.
+        Reference<TypeDescriptorOwner> itemTypeOwner = context->getSynthesizedType(itemFormat);
         TypeDescriptor* itemType = itemTypeOwner->getRootType();
 
         // Read all array items
@@ -135,6 +139,10 @@ TypeKey TypeKey_TypedArray{
         u32 itemSize = itemType->fixedSize;
         u32 arrSize = context->in.read<u32>();
         arr->create(itemTypeOwner, arrSize);
+        if (context->getReadPlan(itemType, itemFormat)->isPacked) {
+            context->in.ins->read({arr->m_array.m_items, arrSize * itemSize});
+            return;
+        }
         TypedPtr typedItem{arr->m_array.m_items, itemType};
         for (u32 i : range((u32) arrSize)) {
             PLY_UNUSED(i);
@@ -29,6 +29,7 @@
 #include <ply-runtime/memory/Heap.h>
 #include <ply-runtime/network/Socket.h>
 #include <ply-runtime/process/Subprocess.h>
+#include <ply-runtime/string/Label.h>
 #include <ply-runtime/string/String.h>
 #include <ply-runtime/io/text/StringReader.h>
 #include <ply-runtime/io/text/StringWriter.h>
@@ -0,0 +1,105 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+#include <ply-runtime/algorithm/Sort.h>
+#include <ply-runtime/thread/ConditionVariable.h>
+#include <ply-runtime/thread/Thread.h>
+
+namespace ply {
+
+namespace details {
+// Subviews smaller than this are not worth handing off to another thread.
+static constexpr u32 ParallelSortThreshold = 8192;
+
+// A fixed set of worker threads that take subviews from a shared stack. Each worker partitions the
+// subview it took, pushes the smaller side back onto the stack for any idle worker, and keeps going
+// with the larger side until it's small enough to finish with introSort. The threads are created
+// once per call to parallelSort() instead of once per level of recursion.
+template <typename T, typename IsLess>
+struct ParallelSortPool {
+    struct Task {
+        ArrayView<T> view;
+        u32 depthLimit = 0;
+    };
+
+    const IsLess& isLess;
+    Mutex mutex;
+    ConditionVariable condVar;
+    Array<Task> tasks;
+    u32 numBusy = 0; // Number of workers currently sorting a Task
+
+    PLY_INLINE ParallelSortPool(const IsLess& isLess) : isLess{isLess} {
+    }
+
+    PLY_NO_INLINE void sortTask(Task task) {
+        while (task.view.numItems >= ParallelSortThreshold && task.depthLimit > 0) {
+            u32 pivot = partition(task.view, this->isLess);
+            Task left{task.view.subView(0, pivot), task.depthLimit - 1};
+            Task right{task.view.subView(pivot + 1), task.depthLimit - 1};
+            if (left.view.numItems > right.view.numItems) {
+                std::swap(left, right);
+            }
+            {
+                LockGuard<Mutex> guard{this->mutex};
+                this->tasks.append(left);
+            }
+            this->condVar.wakeOne();
+            task = right;
+        }
+        introSort(task.view, task.depthLimit, this->isLess);
+    }
+
+    PLY_NO_INLINE void runWorker() {
+        LockGuard<Mutex> guard{this->mutex};
+        for (;;) {
+            if (this->tasks.numItems() > 0) {
+                Task task = this->tasks.back();
+                this->tasks.pop();
+                this->numBusy++;
+                this->mutex.unlock();
+                this->sortTask(task);
+                this->mutex.lock();
+                this->numBusy--;
+            } else if (this->numBusy == 0) {
+                // No work left, and no busy worker can produce more. Wake the other workers so
+                // they can return, too.
+                this->condVar.wakeAll();
+                return;
+            } else {
+                this->condVar.wait(guard);
+            }
+        }
+    }
+};
+} // namespace details
+
+/*!
+Like `sort()`, but uses up to `numThreads` threads (including the calling thread). The calling
+thread partitions the array and a fixed pool of worker threads sorts the resulting subranges.
+`isLess` must be safe to call concurrently. Small arrays are sorted on the calling thread.
+*/
+template <typename T, typename IsLess = details::DefaultLess<T>>
+PLY_NO_INLINE void parallelSort(ArrayView<T> view, u32 numThreads, const IsLess& isLess = {}) {
+    u32 depthLimit = details::introSortDepthLimit(view.numItems);
+    if (numThreads <= 1 || view.numItems < details::ParallelSortThreshold) {
+        details::introSort(view, depthLimit, isLess);
+        return;
+    }
+
+    details::ParallelSortPool<T, IsLess> pool{isLess};
+    pool.tasks.append({view, depthLimit});
+    Array<Thread> workers;
+    workers.resize(numThreads - 1);
+    for (Thread& worker : workers) {
+        worker.run([&pool] { pool.runWorker(); });
+    }
+    pool.runWorker();
+    for (Thread& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace ply
@@ -0,0 +1,175 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+#include <ply-runtime/algorithm/Sort.h>
+#include <ply-runtime/string/StringView.h>
+
+namespace ply {
+
+namespace details {
+// Arrays with fewer items than this are sorted using comparisons instead.
+static constexpr u32 RadixSortThreshold = 64;
+// Limits the recursion depth of MSD radix sort before it falls back to comparisons.
+static constexpr u32 StringRadixSortMaxDepth = 32;
+
+struct IdentityKey {
+    template <typename T>
+    PLY_INLINE const T& operator()(const T& item) const {
+        return item;
+    }
+};
+
+// LSD radix sort on 8-bit digits. Passes in which every key has the same digit are skipped, so
+// keys that span a small range only cost a few passes.
+template <typename Key, typename T, typename GetKey>
+PLY_NO_INLINE void radixSortIntegers(ArrayView<T> view, const GetKey& getKey) {
+    static_assert(std::is_integral<Key>::value && !std::is_same<Key, bool>::value,
+                  "radixSort requires an integer key other than bool");
+    using UKey = std::make_unsigned_t<Key>;
+    static constexpr u32 NumPasses = sizeof(Key);
+    if (view.numItems < RadixSortThreshold) {
+        stableSort(view, [&](const T& a, const T& b) { return getKey(a) < getKey(b); });
+        return;
+    }
+
+    // For signed keys, flip the sign bit so that negative keys sort first
+    UKey signFlip = std::is_signed<Key>::value ? (UKey) 1 << (NumPasses * 8 - 1) : 0;
+    u32 counts[NumPasses][256];
+    memset(counts, 0, sizeof(counts));
+    for (u32 i = 0; i < view.numItems; i++) {
+        UKey key = (UKey) getKey(view[i]) ^ signFlip;
+        for (u32 p = 0; p < NumPasses; p++) {
+            counts[p][(key >> (p * 8)) & 0xff]++;
+        }
+    }
+
+    Array<std::remove_const_t<T>> temp;
+    temp.resize(view.numItems);
+    T* src = view.items;
+    T* dst = temp.begin();
+    for (u32 p = 0; p < NumPasses; p++) {
+        u32* c = counts[p];
+        u32 firstDigit = (((UKey) getKey(src[0]) ^ signFlip) >> (p * 8)) & 0xff;
+        if (c[firstDigit] == view.numItems)
+            continue; // Every key has the same digit
+
+        u32 offsets[256];
+        u32 sum = 0;
+        for (u32 d = 0; d < 256; d++) {
+            offsets[d] = sum;
+            sum += c[d];
+        }
+        for (u32 i = 0; i < view.numItems; i++) {
+            u32 digit = (((UKey) getKey(src[i]) ^ signFlip) >> (p * 8)) & 0xff;
+            dst[offsets[digit]++] = std::move(src[i]);
+        }
+        std::swap(src, dst);
+    }
+    if (src != view.items) {
+        for (u32 i = 0; i < view.numItems; i++) {
+            view[i] = std::move(src[i]);
+        }
+    }
+}
+
+template <typename T, typename GetKey>
+PLY_INLINE bool isLessFromDepth(const T& a, const T& b, u32 depth, const GetKey& getKey) {
+    // Items being compared share their first `depth` bytes
+    StringView keyA = getKey(a);
+    StringView keyB = getKey(b);
+    return compare(keyA.subStr(depth), keyB.subStr(depth)) < 0;
+}
+
+// In-place MSD radix sort (American flag sort). Bucket 0 holds keys that end at the current depth;
+// bucket (b + 1) holds keys whose next byte is b.
+template <typename T, typename GetKey>
+PLY_NO_INLINE void radixSortStrings(ArrayView<T> view, u32 depth, u32 recursionDepth,
+                                    const GetKey& getKey) {
+    for (;;) {
+        if (view.numItems < RadixSortThreshold || recursionDepth >= StringRadixSortMaxDepth) {
+            sort(view, [&](const T& a, const T& b) { return isLessFromDepth(a, b, depth, getKey); });
+            return;
+        }
+
+        auto getDigit = [&](const T& item) -> u32 {
+            StringView key = getKey(item);
+            return depth < key.numBytes ? (u32)(u8) key.bytes[depth] + 1 : 0;
+        };
+        u32 counts[257];
+        memset(counts, 0, sizeof(counts));
+        for (u32 i = 0; i < view.numItems; i++) {
+            counts[getDigit(view[i])]++;
+        }
+        if (counts[getDigit(view[0])] == view.numItems) {
+            // Every key has the same byte at this depth, so there's nothing to partition.
+            if (counts[0] == view.numItems)
+                return; // Every key ends here
+            depth++;
+            continue;
+        }
+
+        // Permute items into their buckets in place
+        u32 next[257];
+        u32 ends[257];
+        u32 sum = 0;
+        for (u32 d = 0; d < 257; d++) {
+            next[d] = sum;
+            sum += counts[d];
+            ends[d] = sum;
+        }
+        for (u32 d = 0; d < 257; d++) {
+            while (next[d] < ends[d]) {
+                u32 digit = getDigit(view[next[d]]);
+                if (digit == d) {
+                    next[d]++;
+                } else {
+                    std::swap(view[next[d]], view[next[digit]++]);
+                }
+            }
+        }
+
+        // Sort each bucket by the next byte. Keys in bucket 0 are all equal.
+        u32 start = counts[0];
+        for (u32 d = 1; d < 257; d++) {
+            if (counts[d] > 1) {
+                radixSortStrings(view.subView(start, counts[d]), depth + 1, recursionDepth + 1,
+                                 getKey);
+            }
+            start += counts[d];
+        }
+        return;
+    }
+}
+
+template <typename T, typename GetKey>
+PLY_INLINE void radixSortDispatch(ArrayView<T> view, const GetKey& getKey, std::true_type) {
+    using Key = std::decay_t<decltype(getKey(std::declval<const T&>()))>;
+    radixSortIntegers<Key>(view, getKey);
+}
+
+template <typename T, typename GetKey>
+PLY_INLINE void radixSortDispatch(ArrayView<T> view, const GetKey& getKey, std::false_type) {
+    radixSortStrings(view, 0, 0, getKey);
+}
+} // namespace details
+
+/*!
+Sorts the items in `view` in ascending order of the key returned by `getKey`, without comparing
+items to each other. `getKey` must return either an integer, or something convertible to
+`StringView` -- preferably a `StringView` itself, since it's called several times per item.
+
+Integer keys use an LSD radix sort, which allocates a temporary copy of the array. `StringView` keys
+are sorted byte-wise in the same order as `compare()`, using an in-place MSD radix sort. Both are
+typically faster than `sort()` on large arrays; small arrays are sorted using comparisons instead.
+The sort is stable for integer keys, but not for `StringView` keys.
+*/
+template <typename T, typename GetKey = details::IdentityKey>
+PLY_INLINE void radixSort(ArrayView<T> view, const GetKey& getKey = {}) {
+    using Key = std::decay_t<decltype(getKey(std::declval<const T&>()))>;
+    details::radixSortDispatch(view, getKey, std::is_integral<Key>{});
+}
+
+} // namespace ply
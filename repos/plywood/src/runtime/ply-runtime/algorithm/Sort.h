@@ -5,66 +5,206 @@
 #pragma once
 #include <ply-runtime/Core.h>
 #include <ply-runtime/container/ArrayView.h>
+#include <ply-runtime/container/Array.h>
 
 namespace ply {
 
 namespace details {
+// Default comparator. Being a struct rather than a function, calls to it are easily inlined.
 template <typename T>
-PLY_INLINE bool defaultLess(const T& a, const T& b) {
-    return a < b;
+struct DefaultLess {
+    PLY_INLINE bool operator()(const T& a, const T& b) const {
+        return a < b;
+    }
+};
+
+// Subviews with this many items or fewer are finished using insertion sort.
+static constexpr u32 InsertionSortThreshold = 16;
+
+template <typename T, typename IsLess>
+PLY_NO_INLINE void insertionSort(ArrayView<T> view, const IsLess& isLess) {
+    for (u32 i = 1; i < view.numItems; i++) {
+        if (isLess(view[i], view[i - 1])) {
+            T item = std::move(view[i]);
+            u32 j = i;
+            do {
+                view[j] = std::move(view[j - 1]);
+                j--;
+            } while (j > 0 && isLess(item, view[j - 1]));
+            view[j] = std::move(item);
+        }
+    }
 }
-} // namespace details
 
-template <typename T, typename IsLess = bool(const T&, const T&)>
-PLY_NO_INLINE void sort(ArrayView<T> view, const IsLess& isLess = details::defaultLess<T>) {
-    if (view.numItems <= 1)
-        return;
+template <typename T, typename IsLess>
+PLY_INLINE void siftDown(ArrayView<T> view, u32 root, const IsLess& isLess) {
+    for (;;) {
+        u32 child = root * 2 + 1;
+        if (child >= view.numItems)
+            break;
+        if (child + 1 < view.numItems && isLess(view[child], view[child + 1])) {
+            child++;
+        }
+        if (!isLess(view[root], view[child]))
+            break;
+        std::swap(view[root], view[child]);
+        root = child;
+    }
+}
+
+template <typename T, typename IsLess>
+PLY_NO_INLINE void heapSort(ArrayView<T> view, const IsLess& isLess) {
+    for (u32 i = view.numItems / 2; i > 0; i--) {
+        siftDown(view, i - 1, isLess);
+    }
+    for (u32 i = view.numItems; i > 1; i--) {
+        std::swap(view[0], view[i - 1]);
+        siftDown(view.subView(0, i - 1), 0, isLess);
+    }
+}
+
+template <typename T, typename IsLess>
+PLY_INLINE u32 medianOf3(ArrayView<T> view, u32 a, u32 b, u32 c, const IsLess& isLess) {
+    if (isLess(view[a], view[b])) {
+        if (isLess(view[b], view[c]))
+            return b;
+        return isLess(view[a], view[c]) ? c : a;
+    } else {
+        if (isLess(view[a], view[c]))
+            return a;
+        return isLess(view[b], view[c]) ? c : b;
+    }
+}
+
+// Partitions the view around a pivot chosen using median-of-3, or Tukey's ninther for large
+// views. Returns the final index of the pivot. Items to the left of the pivot are <= pivot; items
+// to the right are >= pivot. Items equal to the pivot are distributed on both sides, which keeps
+// the partitions balanced when there are many duplicates.
+template <typename T, typename IsLess>
+PLY_INLINE u32 partition(ArrayView<T> view, const IsLess& isLess) {
+    u32 n = view.numItems;
+    PLY_ASSERT(n >= 3);
+    u32 mid = n / 2;
+    u32 pivot;
+    if (n > 128) {
+        u32 s = n / 8;
+        u32 a = medianOf3(view, 0, s, s * 2, isLess);
+        u32 b = medianOf3(view, mid - s, mid, mid + s, isLess);
+        u32 c = medianOf3(view, n - 1 - s * 2, n - 1 - s, n - 1, isLess);
+        pivot = medianOf3(view, a, b, c, isLess);
+    } else {
+        pivot = medianOf3(view, 0, mid, n - 1, isLess);
+    }
+
+    // Hoare partition with the pivot parked at view[0]:
+    std::swap(view[0], view[pivot]);
     u32 lo = 0;
-    u32 hi = view.numItems - 1;
-    u32 pivot = view.numItems / 2;
+    u32 hi = n;
     for (;;) {
-        while (lo < hi && isLess(view[lo], view[pivot])) {
+        do {
             lo++;
-        }
-        while (lo < hi && isLess(view[pivot], view[hi])) {
+        } while (lo < n && isLess(view[lo], view[0]));
+        do {
             hi--;
-        }
+        } while (isLess(view[0], view[hi]));
         if (lo >= hi)
             break;
-        // view[lo] is >= pivot
-        // All slots to left of lo are < pivot
-        // view[hi] <= pivot
-        // All slots to the right of hi are > pivot
-        PLY_ASSERT(!isLess(view[lo], view[pivot]));
-        PLY_ASSERT(!isLess(view[pivot], view[hi]));
-        PLY_ASSERT(lo < hi);
         std::swap(view[lo], view[hi]);
-        if (lo == pivot) {
-            pivot = hi;
-        } else if (hi == pivot) {
-            pivot = lo;
-        }
-        lo++;
     }
-    PLY_ASSERT((s32) hi >= 0);
-    // Now, everything to left of lo is <= pivot, and everything from hi onwards is >= pivot.
-    PLY_ASSERT(hi <= lo);
-    while (lo > 1) {
-        if (!isLess(view[lo - 1], view[pivot])) {
-            lo--;
+    std::swap(view[0], view[hi]);
+    return hi;
+}
+
+// Limits the recursion depth of introSort() before it falls back to heapSort().
+PLY_INLINE u32 introSortDepthLimit(u32 numItems) {
+    u32 depthLimit = 0;
+    for (u32 n = numItems; n > 1; n >>= 1) {
+        depthLimit += 2;
+    }
+    return depthLimit;
+}
+
+template <typename T, typename IsLess>
+PLY_NO_INLINE void introSort(ArrayView<T> view, u32 depthLimit, const IsLess& isLess) {
+    while (view.numItems > InsertionSortThreshold) {
+        if (depthLimit == 0) {
+            // Partitioning is going badly (probably adversarial input). Guarantee O(n log n).
+            heapSort(view, isLess);
+            return;
+        }
+        depthLimit--;
+        u32 pivot = partition(view, isLess);
+        // Recurse into the smaller side and loop on the larger side, so that the stack depth is
+        // O(log n).
+        if (pivot < view.numItems - pivot) {
+            introSort(view.subView(0, pivot), depthLimit, isLess);
+            view = view.subView(pivot + 1);
         } else {
-            sort(view.subView(0, lo), isLess);
-            break;
+            introSort(view.subView(pivot + 1), depthLimit, isLess);
+            view = view.subView(0, pivot);
         }
     }
-    while (hi + 1 < view.numItems) {
-        if (!isLess(view[pivot], view[hi])) {
-            hi++;
+    insertionSort(view, isLess);
+}
+
+// temp must have room for at least (view.numItems + 1) / 2 items.
+template <typename T, typename IsLess>
+PLY_NO_INLINE void mergeSort(ArrayView<T> view, T* temp, const IsLess& isLess) {
+    if (view.numItems <= InsertionSortThreshold) {
+        insertionSort(view, isLess);
+        return;
+    }
+    u32 mid = view.numItems / 2;
+    mergeSort(view.subView(0, mid), temp, isLess);
+    mergeSort(view.subView(mid), temp, isLess);
+    if (!isLess(view[mid], view[mid - 1]))
+        return; // Already in order
+
+    // Move the left half to temp, then merge it with the right half. When items compare equal,
+    // the one from the left half is taken first, which is what makes the sort stable.
+    for (u32 i = 0; i < mid; i++) {
+        temp[i] = std::move(view[i]);
+    }
+    u32 i = 0;
+    u32 j = mid;
+    u32 k = 0;
+    while (i < mid && j < view.numItems) {
+        if (isLess(view[j], temp[i])) {
+            view[k++] = std::move(view[j++]);
         } else {
-            sort(view.subView(hi), isLess);
-            break;
+            view[k++] = std::move(temp[i++]);
         }
     }
+    while (i < mid) {
+        view[k++] = std::move(temp[i++]);
+    }
+}
+} // namespace details
+
+/*!
+Sorts the items in `view` in ascending order according to `isLess`. Uses introsort: quicksort with
+median-of-3 (or ninther) pivots, switching to insertion sort for small subranges and to heapsort if
+the recursion gets too deep. The worst case is O(n log n). The sort is not stable; use
+`stableSort()` if the relative order of equal items must be preserved.
+*/
+template <typename T, typename IsLess = details::DefaultLess<T>>
+PLY_INLINE void sort(ArrayView<T> view, const IsLess& isLess = {}) {
+    details::introSort(view, details::introSortDepthLimit(view.numItems), isLess);
+}
+
+/*!
+Like `sort()`, but items that compare equal keep their relative order. Uses merge sort, which
+allocates temporary storage for half of the items. `T` must be default-constructible.
+*/
+template <typename T, typename IsLess = details::DefaultLess<T>>
+PLY_NO_INLINE void stableSort(ArrayView<T> view, const IsLess& isLess = {}) {
+    if (view.numItems <= details::InsertionSortThreshold) {
+        details::insertionSort(view, isLess);
+        return;
+    }
+    Array<std::remove_const_t<T>> temp;
+    temp.resize((view.numItems + 1) / 2);
+    details::mergeSort(view, temp.begin(), isLess);
 }
 
 } // namespace ply
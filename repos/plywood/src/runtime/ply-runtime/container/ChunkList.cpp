@@ -30,7 +30,8 @@ PLY_NO_INLINE void ChunkListNode::addChunkToTail(Reference<ChunkListNode>& chunk
     PLY_ASSERT(!chunkRef->next);
     PLY_ASSERT(chunkRef->offsetIntoNextChunk == 0);
     PLY_ASSERT(chunkRef->refCount > 0);
-    if (chunkRef->refCount == 1 && chunkRef->numBytes <= numBytes) {
+    if (chunkRef->refCount == 1 && numBytes <= chunkRef->numBytes) {
+        // Recycle the chunk since nothing else refers to it and it's big enough
         chunkRef->fileOffset += chunkRef->writePos;
         chunkRef->writePos = 0;
     } else {
@@ -59,7 +60,7 @@ PLY_NO_INLINE void ChunkCursor::iterateOverViews(LambdaView<void(ConstBufferView
     } else {
         PLY_ASSERT(this->chunk->viewUsedBytes().contains(this->curByte));
         callback(
-            ConstBufferView::fromRange(this->curByte, this->chunk->bytes + this->chunk->numBytes));
+            ConstBufferView::fromRange(this->curByte, this->chunk->bytes + this->chunk->writePos));
         const ChunkListNode* chunk = this->chunk->next;
         while (chunk != end.chunk) {
             callback(chunk->viewUsedBytes());
@@ -74,6 +75,17 @@ PLY_NO_INLINE void ChunkCursor::iterateOverViews(LambdaView<void(ConstBufferView
 }
 
 PLY_NO_INLINE Buffer ChunkCursor::toBuffer(ChunkCursor&& start, const ChunkCursor& end) {
+    if (!start.chunk) {
+        // Cursors returned by view streams have no chunk; they're raw pointers into the view:
+        PLY_ASSERT(!end.chunk);
+        PLY_ASSERT(start.curByte <= end.curByte);
+        u32 numBytes = safeDemote<u32>(end.curByte - start.curByte);
+        Buffer result = Buffer::allocate(numBytes);
+        if (numBytes > 0) {
+            memcpy(result.bytes, start.curByte, numBytes);
+        }
+        return result;
+    }
     PLY_ASSERT(start.curByte);
 
     if (!start.chunk->next && start.chunk->refCount == 1 && start.chunk->bytes == start.curByte) {
@@ -114,6 +126,37 @@ PLY_NO_INLINE void ChunkCursor::writeToStream(OutStream* outs, const ChunkCursor
         end);
 }
 
+//-------------------------------------------------
+// ChunkString
+//-------------------------------------------------
+PLY_NO_INLINE u64 ChunkString::numBytes() const {
+    u64 numBytes = 0;
+    this->iterateOverViews([&](ConstBufferView view) { //
+        numBytes += view.numBytes;
+    });
+    return numBytes;
+}
+
+PLY_NO_INLINE bool ChunkString::writeToStream(OutStream* outs) const {
+    // Pass the chunks to the OutStream in batches so they can be sent with as few writes as
+    // possible:
+    static const u32 BatchSize = 16;
+    ConstBufferView batch[BatchSize];
+    u32 numViews = 0;
+    bool ok = true;
+    this->iterateOverViews([&](ConstBufferView view) {
+        if (numViews == BatchSize) {
+            ok = ok && outs->writeVectored({batch, numViews});
+            numViews = 0;
+        }
+        batch[numViews++] = view;
+    });
+    if (numViews > 0) {
+        ok = ok && outs->writeVectored({batch, numViews});
+    }
+    return ok;
+}
+
 PLY_NO_INLINE void ChunkCursor::advanceToNextChunk() {
     PLY_ASSERT(this->curByte >= this->chunk->bytes + this->chunk->writePos);
     for (;;) {
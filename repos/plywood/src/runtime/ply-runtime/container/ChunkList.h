@@ -120,6 +120,37 @@ struct ChunkCursor {
     PLY_DLL_ENTRY void writeToStream(OutStream* outs, const ChunkCursor& end = {}) const;
 };
 
+//-----------------------------------------------------------------
+// ChunkString
+// A string stored as a list of chunks, such as the one returned by MemOutStream::moveToChunks().
+// It can be measured, iterated over and written to an OutStream without ever being copied into a
+// single contiguous block of memory.
+//-----------------------------------------------------------------
+struct ChunkString {
+    ChunkCursor head; // null if the ChunkString is empty
+
+    PLY_INLINE ChunkString() = default;
+    PLY_INLINE ChunkString(ChunkCursor&& head) : head{std::move(head)} {
+    }
+    PLY_INLINE explicit operator bool() const {
+        return this->head.curByte != nullptr;
+    }
+    PLY_DLL_ENTRY u64 numBytes() const;
+    PLY_INLINE void iterateOverViews(LambdaView<void(ConstBufferView)> callback) const {
+        if (this->head.curByte) {
+            this->head.iterateOverViews(callback, {});
+        }
+    }
+    // Writes every chunk to outs using OutStream::writeVectored(), so that when outs writes to an
+    // OutPipe, large strings reach the pipe in a few vectored writes instead of being copied
+    // through the OutStream's internal buffer.
+    PLY_DLL_ENTRY bool writeToStream(OutStream* outs) const;
+    // These functions flatten the chunks into a single block of memory, and reset the ChunkString
+    // to empty. As with Buffer::fromChunks, no data is copied when there is only one chunk.
+    PLY_INLINE Buffer moveToBuffer();
+    PLY_INLINE String moveToString();
+};
+
 PLY_INLINE Buffer Buffer::fromChunks(ChunkCursor&& start) {
     return ChunkCursor::toBuffer(std::move(start));
 }
@@ -136,4 +167,15 @@ PLY_INLINE String String::fromChunks(ChunkCursor&& start, const ChunkCursor& end
     return String::moveFromBuffer(ChunkCursor::toBuffer(std::move(start), end));
 }
 
+PLY_INLINE Buffer ChunkString::moveToBuffer() {
+    ChunkCursor head = std::move(this->head);
+    if (!head.curByte)
+        return {};
+    return ChunkCursor::toBuffer(std::move(head));
+}
+
+PLY_INLINE String ChunkString::moveToString() {
+    return String::moveFromBuffer(this->moveToBuffer());
+}
+
 } // namespace ply
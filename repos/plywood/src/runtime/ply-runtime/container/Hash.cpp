@@ -4,6 +4,10 @@
 ------------------------------------*/
 #include <ply-runtime/Precomp.h>
 #include <ply-runtime/container/Hash.h>
+#include <string.h>
+#if PLY_COMPILER_MSVC
+#include <intrin.h>
+#endif
 
 namespace ply {
 
@@ -34,8 +38,102 @@ PLY_NO_INLINE void Hasher::appendBuffer(const void* data, u32 len) {
             data = (const void*) PLY_PTR_OFFSET(data, 1);
             len--;
         }
-        append(len);
+        append(v);
     }
 }
 
+//------------------------------------------------------------------
+// Bulk hash
+// Adapted from https://github.com/wangyi-fudan/wyhash (public domain)
+//
+// There's no SSE4.2 or AVX2 variant. A hash built on the SSE4.2 CRC32 instruction would need a slow
+// software fallback to produce the same values on other CPUs, and AVX2 has no 64x64->128-bit
+// multiply, which is what each round of this hash is built on.
+//------------------------------------------------------------------
+static const u64 WySecret[4] = {0xa0761d6478bd642f, 0xe7037ed1a0b428db, 0x8ebc6af09c88c6e3,
+                                0x589965cc75374cc3};
+
+PLY_INLINE void wyMum(u64* a, u64* b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = *a;
+    r *= *b;
+    *a = (u64) r;
+    *b = (u64)(r >> 64);
+#elif PLY_COMPILER_MSVC && PLY_CPU_X64
+    *a = _umul128(*a, *b, b);
+#else
+    u64 ha = *a >> 32, hb = *b >> 32, la = (u32) *a, lb = (u32) *b;
+    u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+    u64 c = t < rl;
+    u64 lo = t + (rm1 << 32);
+    c += lo < t;
+    u64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+PLY_INLINE u64 wyMix(u64 a, u64 b) {
+    wyMum(&a, &b);
+    return a ^ b;
+}
+
+// Unaligned little-endian reads
+PLY_INLINE u64 wyRead8(const u8* p) {
+    u64 v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+PLY_INLINE u64 wyRead4(const u8* p) {
+    u32 v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+PLY_NO_INLINE u64 Hasher::hashBuffer64(const void* data, u32 len, u64 seed) {
+    const u8* p = (const u8*) data;
+    seed ^= wyMix(seed ^ WySecret[0], WySecret[1]);
+    u64 a;
+    u64 b;
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (wyRead4(p) << 32) | wyRead4(p + ((len >> 3) << 2));
+            b = (wyRead4(p + len - 4) << 32) | wyRead4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = ((u64) p[0] << 16) | ((u64) p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        u32 i = len;
+        if (i > 48) {
+            // Three independent lanes keep the multipliers busy
+            u64 see1 = seed;
+            u64 see2 = seed;
+            do {
+                seed = wyMix(wyRead8(p) ^ WySecret[1], wyRead8(p + 8) ^ seed);
+                see1 = wyMix(wyRead8(p + 16) ^ WySecret[2], wyRead8(p + 24) ^ see1);
+                see2 = wyMix(wyRead8(p + 32) ^ WySecret[3], wyRead8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = wyMix(wyRead8(p) ^ WySecret[1], wyRead8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wyRead8(p + i - 16);
+        b = wyRead8(p + i - 8);
+    }
+    a ^= WySecret[1];
+    b ^= seed;
+    wyMum(&a, &b);
+    return wyMix(a ^ WySecret[0] ^ len, b ^ WySecret[1]);
+}
+
 } // namespace ply
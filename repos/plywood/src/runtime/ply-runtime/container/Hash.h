@@ -49,6 +49,17 @@ public:
     PLY_DLL_ENTRY void appendBuffer(const void* data, u32 len);
 
     PLY_DLL_ENTRY u32 result() const;
+
+    // Hashes an entire buffer at once. Much faster than appendBuffer(), especially for long
+    // buffers, since it consumes 16-48 bytes per step using 64x64->128-bit multiplies (the same
+    // construction as wyhash). HashMaps use it by default for keys that have `bytes` and `numBytes`
+    // members, such as StringView.
+    static PLY_DLL_ENTRY u64 hashBuffer64(const void* data, u32 len, u64 seed = 0);
+
+    static PLY_INLINE u32 hashBuffer(const void* data, u32 len, u64 seed = 0) {
+        u64 h = hashBuffer64(data, len, seed);
+        return u32(h ^ (h >> 32));
+    }
 };
 
 } // namespace ply
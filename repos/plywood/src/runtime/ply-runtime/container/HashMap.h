@@ -54,6 +54,8 @@ struct HashMap {
 
     PLY_SFINAE_EXPR_1(HasConstruct, &T0::construct);
     PLY_SFINAE_EXPR_1(HasHash, &T0::hash);
+    PLY_SFINAE_EXPR_1(HasBytes, Hasher::hashBuffer(std::declval<const T0&>().bytes,
+                                                   std::declval<const T0&>().numBytes));
     PLY_SFINAE_EXPR_1(HasComparand, &T0::comparand);
     PLY_SFINAE_EXPR_1(HasEqual, &T0::equal);
     PLY_SFINAE_EXPR_1(HasComparandWithContext, T0::comparand(std::declval<typename T0::Item>(),
@@ -123,9 +125,16 @@ struct HashMap {
             hasher.appendPtr(*(const Key*) key);
             return hasher.result();
         }
-        template <
-            typename U = Traits,
-            std::enable_if_t<!HasHash<U> && !std::is_pointer<typename U::Key>::value, int> = 0>
+        template <typename U = Traits,
+                  std::enable_if_t<!HasHash<U> && HasBytes<typename U::Key>, int> = 0>
+        static PLY_NO_INLINE u32 hash(const void* key) {
+            // Contiguous keys such as StringView are hashed in bulk
+            return Hasher::hashBuffer(((const Key*) key)->bytes, ((const Key*) key)->numBytes);
+        }
+        template <typename U = Traits,
+                  std::enable_if_t<!HasHash<U> && !std::is_pointer<typename U::Key>::value &&
+                                       !HasBytes<typename U::Key>,
+                                   int> = 0>
         static PLY_NO_INLINE u32 hash(const void* key) {
             Hasher hasher;
             ((const Key*) key)->appendTo(hasher);
@@ -398,16 +407,17 @@ public:
         }
         PLY_INLINE void erase() {
             u8* unusedLink = nullptr;
-            reinterpret_cast<const details::HashMap&>(m_map).erase(m_findInfo, Callbacks::instance(),
-                                                                   unusedLink);
+            reinterpret_cast<details::HashMap*>(m_map)->erase(
+                (details::HashMap::FindInfo*) &m_findInfo, Callbacks::instance(), unusedLink);
             m_findResult = details::HashMap::FindResult::NotFound;
         }
         PLY_INLINE void eraseAndAdvance(const Context& context = {}) {
             FindInfo infoToErase = m_findInfo;
-            m_findResult = reinterpret_cast<const details::HashMap&>(m_map).findNext(
+            m_findResult = reinterpret_cast<const details::HashMap*>(m_map)->findNext(
                 (details::HashMap::FindInfo*) &m_findInfo, Callbacks::instance(), &context);
-            reinterpret_cast<const details::HashMap&>(m_map).erase(
-                infoToErase, Callbacks::instance(), m_findInfo.prevLink);
+            reinterpret_cast<details::HashMap*>(m_map)->erase(
+                (details::HashMap::FindInfo*) &infoToErase, Callbacks::instance(),
+                m_findInfo.prevLink);
         }
     };
 
@@ -14,7 +14,7 @@ namespace details {
 struct WalkImpl : FileSystem::Walk::Impl {
     struct StackItem {
         String path;
-        Array<String> dirNames;
+        Array<HybridString> dirNames;
         u32 dirIndex;
     };
 
@@ -109,6 +109,12 @@ PLY_NO_INLINE Owned<InStream> FileSystem::openStreamForRead(StringView path) {
     return new InStream{std::move(inPipe)};
 }
 
+PLY_NO_INLINE Owned<InStream> FileSystem::openMappedStreamForRead(StringView path) {
+    if (!this->funcs->openMappedStreamForRead)
+        return this->openStreamForRead(path);
+    return this->funcs->openMappedStreamForRead(this, path);
+}
+
 PLY_NO_INLINE Owned<OutStream> FileSystem::openStreamForWrite(StringView path) {
     Owned<OutPipe> outPipe = this->funcs->openPipeForWrite(this, path);
     if (!outPipe)
@@ -118,7 +124,7 @@ PLY_NO_INLINE Owned<OutStream> FileSystem::openStreamForWrite(StringView path) {
 
 PLY_NO_INLINE Owned<StringReader> FileSystem::openTextForRead(StringView path,
                                                               const TextFormat& textFormat) {
-    Owned<InStream> ins = this->openStreamForRead(path);
+    Owned<InStream> ins = this->openMappedStreamForRead(path);
     if (!ins)
         return nullptr;
     return textFormat.createImporter(std::move(ins));
@@ -126,7 +132,7 @@ PLY_NO_INLINE Owned<StringReader> FileSystem::openTextForRead(StringView path,
 
 PLY_DLL_ENTRY Tuple<Owned<StringReader>, TextFormat>
 FileSystem::openTextForReadAutodetect(StringView path) {
-    Owned<InStream> ins = this->openStreamForRead(path);
+    Owned<InStream> ins = this->openMappedStreamForRead(path);
     if (!ins)
         return {nullptr, TextFormat{}};
     TextFormat textFormat = TextFormat::autodetect(ins);
@@ -220,4 +226,15 @@ PLY_NO_INLINE FSResult FileSystem::makeDirsAndSaveTextIfDifferent(StringView pat
     return this->makeDirsAndSaveBinaryIfDifferent(path, rawContents);
 }
 
+PLY_NO_INLINE FSResult FileSystem::makeDirsAndSaveTextIfDifferent(StringView path,
+                                                                  const ChunkString& strContents,
+                                                                  const TextFormat& textFormat) {
+    MemOutStream memOut;
+    Owned<StringWriter> sw = textFormat.createExporter(borrow(&memOut));
+    strContents.writeToStream(sw);
+    sw.clear();
+    Buffer rawContents = memOut.moveToBuffer();
+    return this->makeDirsAndSaveBinaryIfDifferent(path, rawContents);
+}
+
 } // namespace ply
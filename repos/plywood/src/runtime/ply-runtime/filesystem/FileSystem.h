@@ -49,7 +49,7 @@ struct FileStatus {
 };
 
 struct DirectoryEntry {
-    String name; // FIXME: Make this a HybridString
+    HybridString name; // Short names are stored inline
     bool isDir = false;
     u64 fileSize = 0;            // Size of the file in bytes
     double creationTime = 0;     // The file's POSIX creation time
@@ -102,7 +102,7 @@ enum class ExistsResult {
 
 struct WalkTriple {
     struct FileInfo {
-        String name;
+        HybridString name;
         u64 fileSize = 0;            // Size of the file in bytes
         double creationTime = 0;     // The file's POSIX creation time
         double accessTime = 0;       // The file's POSIX access time
@@ -110,7 +110,7 @@ struct WalkTriple {
     };
 
     String dirPath;
-    Array<String> dirNames;
+    Array<HybridString> dirNames;
     Array<FileInfo> files;
 };
 
@@ -197,6 +197,7 @@ struct FileSystem {
         ExistsResult (*exists)(FileSystem* fs, StringView path) = nullptr;
         Owned<InPipe> (*openPipeForRead)(FileSystem* fs, StringView path) = nullptr;
         Owned<OutPipe> (*openPipeForWrite)(FileSystem* fs, StringView path) = nullptr;
+        Owned<InStream> (*openMappedStreamForRead)(FileSystem* fs, StringView path) = nullptr;
         FSResult (*moveFile)(FileSystem* fs, StringView srcPath, StringView dstPath) = nullptr;
         FSResult (*deleteFile)(FileSystem* fs, StringView path) = nullptr;
         FSResult (*removeDirTree)(FileSystem* fs, StringView dirPath) = nullptr;
@@ -336,7 +337,7 @@ struct FileSystem {
 
         struct WalkTriple {
             struct FileInfo {
-                String name;
+                HybridString name;
                 u64 fileSize;           // Only valid if WithSizes was specified
                 double creationTime;    // Only valid if WithTimes was specified
                 double accessTime;
@@ -344,7 +345,7 @@ struct FileSystem {
             };
 
             String dirPath;
-            Array<String> dirNames;
+            Array<HybridString> dirNames;
             Array<FileInfo> files;
         };
 
@@ -511,6 +512,22 @@ struct FileSystem {
     */
     PLY_DLL_ENTRY Owned<InStream> openStreamForRead(StringView path);
 
+    /*!
+    Returns an `InStream` that exposes the raw contents of the specified file as a single contiguous
+    block of memory, or `nullptr` if the file could not be opened. The file is memory-mapped
+    read-only, so no data is copied into an intermediate buffer; the returned `InStream` is a view
+    (`isView()` returns `true`), and the entire file is available at `curByte` right away. The
+    mapping is released when the `InStream` is destroyed.
+
+    If the file can't be memory-mapped (for example, if it's a pipe or a device), or if the
+    `FileSystem` doesn't support memory mapping, this function falls back to `openStreamForRead()`.
+    Callers that depend on contiguous access should check `isView()`.
+
+    This function updates the internal result code. Expected result codes are `OK`, `NotFound`,
+    `AccessDenied` or `Locked`.
+    */
+    PLY_DLL_ENTRY Owned<InStream> openMappedStreamForRead(StringView path);
+
     /*!
     Returns an `OutStream` that writes raw data to the specified file, or `nullptr` if the file
     could not be opened.
@@ -532,7 +549,7 @@ struct FileSystem {
 
     The `openTextForRead()` function is equivalent to the following:
 
-        Owned<InStream> ins = fs->openStreamForRead(path);
+        Owned<InStream> ins = fs->openMappedStreamForRead(path);
         if (!ins)
             return nullptr;
         return textFormat.createImporter(std::move(ins));
@@ -552,7 +569,7 @@ struct FileSystem {
 
     The `openTextForReadAutodetect()` function is equivalent to the following:
 
-        Owned<InStream> ins = fs->openStreamForRead(path);
+        Owned<InStream> ins = fs->openMappedStreamForRead(path);
         if (!ins)
             return {nullptr, TextFormat{}};
         TextFormat textFormat = TextFormat::autodetect(ins);
@@ -640,6 +657,15 @@ struct FileSystem {
     */
     PLY_DLL_ENTRY FSResult makeDirsAndSaveTextIfDifferent(StringView path, StringView strContents,
                                                           const TextFormat& textFormat);
+
+    /*!
+    Same as above, except that the text is given as a `ChunkString`, such as the one returned by
+    `StringWriter::moveToChunks()`. The chunks are converted directly, without first being copied
+    into a single contiguous `String`.
+    */
+    PLY_DLL_ENTRY FSResult makeDirsAndSaveTextIfDifferent(StringView path,
+                                                          const ChunkString& strContents,
+                                                          const TextFormat& textFormat);
 };
 
 } // namespace ply
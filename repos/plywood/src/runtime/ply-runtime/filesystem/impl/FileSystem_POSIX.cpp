@@ -8,6 +8,7 @@
 
 #include <ply-runtime/filesystem/impl/FileSystem_POSIX.h>
 #include <ply-runtime/io/impl/Pipe_FD.h>
+#include <ply-runtime/memory/MemPage.h>
 #include <sys/stat.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -27,7 +28,7 @@ PLY_NO_INLINE void FileSystem_POSIX::DirImpl::destructImpl(ply::Directory::Impl*
 
 PLY_NO_INLINE FSResult FileSystem_POSIX::DirImpl::begin(StringView path) {
     this->dirPath = path.withoutNullTerminator();
-    this->dir = opendir(path.withNullTerminator().bytes);
+    this->dir = opendir(path.withNullTerminator().view().bytes);
     if (!this->dir) {
         this->entry = {};
         switch (errno) {
@@ -58,7 +59,7 @@ PLY_NO_INLINE FSResult FileSystem_POSIX::DirImpl::nextImpl(ply::Directory::Impl*
                 return FileSystem::setLastResult(FSResult::Unknown);
             }
         } else {
-            dirImpl->entry.name = rde->d_name;
+            dirImpl->entry.name = HybridString::copy(rde->d_name);
 
             // d_type is not POSIX, but it exists on OSX and Linux.
             if (rde->d_type == DT_REG) {
@@ -75,7 +76,7 @@ PLY_NO_INLINE FSResult FileSystem_POSIX::DirImpl::nextImpl(ply::Directory::Impl*
                 // Get additional information requested by flags
                 String joinedPath = PosixPath::join(dirImpl->dirPath, dirImpl->entry.name);
                 struct stat buf;
-                int rc = stat(joinedPath.withNullTerminator().bytes, &buf);
+                int rc = stat(joinedPath.withNullTerminator().view().bytes, &buf);
                 if (rc != 0) {
                     switch (errno) {
                         case ENOENT: {
@@ -113,7 +114,7 @@ PLY_NO_INLINE Directory FileSystem_POSIX::listDir(FileSystem*, StringView path,
 }
 
 PLY_NO_INLINE FSResult FileSystem_POSIX::makeDir(FileSystem*, StringView path) {
-    int rc = mkdir(path.withNullTerminator().bytes, mode_t(0755));
+    int rc = mkdir(path.withNullTerminator().view().bytes, mode_t(0755));
     if (rc == 0) {
         return FileSystem::setLastResult(FSResult::OK);
     } else {
@@ -131,7 +132,7 @@ PLY_NO_INLINE FSResult FileSystem_POSIX::makeDir(FileSystem*, StringView path) {
 }
 
 PLY_NO_INLINE FSResult FileSystem_POSIX::setWorkingDirectory(FileSystem*, StringView path) {
-    int rc = chdir(path.withNullTerminator().bytes);
+    int rc = chdir(path.withNullTerminator().view().bytes);
     if (rc == 0) {
         return FileSystem::setLastResult(FSResult::OK);
     } else {
@@ -176,7 +177,7 @@ PLY_NO_INLINE String FileSystem_POSIX::getWorkingDirectory(FileSystem*) {
 
 PLY_NO_INLINE ExistsResult FileSystem_POSIX::exists(FileSystem*, StringView path) {
     struct stat buf;
-    int rc = stat(path.withNullTerminator().bytes, &buf);
+    int rc = stat(path.withNullTerminator().view().bytes, &buf);
     if (rc == 0)
         return (buf.st_mode & S_IFMT) == S_IFDIR ? ExistsResult::Directory : ExistsResult::File;
     if (errno != ENOENT) {
@@ -186,7 +187,7 @@ PLY_NO_INLINE ExistsResult FileSystem_POSIX::exists(FileSystem*, StringView path
 }
 
 PLY_NO_INLINE int FileSystem_POSIX::openFDForRead(StringView path) {
-    int fd = open(path.withNullTerminator().bytes, O_RDONLY | O_CLOEXEC);
+    int fd = open(path.withNullTerminator().view().bytes, O_RDONLY | O_CLOEXEC);
     if (fd != -1) {
         FileSystem::setLastResult(FSResult::OK);
     } else {
@@ -216,7 +217,7 @@ PLY_NO_INLINE Owned<InPipe> FileSystem_POSIX::openPipeForRead(FileSystem*, Strin
 }
 
 PLY_NO_INLINE int FileSystem_POSIX::openFDForWrite(StringView path) {
-    int fd = open(path.withNullTerminator().bytes, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+    int fd = open(path.withNullTerminator().view().bytes, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
                   mode_t(0644));
     if (fd != -1) {
         FileSystem::setLastResult(FSResult::OK);
@@ -246,9 +247,34 @@ PLY_NO_INLINE Owned<OutPipe> FileSystem_POSIX::openPipeForWrite(FileSystem*, Str
     return new OutPipe_FD{fd};
 }
 
+PLY_NO_INLINE Owned<InStream> FileSystem_POSIX::openMappedStreamForRead(FileSystem*,
+                                                                       StringView path) {
+    int fd = openFDForRead(path);
+    if (fd == -1)
+        return nullptr;
+
+    // Only regular files can be mapped. Files >= 4GB can't be exposed as a single view.
+    struct stat buf;
+    int rc = fstat(fd, &buf);
+    if (rc == 0 && S_ISREG(buf.st_mode) && u64(buf.st_size) <= Limits<u32>::Max) {
+        void* mapped = nullptr;
+        if (buf.st_size == 0 || MemPage::mapFileForRead(mapped, fd, (ureg) buf.st_size)) {
+            // The mapping remains valid after the file descriptor is closed:
+            rc = ::close(fd);
+            PLY_ASSERT(rc == 0);
+            PLY_UNUSED(rc);
+            return InStream::adoptMappedView({mapped, (u32) buf.st_size});
+        }
+    }
+
+    // Fall back to reading through the file descriptor:
+    return new InStream{Owned<InPipe>{new InPipe_FD{fd}}};
+}
+
 PLY_NO_INLINE FSResult FileSystem_POSIX::moveFile(FileSystem*, StringView srcPath,
                                                   StringView dstPath) {
-    int rc = rename(srcPath.withNullTerminator().bytes, dstPath.withNullTerminator().bytes);
+    int rc = rename(srcPath.withNullTerminator().view().bytes,
+                    dstPath.withNullTerminator().view().bytes);
     if (rc != 0) {
         PLY_ASSERT(PLY_FSPOSIX_ALLOW_UNKNOWN_ERRORS);
         return FileSystem::setLastResult(FSResult::Unknown);
@@ -257,7 +283,7 @@ PLY_NO_INLINE FSResult FileSystem_POSIX::moveFile(FileSystem*, StringView srcPat
 }
 
 PLY_NO_INLINE FSResult FileSystem_POSIX::deleteFile(FileSystem*, StringView path) {
-    int rc = unlink(path.withNullTerminator().bytes);
+    int rc = unlink(path.withNullTerminator().view().bytes);
     if (rc != 0) {
         PLY_ASSERT(PLY_FSPOSIX_ALLOW_UNKNOWN_ERRORS);
         return FileSystem::setLastResult(FSResult::Unknown);
@@ -274,14 +300,14 @@ PLY_NO_INLINE FSResult FileSystem_POSIX::removeDirTree(FileSystem* fs, StringVie
                 return fsResult;
             }
         } else {
-            int rc = unlink(joined.withNullTerminator().bytes);
+            int rc = unlink(joined.withNullTerminator().view().bytes);
             if (rc != 0) {
                 PLY_ASSERT(PLY_FSPOSIX_ALLOW_UNKNOWN_ERRORS);
                 return FileSystem::setLastResult(FSResult::Unknown);
             }
         }
     }
-    int rc = rmdir(dirPath.withNullTerminator().bytes);
+    int rc = rmdir(dirPath.withNullTerminator().view().bytes);
     if (rc != 0) {
         PLY_ASSERT(PLY_FSPOSIX_ALLOW_UNKNOWN_ERRORS);
         return FileSystem::setLastResult(FSResult::Unknown);
@@ -292,7 +318,7 @@ PLY_NO_INLINE FSResult FileSystem_POSIX::removeDirTree(FileSystem* fs, StringVie
 PLY_NO_INLINE FileStatus FileSystem_POSIX::getFileStatus(FileSystem*, StringView path) {
     FileStatus status;
     struct stat buf;
-    int rc = stat(path.withNullTerminator().bytes, &buf);
+    int rc = stat(path.withNullTerminator().view().bytes, &buf);
     if (rc != 0) {
         switch (errno) {
             case ENOENT: {
@@ -324,6 +350,7 @@ FileSystem::Funcs FileSystemFuncs_POSIX = {
     FileSystem_POSIX::exists,
     FileSystem_POSIX::openPipeForRead,
     FileSystem_POSIX::openPipeForWrite,
+    FileSystem_POSIX::openMappedStreamForRead,
     FileSystem_POSIX::moveFile,
     FileSystem_POSIX::deleteFile,
     FileSystem_POSIX::removeDirTree,
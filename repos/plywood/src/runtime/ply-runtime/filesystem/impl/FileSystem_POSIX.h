@@ -37,6 +37,7 @@ struct FileSystem_POSIX : FileSystem {
     static ExistsResult exists(FileSystem*, StringView path);
     static Owned<InPipe> openPipeForRead(FileSystem*, StringView path);
     static Owned<OutPipe> openPipeForWrite(FileSystem*, StringView path);
+    static Owned<InStream> openMappedStreamForRead(FileSystem*, StringView path);
     static FSResult moveFile(FileSystem*, StringView srcPath, StringView dstPath);
     static FSResult deleteFile(FileSystem*, StringView path);
     static FSResult removeDirTree(FileSystem*, StringView dirPath);
@@ -9,6 +9,7 @@
 #include <ply-runtime/filesystem/impl/FileSystem_Win32.h>
 #include <ply-runtime/io/impl/Pipe_Win32.h>
 #include <ply-runtime/io/text/TextConverter.h>
+#include <ply-runtime/memory/MemPage.h>
 #include <shellapi.h>
 
 #define PLY_FSWIN32_ALLOW_UKNOWN_ERRORS 0
@@ -249,6 +250,31 @@ PLY_NO_INLINE Owned<InPipe> FileSystem_Win32::openPipeForRead(FileSystem*, Strin
     return new InPipe_Win32{handle};
 }
 
+PLY_NO_INLINE Owned<InStream> FileSystem_Win32::openMappedStreamForRead(FileSystem*,
+                                                                       StringView path) {
+    HANDLE handle = openHandleForRead(path);
+    if (handle == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    // Only regular files can be mapped. Files >= 4GB can't be exposed as a single view.
+    LARGE_INTEGER fileSize;
+    BOOL rc = GetFileSizeEx(handle, &fileSize);
+    if (rc && GetFileType(handle) == FILE_TYPE_DISK && u64(fileSize.QuadPart) <= Limits<u32>::Max) {
+        void* mapped = nullptr;
+        if (fileSize.QuadPart == 0 ||
+            MemPage::mapFileForRead(mapped, handle, (ureg) fileSize.QuadPart)) {
+            // The mapping remains valid after the file handle is closed:
+            rc = CloseHandle(handle);
+            PLY_ASSERT(rc != 0);
+            PLY_UNUSED(rc);
+            return InStream::adoptMappedView({mapped, (u32) fileSize.QuadPart});
+        }
+    }
+
+    // Fall back to reading through the file handle:
+    return new InStream{Owned<InPipe>{new InPipe_Win32{handle}}};
+}
+
 PLY_NO_INLINE HANDLE FileSystem_Win32::openHandleForWrite(StringView path) {
     // FIXME: Needs graceful handling of ERROR_SHARING_VIOLATION
     // Should this use FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE?
@@ -384,6 +410,7 @@ FileSystem::Funcs FileSystemFuncs_Win32 = {
     FileSystem_Win32::exists,
     FileSystem_Win32::openPipeForRead,
     FileSystem_Win32::openPipeForWrite,
+    FileSystem_Win32::openMappedStreamForRead,
     FileSystem_Win32::moveFile,
     FileSystem_Win32::deleteFile,
     FileSystem_Win32::removeDirTree,
@@ -42,6 +42,7 @@ struct FileSystem_Win32 : FileSystem {
     static ExistsResult exists(FileSystem*, StringView path);
     static Owned<InPipe> openPipeForRead(FileSystem*, StringView path);
     static Owned<OutPipe> openPipeForWrite(FileSystem*, StringView path);
+    static Owned<InStream> openMappedStreamForRead(FileSystem*, StringView path);
     static FSResult moveFile(FileSystem*, StringView srcPath, StringView dstPath);
     static FSResult deleteFile(FileSystem*, StringView path);
     static FSResult removeDirTree(FileSystem*, StringView dirPath);
@@ -0,0 +1,38 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+
+// clang-format off
+
+// Choose default implementation if not already configured by ply_userconfig.h:
+#if !defined(PLY_IMPL_ASYNCIO_PATH)
+    #if PLY_KERNEL_LINUX
+        #define PLY_IMPL_ASYNCIO_PATH "impl/AsyncIO_IOUring.h"
+        #define PLY_IMPL_ASYNCIO_TYPE ply::AsyncIO_IOUring
+    #else
+        #define PLY_IMPL_ASYNCIO_PATH "impl/AsyncIO_Blocking.h"
+        #define PLY_IMPL_ASYNCIO_TYPE ply::AsyncIO_Blocking
+    #endif
+#endif
+
+// Include the implementation:
+#include PLY_IMPL_ASYNCIO_PATH
+
+// Alias it:
+namespace ply {
+/*!
+A completion-based I/O queue. Operations on `InPipe`s and `OutPipe`s are queued with `read()` and
+`write()`, handed to the operating system in a single batch by `submit()`, and their results are
+collected later by `waitCompletions()`, allowing a single thread to keep many operations in
+flight. `submit()` returns the number of operations the operating system accepted; the rest stay
+queued and are handed over by the next call to `submit()` or `waitCompletions()`.
+
+On Linux, operations on file descriptor-based pipes (files, sockets and subprocess pipes) are
+performed asynchronously using io_uring. Other pipes, and all pipes on other platforms, are
+performed synchronously during `submit()`, so code written against `AsyncIO` works everywhere.
+*/
+typedef PLY_IMPL_ASYNCIO_TYPE AsyncIO;
+}
@@ -5,6 +5,7 @@
 #include <ply-runtime/Precomp.h>
 #include <ply-runtime/io/InStream.h>
 #include <ply-runtime/string/String.h>
+#include <ply-runtime/memory/MemPage.h>
 
 namespace ply {
 
@@ -36,8 +37,24 @@ PLY_NO_INLINE InStream::InStream(OptionallyOwned<InPipe>&& inPipe, u32 chunkSize
     this->endByte = this->chunk->bytes;
 }
 
+PLY_NO_INLINE Owned<InStream> InStream::adoptMappedView(ConstBufferView view) {
+    InStream* ins = new InStream{Type::View, 0};
+    ins->startByte = (u8*) view.bytes;
+    ins->curByte = (u8*) view.bytes;
+    ins->endByte = (u8*) view.bytes + view.numBytes;
+    ins->reserved = nullptr;
+    ins->status.isMapped = view.numBytes > 0 ? 1 : 0;
+    return ins;
+}
+
 PLY_NO_INLINE void InStream::destructInternal() {
-    PLY_ASSERT(this->status.type != (u32) Type::View);
+    if (this->status.type == (u32) Type::View) {
+        PLY_ASSERT(this->status.isMapped);
+        bool rc = MemPage::unmapFile(this->startByte, this->endByte - this->startByte);
+        PLY_ASSERT(rc);
+        PLY_UNUSED(rc);
+        return;
+    }
     destruct(this->chunk);
     if (this->status.type == (u32) Type::Pipe) {
         if (this->status.isPipeOwner) {
@@ -106,10 +123,25 @@ PLY_NO_INLINE u32 InStream::tryMakeBytesAvailableInternal(u32 numRequestedBytes)
         } else {
             u32 unreadStorageInCurrentChunk = safeDemote<u32>(this->chunk->end() - this->curByte);
             if (unreadStorageInCurrentChunk < numBytesNeededToCompleteRequest) {
-                // Append a new chunk
                 PLY_ASSERT(this->chunk->offsetIntoNextChunk == 0);
-                ChunkListNode::addChunkToTail(
-                    this->chunk, max(numBytesNeededToCompleteRequest, this->getChunkSize()));
+                if (this->status.type == (u32) Type::Pipe &&
+                    this->chunk->writePos == this->chunk->numBytes &&
+                    this->status.chunkSizeExp < MaxAdaptiveChunkSizeExp) {
+                    // The pipe filled the entire chunk, so we're probably streaming a large amount
+                    // of data sequentially. Use bigger chunks from now on to reduce the number of
+                    // calls to readSome().
+                    this->status.chunkSizeExp++;
+                }
+                u32 newChunkSize = max(numBytesNeededToCompleteRequest, this->getChunkSize());
+                if (unreadDataInCurrentChunk > 0) {
+                    // Chain a new chunk without recycling the current one. On the next iteration,
+                    // the unread data in the current chunk will be copied to tempChunk.
+                    this->chunk->next = ChunkListNode::allocate(
+                        this->chunk->fileOffset + this->chunk->writePos, newChunkSize);
+                    continue;
+                }
+                // Append a new chunk
+                ChunkListNode::addChunkToTail(this->chunk, newChunkSize);
                 this->curByte = this->chunk->bytes;
                 this->endByte = this->chunk->bytes; // nothing written to this chunk yet
             }
@@ -134,11 +166,14 @@ PLY_NO_INLINE u32 InStream::tryMakeBytesAvailableInternal(u32 numRequestedBytes)
         u32 bytesRead = this->inPipe->readSome(
             BufferView::fromRange(this->chunk->bytes + this->chunk->writePos, this->chunk->end()));
         if (bytesRead == 0) {
-            // We encountered EOF. As a safeguard/courtesy, pad memory with zeros up to the number
-            // of needed bytes, even though the caller should **NOT** read any of these...
+            // We encountered EOF, or a non-blocking pipe has no data available yet. As a
+            // safeguard/courtesy, pad memory with zeros up to the number of needed bytes, even
+            // though the caller should **NOT** read any of these...
             memset(this->chunk->bytes + this->chunk->writePos, 0,
                    numBytesNeededToCompleteRequest - numBytesAvailableToReadInChunk);
-            this->status.eof = 1;
+            if (!this->inPipe->wouldBlock) {
+                this->status.eof = 1;
+            }
             break;
         }
         this->chunk->writePos += bytesRead;
@@ -146,23 +181,26 @@ PLY_NO_INLINE u32 InStream::tryMakeBytesAvailableInternal(u32 numRequestedBytes)
         PLY_ASSERT(this->endByte == this->chunk->bytes + this->chunk->writePos);
     }
 
-    u32 numBytesToReturn =
-        numRequestedBytes - numBytesNeededToCompleteRequest + numBytesAvailableToReadInChunk;
-
     // If we created a tempChunk, finish copying data to it now, and expose the tempChunk to the
-    // caller.
+    // caller. The tempChunk is linked in front of the current chunk so that reading resumes in the
+    // current chunk right after the copied data.
     if (tempChunk) {
         PLY_ASSERT(numBytesNeededToCompleteRequest > 0);
+        u32 numBytesToCopy = min(numBytesNeededToCompleteRequest, numBytesAvailableToReadInChunk);
         memcpy(tempChunk->bytes + numRequestedBytes - numBytesNeededToCompleteRequest,
-               this->curByte, numBytesNeededToCompleteRequest);
+               this->curByte, numBytesToCopy);
         tempChunk->offsetIntoNextChunk =
-            safeDemote<u32>((this->curByte + numBytesAvailableToReadInChunk) - this->chunk->bytes);
+            safeDemote<u32>((this->curByte + numBytesToCopy) - this->chunk->bytes);
         PLY_ASSERT(tempChunk->offsetIntoNextChunk <= this->chunk->writePos);
-        this->curByte = tempChunk->bytes;
-        this->endByte = tempChunk->bytes + numBytesToReturn;
+        tempChunk->writePos = numRequestedBytes - numBytesNeededToCompleteRequest + numBytesToCopy;
+        tempChunk->next = std::move(this->chunk);
+        this->chunk = std::move(tempChunk);
+        this->curByte = this->chunk->bytes;
+        this->endByte = this->chunk->bytes + this->chunk->writePos;
+        return this->chunk->writePos;
     }
 
-    return numBytesToReturn;
+    return numRequestedBytes - numBytesNeededToCompleteRequest + numBytesAvailableToReadInChunk;
 }
 
 PLY_NO_INLINE u64 InStream::getSeekPos() const {
@@ -174,15 +212,22 @@ PLY_NO_INLINE u64 InStream::getSeekPos() const {
 }
 
 PLY_NO_INLINE ChunkCursor InStream::getCursor() const {
-    // View is not supported yet, but could be in the future:
-    PLY_ASSERT(this->status.type != (u32) Type::View);
+    if (this->status.type == (u32) Type::View) {
+        // Views don't have chunks; the cursor is just a raw pointer into the view:
+        return {nullptr, this->curByte};
+    }
     PLY_ASSERT(!this->chunk || this->chunk->viewUsedBytes().contains(this->curByte));
     return {this->chunk, this->curByte};
 }
 
 PLY_NO_INLINE void InStream::rewind(ChunkCursor cursor) {
-    // View is not supported yet, but could be in the future:
-    PLY_ASSERT(this->status.type != (u32) Type::View);
+    if (this->status.type == (u32) Type::View) {
+        PLY_ASSERT(!cursor.chunk);
+        PLY_ASSERT(uptr(cursor.curByte - this->startByte) <= uptr(this->endByte - this->startByte));
+        this->curByte = cursor.curByte;
+        this->status.eof = 0;
+        return;
+    }
     PLY_ASSERT(cursor.chunk->viewUsedBytes().contains(cursor.curByte));
     this->chunk = cursor.chunk;
     this->curByte = cursor.curByte;
@@ -194,7 +239,46 @@ PLY_NO_INLINE bool InStream::readSlowPath(BufferView dst) {
     if (this->status.eof)
         return false;
 
+    if (this->status.type == (u32) Type::Pipe && this->inPipe->isNonBlocking) {
+        // Don't consume anything unless all of dst can be filled. Otherwise, bytes already copied
+        // to dst would be lost if the pipe runs out of data partway through. Instead, the data
+        // stays buffered in the InStream until the caller tries again.
+        if (this->tryMakeBytesAvailable(dst.numBytes) < dst.numBytes) {
+            memset(dst.bytes, 0, dst.numBytes);
+            return false;
+        }
+        memcpy(dst.bytes, this->curByte, dst.numBytes);
+        this->curByte += dst.numBytes;
+        return true;
+    }
+
     while (dst.numBytes > 0) {
+        if (this->status.type == (u32) Type::Pipe && this->curByte == this->endByte &&
+            dst.numBytes >= this->getChunkSize() && this->chunk && !this->chunk->next &&
+            this->chunk->refCount == 1) {
+            // Large read with an empty input buffer and no outstanding ChunkCursors: Read directly
+            // into dst, and refill the chunk with any excess data in the same call to the pipe.
+            PLY_ASSERT(this->chunk->offsetIntoNextChunk == 0);
+            this->chunk->fileOffset += this->chunk->writePos;
+            this->chunk->writePos = 0;
+            this->curByte = this->chunk->bytes;
+            this->endByte = this->chunk->bytes;
+            BufferView bufs[2] = {dst, this->chunk->viewAll()};
+            u32 numBytesRead = this->inPipe->readSomeVectored({bufs, 2});
+            if (numBytesRead == 0) {
+                memset(dst.bytes, 0, dst.numBytes);
+                if (!this->inPipe->wouldBlock) {
+                    this->status.eof = 1;
+                }
+                return false;
+            }
+            u32 numBytesToDst = min(numBytesRead, dst.numBytes);
+            dst.offsetHead(numBytesToDst);
+            this->chunk->fileOffset += numBytesToDst;
+            this->chunk->writePos = numBytesRead - numBytesToDst;
+            this->endByte = this->chunk->bytes + this->chunk->writePos;
+            continue;
+        }
         if (!this->tryMakeBytesAvailable()) {
             memset(dst.bytes, 0, dst.numBytes);
             return false;
@@ -209,6 +293,13 @@ PLY_NO_INLINE bool InStream::readSlowPath(BufferView dst) {
 }
 
 PLY_NO_INLINE Buffer InStream::readRemainingContents() {
+    if (this->status.type == (u32) Type::View) {
+        Buffer result = Buffer::allocate(this->numBytesAvailable());
+        memcpy(result.bytes, this->curByte, result.numBytes);
+        this->curByte = this->endByte;
+        this->status.eof = 1;
+        return result;
+    }
     ChunkCursor startChunk = this->getCursor();
     while (this->tryMakeBytesAvailable()) {
         this->curByte = this->endByte;
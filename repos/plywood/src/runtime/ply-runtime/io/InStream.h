@@ -37,6 +37,10 @@ and `StringReader` is mainly intended to read text, but the two classes are inte
 struct InStream {
     static const u32 DefaultChunkSizeExp = 12;
 
+    // When reading from an InPipe, the chunk size doubles each time the pipe fills an entire chunk,
+    // up to this limit (64 KB).
+    static const u32 MaxAdaptiveChunkSizeExp = 16;
+
     enum class Type : u32 {
         View = 0,
         Pipe,
@@ -44,14 +48,16 @@ struct InStream {
     };
 
     struct Status {
-        u32 chunkSizeExp : 27;
+        u32 chunkSizeExp : 26;
         u32 type : 2;
         u32 isPipeOwner : 1;
+        u32 isMapped : 1; // only if Type::View
         u32 eof : 1;
         u32 parseError : 1;
 
         PLY_INLINE Status(Type type, u32 chunkSizeExp = InStream::DefaultChunkSizeExp)
-            : chunkSizeExp{chunkSizeExp}, type{(u32) type}, isPipeOwner{0}, eof{0}, parseError{0} {
+            : chunkSizeExp{chunkSizeExp}, type{(u32) type}, isPipeOwner{0}, isMapped{0}, eof{0},
+              parseError{0} {
         }
     };
 
@@ -110,8 +116,15 @@ public:
     PLY_DLL_ENTRY InStream(OptionallyOwned<InPipe>&& inPipe,
                            u32 chunkSizeExp = DefaultChunkSizeExp);
 
+    /*!
+    Constructs a view `InStream` that reads from a read-only memory-mapped region of a file. The
+    `InStream` takes ownership of the mapping and unmaps it in its destructor. This function is used
+    internally by `FileSystem::openMappedStreamForRead()`.
+    */
+    static PLY_DLL_ENTRY Owned<InStream> adoptMappedView(ConstBufferView view);
+
     PLY_INLINE ~InStream() {
-        if (this->status.type != (u32) Type::View) {
+        if (this->status.type != (u32) Type::View || this->status.isMapped) {
             this->destructInternal();
         }
     }
@@ -123,7 +136,8 @@ public:
 
     /*!
     Return `true` if the `InStream` is reading from a fixed memory buffer. Typically this means that
-    the `InStream` was created from a derived class such as `ViewInStream` or `StringViewReader`.
+    the `InStream` was created from a derived class such as `ViewInStream` or `StringViewReader`, or
+    by `FileSystem::openMappedStreamForRead()`.
     */
     PLY_INLINE bool isView() const {
         return this->status.type == (u32) Type::View;
@@ -166,7 +180,8 @@ public:
     /*!
     Returns a `ChunkCursor` at the current input position. The `ChunkCursor` increments the
     reference count of the `InStream`'s internal `ChunkListNode`, preventing it from being destroyed
-    when reading past the end of the chunk. This function is used internally by
+    when reading past the end of the chunk. If the `InStream` is a view, the returned `ChunkCursor`
+    has no chunk and simply points into the view. This function is used internally by
     `StringReader::readString` in order to copy some region of the input to a `String`. In
     particular, `StringReader::readString<fmt::Line>` returns a single line of input as a `String`
     even if it originally spanned multiple `ChunkListNode`s.
@@ -185,6 +200,10 @@ public:
     function will block until at least `numBytes` bytes arrive. If EOF/error is encountered, the
     return value will be less than `numBytes`; otherwise, it will be greater than or equal to
     `numBytes`.
+
+    If the underlying `InPipe` is in non-blocking mode, the return value can also be less than
+    `numBytes` without EOF being set, in which case `inPipe->wouldBlock` is `true`. Use a
+    `PollLoop` to be notified when more data arrives.
     */
     PLY_INLINE u32 tryMakeBytesAvailable(u32 numBytes = 1) {
         if (uptr(this->endByte - this->curByte) < numBytes)
@@ -234,6 +253,11 @@ public:
     for data, this function will block until `dst` is filled. Returns `true` if the buffer is filled
     successfully. If EOF/error is encountered before `dst` can be filled, the remainder of `dst` is
     filled with zeros and `false` is returned.
+
+    If the underlying `InPipe` is in non-blocking mode and not enough data has arrived yet, `dst` is
+    filled with zeros, `false` is returned and `inPipe->wouldBlock` is `true`. No data is consumed
+    in that case, so the same `read()` can be retried once `PollLoop::makeBytesAvailable()` reports
+    that `dst.numBytes` are available.
     */
     PLY_INLINE bool read(BufferView dst) {
         if (dst.numBytes > safeDemote<u32>(this->endByte - this->curByte)) {
@@ -279,17 +303,21 @@ struct ViewInStream : InStream {
     }
 
     PLY_INLINE ~ViewInStream() {
-        PLY_ASSERT(this->isView());
+        PLY_ASSERT(this->isView() && !this->status.isMapped);
         // This lets the compiler optimize away the call to destructInternal():
         this->status.type = (u32) Type::View;
+        this->status.isMapped = 0;
     }
 
     PLY_INLINE void operator=(const ViewInStream& other) {
         PLY_ASSERT(this->isView() && other.isView());
+        PLY_ASSERT(!this->status.isMapped);
         this->startByte = other.startByte;
         this->curByte = other.curByte;
         this->endByte = other.endByte;
         this->status = other.status;
+        // Ownership of a memory-mapped view is never copied:
+        this->status.isMapped = 0;
     }
 
     struct SavePoint {
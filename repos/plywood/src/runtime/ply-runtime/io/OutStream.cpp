@@ -123,6 +123,13 @@ PLY_NO_INLINE u32 OutStream::tryMakeBytesAvailableInternal(s32 numBytes) {
         return 0;
     }
 
+    if (this->status.type == (u32) Type::Pipe &&
+        this->status.chunkSizeExp < MaxAdaptiveChunkSizeExp) {
+        // The chunk filled up, so we're probably streaming a large amount of data sequentially.
+        // Use bigger chunks from now on to reduce the number of calls to write().
+        this->status.chunkSizeExp++;
+    }
+
     // Get a new chunk to write to
     ChunkListNode::addChunkToTail(this->chunk, max(this->getChunkSize(), (u32) abs(numBytes)));
     this->curByte = this->chunk->bytes;
@@ -134,6 +141,22 @@ PLY_NO_INLINE bool OutStream::writeSlowPath(ConstBufferView src) {
     if (this->status.eof)
         return false;
 
+    if (this->status.type == (u32) Type::Pipe && src.numBytes >= this->getChunkSize() &&
+        this->chunk->refCount == 1) {
+        // Large write: Send any unflushed data together with src in a single call to the pipe,
+        // without copying src to the chunk first.
+        u8* flushedByte = this->chunk->bytes + this->chunk->writePos;
+        ConstBufferView bufs[2] = {ConstBufferView::fromRange(flushedByte, this->curByte), src};
+        if (!this->outPipe->writeVectored({bufs, 2})) {
+            this->status.eof = 1;
+        }
+        // Recycle the chunk:
+        this->chunk->fileOffset += (u64) (this->curByte - this->chunk->bytes) + src.numBytes;
+        this->chunk->writePos = 0;
+        this->curByte = this->chunk->bytes;
+        return this->status.eof == 0;
+    }
+
     while (src.numBytes > 0) {
         if (!this->tryMakeBytesAvailable())
             return false;
@@ -146,6 +169,53 @@ PLY_NO_INLINE bool OutStream::writeSlowPath(ConstBufferView src) {
     return true;
 }
 
+PLY_NO_INLINE bool OutStream::writeVectored(ArrayView<const ConstBufferView> bufs) {
+    if (this->status.eof)
+        return false;
+
+    u64 totalBytes = 0;
+    for (const ConstBufferView& buf : bufs) {
+        totalBytes += buf.numBytes;
+    }
+
+    if (this->status.type == (u32) Type::Pipe && totalBytes >= this->getChunkSize() &&
+        this->chunk->refCount == 1) {
+        // Large write: Send any unflushed data together with bufs to the pipe, without copying
+        // bufs to the chunk first. As long as there aren't too many bufs, it's a single call.
+        static const u32 MaxCombinedBufs = 32;
+        u8* flushedByte = this->chunk->bytes + this->chunk->writePos;
+        ConstBufferView unflushed = ConstBufferView::fromRange(flushedByte, this->curByte);
+        bool ok = true;
+        if (unflushed.numBytes > 0 && bufs.numItems < MaxCombinedBufs) {
+            ConstBufferView combined[MaxCombinedBufs];
+            combined[0] = unflushed;
+            for (u32 i = 0; i < bufs.numItems; i++) {
+                combined[i + 1] = bufs[i];
+            }
+            ok = this->outPipe->writeVectored({combined, bufs.numItems + 1});
+        } else {
+            if (unflushed.numBytes > 0) {
+                ok = this->outPipe->write(unflushed);
+            }
+            ok = ok && this->outPipe->writeVectored(bufs);
+        }
+        if (!ok) {
+            this->status.eof = 1;
+        }
+        // Recycle the chunk:
+        this->chunk->fileOffset += (u64) (this->curByte - this->chunk->bytes) + totalBytes;
+        this->chunk->writePos = 0;
+        this->curByte = this->chunk->bytes;
+        return this->status.eof == 0;
+    }
+
+    for (const ConstBufferView& buf : bufs) {
+        if (!this->write(buf))
+            return false;
+    }
+    return true;
+}
+
 //------------------------------------------------------------------
 // MemOutStream
 //------------------------------------------------------------------
@@ -155,6 +225,13 @@ PLY_NO_INLINE MemOutStream::MemOutStream(u32 chunkSizeExp) : OutStream{Type::Mem
 }
 
 PLY_NO_INLINE Buffer MemOutStream::moveToBuffer() {
+    // Releasing the stream's chunk references first allows Buffer::fromChunks() to optimize in the
+    // case where there's only one chunk: Chunk memory gets trimmed and returned immediately,
+    // avoiding a memcpy.
+    return this->moveToChunks().moveToBuffer();
+}
+
+PLY_NO_INLINE ChunkString MemOutStream::moveToChunks() {
     PLY_ASSERT(this->status.type == (u32) Type::Mem);
 
     // Flush writePos
@@ -163,12 +240,10 @@ PLY_NO_INLINE Buffer MemOutStream::moveToBuffer() {
     PLY_ASSERT(newWritePos <= this->chunk->numBytes);
     this->chunk->writePos = newWritePos;
 
-    // Release chunk references and create Buffer. Releasing the references allows
-    // binaryFromChunks() to optimize in the case where there's only one chunk: Chunk memory gets
-    // trimmed and returned immediately, avoiding a memcpy.
+    // Transfer ownership of the chunk list
     this->chunk = nullptr;
     u8* bytes = this->headChunk->bytes;
-    Buffer result = Buffer::fromChunks({std::move(this->headChunk), bytes});
+    ChunkString result{{std::move(this->headChunk), bytes}};
 
     // Leave this stream in the state of a null ViewOutStream
     makeNull(this);
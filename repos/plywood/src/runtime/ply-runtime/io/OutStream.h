@@ -31,6 +31,10 @@ data and `StringWriter` is mainly intended to write text, but the two classes ar
 struct OutStream {
     static constexpr u32 DefaultChunkSizeExp = 12;
 
+    // When writing to an OutPipe, the chunk size doubles each time a chunk fills up, up to this
+    // limit (64 KB).
+    static constexpr u32 MaxAdaptiveChunkSizeExp = 16;
+
     enum class Type : u32 {
         View = 0,
         Pipe,
@@ -233,6 +237,14 @@ public:
         return this->status.eof == 0;
     }
 
+    /*!
+    Writes each buffer in `bufs` to the output stream, in order. If the `OutStream` writes to an
+    `OutPipe` and the buffers are large, any unflushed data is sent to the `OutPipe` together with
+    `bufs` in a single call to `OutPipe::writeVectored()`, and `bufs` are never copied to the
+    internal memory buffer. Returns `true` if the write was successful.
+    */
+    PLY_DLL_ENTRY bool writeVectored(ArrayView<const ConstBufferView> bufs);
+
     /*!
     Returns a `StringWriter` interface for the output stream.
     */
@@ -248,7 +260,8 @@ stored in a list of `ChunkListNode`s. As each `ChunkListNode` fills up, a new on
 added to the end of the list.
 
 Once you've finished writing data to a `MemOutStream`, you can convert it to a single contiguous
-memory block by calling `moveToBuffer()`.
+memory block by calling `moveToBuffer()`, or take ownership of the chunk list without copying it by
+calling `moveToChunks()`.
 */
 struct MemOutStream : OutStream {
     /*!
@@ -279,6 +292,13 @@ struct MemOutStream : OutStream {
     PLY_INLINE String moveToString() {
         return String::moveFromBuffer(this->moveToBuffer());
     }
+
+    /*!
+    Returns a `ChunkString` that takes ownership of the internal list of `ChunkListNode`s. No data
+    is copied, which makes this function suitable for large outputs that are going to be written to
+    another `OutStream` anyway. The `MemOutStream` is reset to a null stream as result of this call.
+    */
+    PLY_DLL_ENTRY ChunkString moveToChunks();
 };
 
 //------------------------------------------------------------------
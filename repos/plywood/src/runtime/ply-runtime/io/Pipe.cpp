@@ -23,6 +23,15 @@ PLY_NO_INLINE u64 InPipe::getFileSize_Unsupported(const InPipe*) {
     return 0;
 }
 
+PLY_NO_INLINE u32 InPipe::readSomeVectored_Default(InPipe* inPipe,
+                                                    ArrayView<const BufferView> bufs) {
+    for (const BufferView& buf : bufs) {
+        if (buf.numBytes > 0)
+            return inPipe->readSome(buf);
+    }
+    return 0;
+}
+
 PLY_NO_INLINE void OutPipe::flush_Empty(OutPipe*) {
 }
 
@@ -30,4 +39,13 @@ PLY_NO_INLINE u64 OutPipe::seek_Empty(OutPipe*, s64, SeekDir) {
     return 0;
 }
 
+PLY_NO_INLINE bool OutPipe::writeVectored_Default(OutPipe* outPipe,
+                                                  ArrayView<const ConstBufferView> bufs) {
+    for (const ConstBufferView& buf : bufs) {
+        if (buf.numBytes > 0 && !outPipe->write(buf))
+            return false;
+    }
+    return true;
+}
+
 } // namespace ply
@@ -5,6 +5,7 @@
 #pragma once
 #include <ply-runtime/Core.h>
 #include <ply-runtime/container/BufferView.h>
+#include <ply-runtime/container/ArrayView.h>
 
 namespace ply {
 
@@ -34,10 +35,18 @@ struct InPipe {
         void (*destroy)(InPipe*) = nullptr;
         u32 (*readSome)(InPipe*, BufferView) = nullptr;
         u64 (*getFileSize)(const InPipe*) = nullptr;
+        u32 (*readSomeVectored)(InPipe*, ArrayView<const BufferView>) = nullptr;
     };
 
     Funcs* funcs = nullptr;
 
+    // Set by non-blocking pipes when the last call to readSome() returned 0 because no data was
+    // available yet, rather than because EOF/error was encountered.
+    bool wouldBlock = false;
+
+    // Set while the pipe is in non-blocking mode.
+    bool isNonBlocking = false;
+
     PLY_INLINE InPipe(Funcs* funcs) : funcs{funcs} {
     }
     PLY_INLINE ~InPipe() {
@@ -59,11 +68,24 @@ struct InPipe {
     Attempts to read some data into `buf` from the input source. If the `InPipe` is waiting for
     data, this function will block until some data arrives. Returns the actual number of bytes read,
     which might be less than the size of `buf`. Returns 0 if EOF/error is encountered.
+
+    If the `InPipe` was put in non-blocking mode (for example, using `InPipe_FD::setNonBlocking()`)
+    and no data is available yet, returns 0 and sets `wouldBlock` to `true`.
     */
     PLY_INLINE u32 readSome(BufferView buf) {
         return this->funcs->readSome(this, buf);
     }
 
+    /*!
+    Like `readSome()`, but scatters the data across several buffers, filling them in order. Returns
+    the total number of bytes read, which might be less than the combined size of `bufs`. Returns 0
+    if EOF/error is encountered. When the `InPipe` reads from a POSIX file descriptor, this performs
+    a single `readv()` system call.
+    */
+    PLY_INLINE u32 readSomeVectored(ArrayView<const BufferView> bufs) {
+        return this->funcs->readSomeVectored(this, bufs);
+    }
+
     /*!
     Attempts to completely fill `buf` with data from the input source. If the `InPipe` is waiting
     for data, this function will block until `buf` is completely filled. Returns `true` if
@@ -79,6 +101,7 @@ struct InPipe {
     }
 
     static u64 getFileSize_Unsupported(const InPipe*);
+    static u32 readSomeVectored_Default(InPipe*, ArrayView<const BufferView>);
 };
 
 //------------------------------------------------------------------------------------------------
@@ -101,6 +124,7 @@ struct OutPipe {
         bool (*write)(OutPipe*, ConstBufferView) = nullptr;
         bool (*flush)(OutPipe*, bool) = nullptr;
         u64 (*seek)(OutPipe*, s64, SeekDir) = nullptr;
+        bool (*writeVectored)(OutPipe*, ArrayView<const ConstBufferView>) = nullptr;
     };
 
     Funcs* funcs = nullptr;
@@ -133,6 +157,15 @@ struct OutPipe {
         return this->funcs->write(this, buf);
     }
 
+    /*!
+    Like `write()`, but gathers the data from several buffers, writing them in order. Returns `true`
+    if the contents of every buffer were written successfully. When the `OutPipe` writes to a POSIX
+    file descriptor, this performs a single `writev()` system call in the common case.
+    */
+    PLY_INLINE bool writeVectored(ArrayView<const ConstBufferView> bufs) {
+        return this->funcs->writeVectored(this, bufs);
+    }
+
     /*!
     Flushes any application-level memory buffers in the same manner as `flushMem()`, then performs
     an implementation-specific device flush if `toDevice` is `true`. For example, if `toDevice` is
@@ -164,6 +197,7 @@ struct OutPipe {
 
     static void flush_Empty(OutPipe*);
     static u64 seek_Empty(OutPipe*, s64, SeekDir);
+    static bool writeVectored_Default(OutPipe*, ArrayView<const ConstBufferView>);
 };
 
 } // namespace ply
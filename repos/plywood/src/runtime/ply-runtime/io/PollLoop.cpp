@@ -0,0 +1,100 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <ply-runtime/Precomp.h>
+
+#if PLY_TARGET_POSIX
+
+#include <ply-runtime/io/PollLoop.h>
+#include <ply-runtime/io/impl/Pipe_FD.h>
+#include <poll.h>
+
+namespace ply {
+
+PLY_NO_INLINE void PollLoop::waitReadable(int fd, Functor<void()>&& callback) {
+    PLY_ASSERT(fd >= 0);
+    Waiter& waiter = this->waiters.append();
+    waiter.fd = fd;
+    waiter.events = POLLIN;
+    waiter.callback = std::move(callback);
+}
+
+PLY_NO_INLINE void PollLoop::waitWritable(int fd, Functor<void()>&& callback) {
+    PLY_ASSERT(fd >= 0);
+    Waiter& waiter = this->waiters.append();
+    waiter.fd = fd;
+    waiter.events = POLLOUT;
+    waiter.callback = std::move(callback);
+}
+
+PLY_NO_INLINE void PollLoop::makeBytesAvailable(InStream* ins, u32 numBytes,
+                                                Functor<void(u32)>&& callback) {
+    PLY_ASSERT(ins->status.type == (u32) InStream::Type::Pipe);
+    u32 numBytesAvailable = ins->tryMakeBytesAvailable(numBytes);
+    if (numBytesAvailable >= numBytes || !ins->inPipe->wouldBlock) {
+        callback.call(numBytesAvailable);
+        return;
+    }
+    Waiter& waiter = this->waiters.append();
+    waiter.fd = ins->inPipe->cast<InPipe_FD>()->fd;
+    waiter.events = POLLIN;
+    waiter.ins = ins;
+    waiter.numBytes = numBytes;
+    waiter.insCallback = std::move(callback);
+}
+
+PLY_NO_INLINE u32 PollLoop::runOnce(s32 timeoutMillis) {
+    if (this->waiters.isEmpty())
+        return 0;
+
+    Array<pollfd> pollFDs;
+    pollFDs.resize(this->waiters.numItems());
+    for (u32 i = 0; i < this->waiters.numItems(); i++) {
+        pollFDs[i].fd = this->waiters[i].fd;
+        pollFDs[i].events = this->waiters[i].events;
+        pollFDs[i].revents = 0;
+    }
+    int rc;
+    do {
+        rc = ::poll(pollFDs.begin(), pollFDs.numItems(), timeoutMillis);
+    } while (rc == -1 && errno == EINTR);
+    if (rc <= 0)
+        return 0;
+
+    // Remove ready waiters from the list before invoking any callbacks, since callbacks can add
+    // new waiters.
+    Array<Waiter> ready;
+    u32 numKept = 0;
+    for (u32 i = 0; i < this->waiters.numItems(); i++) {
+        if (pollFDs[i].revents != 0) {
+            ready.append(std::move(this->waiters[i]));
+        } else {
+            if (numKept != i) {
+                this->waiters[numKept] = std::move(this->waiters[i]);
+            }
+            numKept++;
+        }
+    }
+    this->waiters.resize(numKept);
+
+    for (Waiter& waiter : ready) {
+        if (waiter.ins) {
+            // Tries again, and re-registers the waiter if there's still not enough data:
+            this->makeBytesAvailable(waiter.ins, waiter.numBytes, std::move(waiter.insCallback));
+        } else {
+            waiter.callback.call();
+        }
+    }
+    return ready.numItems();
+}
+
+PLY_NO_INLINE void PollLoop::run() {
+    while (!this->waiters.isEmpty()) {
+        this->runOnce();
+    }
+}
+
+} // namespace ply
+
+#endif // PLY_TARGET_POSIX
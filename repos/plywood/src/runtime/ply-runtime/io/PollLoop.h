@@ -0,0 +1,80 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+
+#if PLY_TARGET_POSIX
+
+#include <ply-runtime/io/InStream.h>
+#include <ply-runtime/container/Array.h>
+#include <ply-runtime/container/Functor.h>
+
+namespace ply {
+
+/*!
+A single-threaded event loop that invokes callbacks when file descriptors become ready. Together
+with non-blocking pipes (see `InPipe_FD::setNonBlocking()`), it lets one thread service many
+network connections or subprocess pipes, suspending each parser until more input arrives instead
+of blocking a thread per connection.
+
+Callbacks are invoked from `runOnce()` or `run()` and may register further callbacks.
+*/
+class PollLoop {
+private:
+    struct Waiter {
+        int fd = -1;
+        short events = 0;
+        Functor<void()> callback;
+        // Only used by makeBytesAvailable():
+        InStream* ins = nullptr;
+        u32 numBytes = 0;
+        Functor<void(u32)> insCallback;
+    };
+
+    Array<Waiter> waiters;
+
+public:
+    /*!
+    Invokes `callback` once `fd` becomes readable, or the other end of the connection is closed.
+    */
+    PLY_DLL_ENTRY void waitReadable(int fd, Functor<void()>&& callback);
+
+    /*!
+    Invokes `callback` once `fd` becomes writable.
+    */
+    PLY_DLL_ENTRY void waitWritable(int fd, Functor<void()>&& callback);
+
+    /*!
+    Invokes `callback` once at least `numBytes` bytes are available to read contiguously at
+    `ins->curByte`, or EOF/error is encountered. The argument passed to `callback` is the return
+    value of `ins->tryMakeBytesAvailable(numBytes)`. `ins` must read from an `InPipe_FD` in
+    non-blocking mode. If enough bytes are already available, `callback` is invoked immediately.
+    */
+    PLY_DLL_ENTRY void makeBytesAvailable(InStream* ins, u32 numBytes,
+                                          Functor<void(u32)>&& callback);
+
+    /*!
+    Returns `true` if no callbacks are waiting.
+    */
+    PLY_INLINE bool isEmpty() const {
+        return this->waiters.isEmpty();
+    }
+
+    /*!
+    Waits until at least one file descriptor is ready, or `timeoutMillis` elapses, then invokes the
+    callbacks of every ready file descriptor. Pass -1 to wait indefinitely. Returns the number of
+    callbacks invoked.
+    */
+    PLY_DLL_ENTRY u32 runOnce(s32 timeoutMillis = -1);
+
+    /*!
+    Invokes callbacks until none are left waiting.
+    */
+    PLY_DLL_ENTRY void run();
+};
+
+} // namespace ply
+
+#endif // PLY_TARGET_POSIX
@@ -0,0 +1,136 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <ply-runtime/Precomp.h>
+#include <ply-runtime/io/Readahead.h>
+#include <ply-runtime/container/Array.h>
+#include <ply-runtime/container/Buffer.h>
+#include <ply-runtime/thread/Thread.h>
+#include <ply-runtime/thread/Mutex.h>
+#include <ply-runtime/thread/ConditionVariable.h>
+
+namespace ply {
+
+struct InPipe_Readahead : InPipe {
+    struct Slot {
+        Buffer buf;
+        u32 numBytes = 0; // 0 means end of input
+    };
+
+    static Funcs Funcs_;
+    OptionallyOwned<InPipe> inPipe;
+    Array<Slot> slots;
+    Thread thread;
+    Mutex mutex;
+    ConditionVariable condVar;
+    // Protected by mutex:
+    u32 numFilled = 0;
+    bool stop = false;
+    // Only accessed by the consumer:
+    u32 readIdx = 0;
+    u32 readPos = 0;
+
+    InPipe_Readahead();
+    void runProducer();
+};
+
+PLY_NO_INLINE void InPipe_Readahead::runProducer() {
+    u32 writeIdx = 0;
+    for (;;) {
+        {
+            LockGuard<Mutex> guard{this->mutex};
+            while (!this->stop && this->numFilled == this->slots.numItems()) {
+                this->condVar.wait(guard);
+            }
+            if (this->stop)
+                return;
+        }
+
+        // The slot at writeIdx is empty, so it's safe to fill it without holding the lock:
+        Slot& slot = this->slots[writeIdx];
+        slot.numBytes = this->inPipe->readSome(slot.buf);
+
+        LockGuard<Mutex> guard{this->mutex};
+        this->numFilled++;
+        this->condVar.wakeAll();
+        if (slot.numBytes == 0)
+            return; // EOF or error
+        writeIdx = (writeIdx + 1) % this->slots.numItems();
+    }
+}
+
+PLY_NO_INLINE void InPipe_Readahead_destroy(InPipe* inPipe_) {
+    InPipe_Readahead* inPipe = static_cast<InPipe_Readahead*>(inPipe_);
+    {
+        LockGuard<Mutex> guard{inPipe->mutex};
+        inPipe->stop = true;
+        inPipe->condVar.wakeAll();
+    }
+    inPipe->thread.join();
+    destruct(inPipe->inPipe);
+    destruct(inPipe->slots);
+    destruct(inPipe->condVar);
+    destruct(inPipe->mutex);
+    destruct(inPipe->thread);
+}
+
+PLY_NO_INLINE u32 InPipe_Readahead_readSome(InPipe* inPipe_, BufferView buf) {
+    InPipe_Readahead* inPipe = static_cast<InPipe_Readahead*>(inPipe_);
+    PLY_ASSERT(buf.numBytes > 0);
+    {
+        LockGuard<Mutex> guard{inPipe->mutex};
+        while (inPipe->numFilled == 0) {
+            inPipe->condVar.wait(guard);
+        }
+    }
+
+    // The slot at readIdx is filled, so it's safe to read from it without holding the lock:
+    InPipe_Readahead::Slot& slot = inPipe->slots[inPipe->readIdx];
+    if (slot.numBytes == 0)
+        return 0; // EOF or error; the producer thread has exited
+    u32 numBytes = min(buf.numBytes, slot.numBytes - inPipe->readPos);
+    memcpy(buf.bytes, slot.buf.bytes + inPipe->readPos, numBytes);
+    inPipe->readPos += numBytes;
+
+    if (inPipe->readPos >= slot.numBytes) {
+        // Hand the slot back to the producer
+        inPipe->readPos = 0;
+        inPipe->readIdx = (inPipe->readIdx + 1) % inPipe->slots.numItems();
+        LockGuard<Mutex> guard{inPipe->mutex};
+        inPipe->numFilled--;
+        inPipe->condVar.wakeAll();
+    }
+    return numBytes;
+}
+
+PLY_NO_INLINE u64 InPipe_Readahead_getFileSize(const InPipe* inPipe_) {
+    const InPipe_Readahead* inPipe = static_cast<const InPipe_Readahead*>(inPipe_);
+    return inPipe->inPipe->getFileSize();
+}
+
+InPipe::Funcs InPipe_Readahead::Funcs_ = {
+    InPipe_Readahead_destroy,
+    InPipe_Readahead_readSome,
+    InPipe_Readahead_getFileSize,
+    InPipe::readSomeVectored_Default,
+};
+
+PLY_NO_INLINE InPipe_Readahead::InPipe_Readahead() : InPipe{&Funcs_} {
+}
+
+Owned<InPipe> createReadaheadPipe(OptionallyOwned<InPipe>&& inPipe, u32 bufferSize,
+                                  u32 numBuffers) {
+    PLY_ASSERT(bufferSize > 0);
+    PLY_ASSERT(numBuffers > 0);
+    InPipe_Readahead* readahead = new InPipe_Readahead;
+    readahead->inPipe = std::move(inPipe);
+    readahead->slots.resize(numBuffers);
+    for (InPipe_Readahead::Slot& slot : readahead->slots) {
+        slot.buf = Buffer::allocate(bufferSize);
+    }
+    readahead->thread.run([readahead] { readahead->runProducer(); });
+    return readahead;
+}
+
+} // namespace ply
@@ -0,0 +1,20 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+#include <ply-runtime/io/Pipe.h>
+#include <ply-runtime/container/Owned.h>
+
+namespace ply {
+
+// Returns an InPipe that reads ahead from `inPipe` on a background thread, so that the next
+// buffer of data is (ideally) already available by the time it's requested. Useful when the
+// consumer does significant work between reads, such as parsing a large file.
+// `numBuffers` buffers of `bufferSize` bytes each are filled in round-robin order.
+// Destroying the returned InPipe waits for any read already in progress on the inner pipe.
+PLY_DLL_ENTRY Owned<InPipe> createReadaheadPipe(OptionallyOwned<InPipe>&& inPipe,
+                                                u32 bufferSize = 65536, u32 numBuffers = 2);
+
+} // namespace ply
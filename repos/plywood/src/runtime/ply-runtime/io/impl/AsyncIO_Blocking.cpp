@@ -0,0 +1,64 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <ply-runtime/Precomp.h>
+#include <ply-runtime/io/impl/AsyncIO_Blocking.h>
+
+namespace ply {
+
+PLY_NO_INLINE AsyncIO_Blocking::AsyncIO_Blocking(u32 queueDepth) : queueDepth{queueDepth} {
+    PLY_ASSERT(queueDepth > 0);
+}
+
+PLY_NO_INLINE bool AsyncIO_Blocking::read(InPipe* inPipe, BufferView buf, void* userData) {
+    if (this->queued.numItems() >= this->queueDepth)
+        return false;
+    Op& op = this->queued.append();
+    op.inPipe = inPipe;
+    op.buf = buf;
+    op.userData = userData;
+    return true;
+}
+
+PLY_NO_INLINE bool AsyncIO_Blocking::write(OutPipe* outPipe, ConstBufferView buf,
+                                           void* userData) {
+    if (this->queued.numItems() >= this->queueDepth)
+        return false;
+    Op& op = this->queued.append();
+    op.outPipe = outPipe;
+    op.buf = {const_cast<u8*>(buf.bytes), buf.numBytes};
+    op.userData = userData;
+    return true;
+}
+
+PLY_NO_INLINE u32 AsyncIO_Blocking::submit() {
+    if (this->completedIndex >= this->completed.numItems()) {
+        this->completed.clear();
+        this->completedIndex = 0;
+    }
+    for (const Op& op : this->queued) {
+        AsyncIOCompletion& completion = this->completed.append();
+        completion.userData = op.userData;
+        if (op.inPipe) {
+            completion.result = (s32) op.inPipe->readSome(op.buf);
+        } else {
+            completion.result = op.outPipe->write(op.buf) ? (s32) op.buf.numBytes : -1;
+        }
+    }
+    u32 numSubmitted = this->queued.numItems();
+    this->queued.clear();
+    return numSubmitted;
+}
+
+PLY_NO_INLINE u32 AsyncIO_Blocking::waitCompletions(ArrayView<AsyncIOCompletion> dst, u32) {
+    u32 numCompletions =
+        min<u32>(dst.numItems, this->completed.numItems() - this->completedIndex);
+    for (u32 i = 0; i < numCompletions; i++) {
+        dst[i] = this->completed[this->completedIndex + i];
+    }
+    this->completedIndex += numCompletions;
+    return numCompletions;
+}
+
+} // namespace ply
@@ -0,0 +1,56 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+#include <ply-runtime/io/Pipe.h>
+#include <ply-runtime/container/Array.h>
+
+namespace ply {
+
+/*!
+The result of an operation queued on an `AsyncIO`. `result` is the number of bytes transferred,
+which can be less than requested, or a negative value if the operation failed. A read that
+returns 0 bytes indicates EOF.
+*/
+struct AsyncIOCompletion {
+    void* userData = nullptr;
+    s32 result = 0;
+};
+
+// Performs every operation synchronously during submit(). Used on platforms without a native
+// completion-based API, and as a fallback by other implementations.
+class AsyncIO_Blocking {
+private:
+    struct Op {
+        InPipe* inPipe = nullptr;
+        OutPipe* outPipe = nullptr;
+        BufferView buf;
+        void* userData = nullptr;
+    };
+
+    u32 queueDepth = 0;
+    Array<Op> queued;
+    Array<AsyncIOCompletion> completed;
+    u32 completedIndex = 0;
+
+public:
+    PLY_DLL_ENTRY AsyncIO_Blocking(u32 queueDepth = 64);
+
+    PLY_INLINE bool isNative() const {
+        return false;
+    }
+    PLY_INLINE u32 numInFlight() const {
+        return this->queued.numItems() + this->completed.numItems() - this->completedIndex;
+    }
+    PLY_INLINE bool registerBuffers(ArrayView<const BufferView>) {
+        return true;
+    }
+    PLY_DLL_ENTRY bool read(InPipe* inPipe, BufferView buf, void* userData);
+    PLY_DLL_ENTRY bool write(OutPipe* outPipe, ConstBufferView buf, void* userData);
+    PLY_DLL_ENTRY u32 submit();
+    PLY_DLL_ENTRY u32 waitCompletions(ArrayView<AsyncIOCompletion> dst, u32 minCompletions = 1);
+};
+
+} // namespace ply
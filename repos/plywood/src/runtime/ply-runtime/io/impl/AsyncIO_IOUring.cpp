@@ -0,0 +1,237 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <ply-runtime/Precomp.h>
+
+#if PLY_KERNEL_LINUX
+
+#include <ply-runtime/io/impl/AsyncIO_IOUring.h>
+#include <ply-runtime/io/impl/Pipe_FD.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+namespace ply {
+
+PLY_NO_INLINE AsyncIO_IOUring::AsyncIO_IOUring(u32 queueDepth) : fallback{queueDepth} {
+    PLY_ASSERT(queueDepth > 0);
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int) syscall(__NR_io_uring_setup, queueDepth, &params);
+    if (fd < 0)
+        return; // Not supported; use the fallback
+    this->ringFD = fd;
+    // Reading from the current file position requires Linux 5.6, as do IORING_OP_READ/WRITE:
+    if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+        this->closeRing();
+        return;
+    }
+
+    this->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+    this->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    this->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqRing = mmap(nullptr, this->sqRingSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    this->sqRing = (sqRing != MAP_FAILED) ? sqRing : nullptr;
+    void* cqRing = mmap(nullptr, this->cqRingSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    this->cqRing = (cqRing != MAP_FAILED) ? cqRing : nullptr;
+    void* sqes = mmap(nullptr, this->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd, IORING_OFF_SQES);
+    this->sqes = (sqes != MAP_FAILED) ? sqes : nullptr;
+    if (!this->sqRing || !this->cqRing || !this->sqes) {
+        this->closeRing();
+        return;
+    }
+
+    u8* sq = (u8*) this->sqRing;
+    this->sqHead = (u32*) (sq + params.sq_off.head);
+    this->sqTail = (u32*) (sq + params.sq_off.tail);
+    this->sqArray = (u32*) (sq + params.sq_off.array);
+    this->sqMask = *(u32*) (sq + params.sq_off.ring_mask);
+    this->sqEntries = params.sq_entries;
+    u8* cq = (u8*) this->cqRing;
+    this->cqHead = (u32*) (cq + params.cq_off.head);
+    this->cqTail = (u32*) (cq + params.cq_off.tail);
+    this->cqes = cq + params.cq_off.cqes;
+    this->cqMask = *(u32*) (cq + params.cq_off.ring_mask);
+    this->cqEntries = params.cq_entries;
+    this->localTail = *this->sqTail;
+    this->submittedTail = this->localTail;
+}
+
+PLY_NO_INLINE void AsyncIO_IOUring::closeRing() {
+    if (this->sqes) {
+        munmap(this->sqes, this->sqesSize);
+        this->sqes = nullptr;
+    }
+    if (this->cqRing) {
+        munmap(this->cqRing, this->cqRingSize);
+        this->cqRing = nullptr;
+    }
+    if (this->sqRing) {
+        munmap(this->sqRing, this->sqRingSize);
+        this->sqRing = nullptr;
+    }
+    if (this->ringFD >= 0) {
+        ::close(this->ringFD);
+        this->ringFD = -1;
+    }
+}
+
+PLY_NO_INLINE AsyncIO_IOUring::~AsyncIO_IOUring() {
+    // The kernel may still be writing to buffers owned by the caller, so wait for in-flight
+    // operations to complete before tearing down the ring:
+    this->submit();
+    AsyncIOCompletion completions[16];
+    while (this->numInFlight_ > 0) {
+        this->waitCompletions({completions, PLY_STATIC_ARRAY_SIZE(completions)});
+    }
+    this->closeRing();
+}
+
+PLY_NO_INLINE bool AsyncIO_IOUring::registerBuffers(ArrayView<const BufferView> bufs) {
+    if (!this->isNative())
+        return true;
+    if (this->registered.numItems() > 0) {
+        syscall(__NR_io_uring_register, this->ringFD, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        this->registered.clear();
+    }
+    if (bufs.numItems == 0)
+        return true;
+    Array<iovec> iovecs;
+    iovecs.resize(bufs.numItems);
+    for (u32 i = 0; i < bufs.numItems; i++) {
+        iovecs[i].iov_base = bufs[i].bytes;
+        iovecs[i].iov_len = bufs[i].numBytes;
+    }
+    if (syscall(__NR_io_uring_register, this->ringFD, IORING_REGISTER_BUFFERS, iovecs.begin(),
+                iovecs.numItems()) < 0)
+        return false;
+    this->registered = bufs;
+    return true;
+}
+
+PLY_NO_INLINE bool AsyncIO_IOUring::queue(u8 opcode, int fd, BufferView buf, void* userData) {
+    if (this->localTail - __atomic_load_n(this->sqHead, __ATOMIC_ACQUIRE) >= this->sqEntries)
+        return false; // Submission queue is full; call submit()
+    if (this->numInFlight_ >= this->cqEntries)
+        return false; // Completion queue could overflow; call waitCompletions()
+
+    u32 index = this->localTail & this->sqMask;
+    io_uring_sqe* sqe = (io_uring_sqe*) this->sqes + index;
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->off = (u64) -1; // Use the current file position
+    sqe->addr = (u64) (uptr) buf.bytes;
+    sqe->len = buf.numBytes;
+    sqe->user_data = (u64) (uptr) userData;
+    for (u32 i = 0; i < this->registered.numItems(); i++) {
+        const BufferView& reg = this->registered[i];
+        if (buf.bytes >= reg.bytes && buf.bytes + buf.numBytes <= reg.bytes + reg.numBytes) {
+            sqe->opcode = (opcode == IORING_OP_READ) ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+            sqe->buf_index = (u16) i;
+            break;
+        }
+    }
+    this->sqArray[index] = index;
+    this->localTail++;
+    this->numInFlight_++;
+    return true;
+}
+
+PLY_NO_INLINE bool AsyncIO_IOUring::read(InPipe* inPipe, BufferView buf, void* userData) {
+    if (this->isNative() && inPipe->funcs == &InPipe_FD::Funcs_) {
+        return this->queue(IORING_OP_READ, static_cast<InPipe_FD*>(inPipe)->fd, buf, userData);
+    }
+    return this->fallback.read(inPipe, buf, userData);
+}
+
+PLY_NO_INLINE bool AsyncIO_IOUring::write(OutPipe* outPipe, ConstBufferView buf,
+                                          void* userData) {
+    if (this->isNative() && outPipe->funcs == &OutPipe_FD::Funcs_) {
+        return this->queue(IORING_OP_WRITE, static_cast<OutPipe_FD*>(outPipe)->fd,
+                           {const_cast<u8*>(buf.bytes), buf.numBytes}, userData);
+    }
+    return this->fallback.write(outPipe, buf, userData);
+}
+
+// Publishes every SQE filled in so far and asks the kernel to consume up to toSubmit of them. The
+// kernel may consume fewer than requested, or none at all if it's short on resources (EAGAIN) or
+// would overflow the completion queue (EBUSY). Those SQEs stay in the ring and are passed to the
+// kernel again on the next call. Returns false on EAGAIN/EBUSY so that the caller can reap
+// completions before retrying.
+PLY_NO_INLINE bool AsyncIO_IOUring::enter(u32 toSubmit, u32 minComplete, u32 flags) {
+    __atomic_store_n(this->sqTail, this->localTail, __ATOMIC_RELEASE);
+    for (;;) {
+        long rc =
+            syscall(__NR_io_uring_enter, this->ringFD, toSubmit, minComplete, flags, nullptr, 0);
+        if (rc >= 0) {
+            this->submittedTail += (u32) rc;
+            return true;
+        }
+        if (errno == EAGAIN || errno == EBUSY)
+            return false;
+        if (errno != EINTR) {
+            PLY_ASSERT(0); // Shouldn't happen
+            return false;
+        }
+    }
+}
+
+PLY_NO_INLINE u32 AsyncIO_IOUring::submit() {
+    u32 numSubmitted = this->fallback.submit();
+    if (!this->isNative())
+        return numSubmitted;
+
+    u32 prevSubmittedTail = this->submittedTail;
+    if (this->localTail != prevSubmittedTail) {
+        this->enter(this->localTail - prevSubmittedTail, 0, 0);
+    }
+    return numSubmitted + (this->submittedTail - prevSubmittedTail);
+}
+
+PLY_NO_INLINE u32 AsyncIO_IOUring::waitCompletions(ArrayView<AsyncIOCompletion> dst,
+                                                   u32 minCompletions) {
+    // Synchronous completions are always ready:
+    u32 numCompletions = this->fallback.waitCompletions(dst, 0);
+    if (!this->isNative())
+        return numCompletions;
+
+    minCompletions = min(minCompletions, dst.numItems);
+    for (;;) {
+        u32 head = *this->cqHead;
+        u32 tail = __atomic_load_n(this->cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail && numCompletions < dst.numItems) {
+            const io_uring_cqe* cqe = (const io_uring_cqe*) this->cqes + (head & this->cqMask);
+            dst[numCompletions].userData = (void*) (uptr) cqe->user_data;
+            dst[numCompletions].result = cqe->res;
+            numCompletions++;
+            head++;
+            this->numInFlight_--;
+        }
+        __atomic_store_n(this->cqHead, head, __ATOMIC_RELEASE);
+
+        if (numCompletions >= minCompletions || this->numInFlight_ == 0)
+            return numCompletions;
+
+        // Block until more completions arrive, submitting any unsubmitted SQEs in the same call.
+        // Only SQEs the kernel has consumed can complete, so never wait for more than that:
+        u32 toSubmit = this->localTail - this->submittedTail;
+        u32 numPending = this->numInFlight_ - toSubmit;
+        u32 minComplete = min(minCompletions - numCompletions, numPending);
+        if (!this->enter(toSubmit, minComplete, IORING_ENTER_GETEVENTS)) {
+            // The kernel couldn't accept more SQEs. Wait for the ones it already has instead:
+            if (numPending == 0 || !this->enter(0, minComplete, IORING_ENTER_GETEVENTS))
+                return numCompletions;
+        } else if (numPending == 0 && this->localTail - this->submittedTail == toSubmit) {
+            return numCompletions; // Nothing was submitted, so nothing can complete
+        }
+    }
+}
+
+} // namespace ply
+
+#endif // PLY_KERNEL_LINUX
@@ -0,0 +1,66 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+#include <ply-runtime/io/impl/AsyncIO_Blocking.h>
+
+namespace ply {
+
+// Uses a Linux io_uring to perform operations on InPipe_FD and OutPipe_FD asynchronously.
+// Operations on other pipes, or on every pipe if the kernel doesn't support io_uring (or it's
+// blocked by a seccomp filter), are forwarded to an AsyncIO_Blocking.
+//
+// Operations read from or write to the pipe's current file position, so don't queue more than one
+// read or write at a time on the same file.
+class AsyncIO_IOUring {
+private:
+    int ringFD = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    void* sqes = nullptr;
+    ureg sqRingSize = 0;
+    ureg cqRingSize = 0;
+    ureg sqesSize = 0;
+    u32* sqHead = nullptr;
+    u32* sqTail = nullptr;
+    u32* sqArray = nullptr;
+    u32 sqMask = 0;
+    u32 sqEntries = 0;
+    u32* cqHead = nullptr;
+    u32* cqTail = nullptr;
+    void* cqes = nullptr;
+    u32 cqMask = 0;
+    u32 cqEntries = 0;
+    u32 localTail = 0;     // SQEs filled in end here
+    u32 submittedTail = 0; // SQEs consumed by the kernel end here
+    u32 numInFlight_ = 0;  // SQEs filled in whose CQEs have not yet been consumed
+    Array<BufferView> registered;
+    AsyncIO_Blocking fallback;
+
+    void closeRing();
+    bool queue(u8 opcode, int fd, BufferView buf, void* userData);
+    bool enter(u32 toSubmit, u32 minComplete, u32 flags);
+
+public:
+    PLY_DLL_ENTRY AsyncIO_IOUring(u32 queueDepth = 64);
+    PLY_DLL_ENTRY ~AsyncIO_IOUring();
+
+    // Returns false if operations are being performed synchronously.
+    PLY_INLINE bool isNative() const {
+        return this->ringFD >= 0;
+    }
+    PLY_INLINE u32 numInFlight() const {
+        return this->numInFlight_ + this->fallback.numInFlight();
+    }
+    // Registers buffers with the kernel. Subsequent operations whose buffer lies entirely within a
+    // registered buffer avoid the cost of mapping its pages on each operation.
+    PLY_DLL_ENTRY bool registerBuffers(ArrayView<const BufferView> bufs);
+    PLY_DLL_ENTRY bool read(InPipe* inPipe, BufferView buf, void* userData);
+    PLY_DLL_ENTRY bool write(OutPipe* outPipe, ConstBufferView buf, void* userData);
+    PLY_DLL_ENTRY u32 submit();
+    PLY_DLL_ENTRY u32 waitCompletions(ArrayView<AsyncIOCompletion> dst, u32 minCompletions = 1);
+};
+
+} // namespace ply
@@ -10,6 +10,9 @@
 
 namespace ply {
 
+// Maximum number of iovecs passed to a single readv()/writev() call:
+static const u32 MaxIOVecs = 64;
+
 PLY_NO_INLINE void InPipe_FD_destroy(InPipe* inPipe_) {
     InPipe_FD* inPipe = static_cast<InPipe_FD*>(inPipe_);
     if (inPipe->fd >= 0) {
@@ -27,7 +30,9 @@ PLY_NO_INLINE u32 InPipe_FD_readSome(InPipe* inPipe_, BufferView buf) {
     do {
         rc = (s32)::read(inPipe->fd, buf.bytes, buf.numBytes);
     } while (rc == -1 && errno == EINTR);
-    PLY_ASSERT(rc >= 0); // Note: Will probably need to detect closed pipes here
+    inPipe->wouldBlock = (rc == -1 && (errno == EAGAIN || errno == EWOULDBLOCK));
+    // Note: Will probably need to detect closed pipes here
+    PLY_ASSERT(rc >= 0 || inPipe->wouldBlock);
     if (rc < 0)
         return 0;
     return rc;
@@ -43,15 +48,50 @@ PLY_NO_INLINE u64 InPipe_FD_getFileSize(const InPipe* inPipe_) {
     return buf.st_size;
 }
 
+PLY_NO_INLINE u32 InPipe_FD_readSomeVectored(InPipe* inPipe_, ArrayView<const BufferView> bufs) {
+    InPipe_FD* inPipe = static_cast<InPipe_FD*>(inPipe_);
+    PLY_ASSERT(inPipe->fd >= 0);
+    struct iovec iov[MaxIOVecs];
+    u32 numIOVecs = min(bufs.numItems, MaxIOVecs);
+    for (u32 i = 0; i < numIOVecs; i++) {
+        iov[i].iov_base = bufs[i].bytes;
+        iov[i].iov_len = bufs[i].numBytes;
+    }
+    // Retry as long as readv() keeps failing due to EINTR caused by the debugger:
+    s32 rc;
+    do {
+        rc = (s32)::readv(inPipe->fd, iov, (int) numIOVecs);
+    } while (rc == -1 && errno == EINTR);
+    inPipe->wouldBlock = (rc == -1 && (errno == EAGAIN || errno == EWOULDBLOCK));
+    // Note: Will probably need to detect closed pipes here
+    PLY_ASSERT(rc >= 0 || inPipe->wouldBlock);
+    if (rc < 0)
+        return 0;
+    return rc;
+}
+
 InPipe::Funcs InPipe_FD::Funcs_ = {
     InPipe_FD_destroy,
     InPipe_FD_readSome,
     InPipe_FD_getFileSize,
+    InPipe_FD_readSomeVectored,
 };
 
 PLY_NO_INLINE InPipe_FD::InPipe_FD(int fd) : InPipe{&Funcs_}, fd{fd} {
 }
 
+PLY_NO_INLINE bool InPipe_FD::setNonBlocking(bool nonBlocking) {
+    PLY_ASSERT(this->fd >= 0);
+    int flags = ::fcntl(this->fd, F_GETFL);
+    if (flags == -1)
+        return false;
+    flags = nonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    if (::fcntl(this->fd, F_SETFL, flags) == -1)
+        return false;
+    this->isNonBlocking = nonBlocking;
+    return true;
+}
+
 PLY_NO_INLINE void OutPipe_FD_destroy(OutPipe* outPipe_) {
     OutPipe_FD* outPipe = static_cast<OutPipe_FD*>(outPipe_);
     if (outPipe->fd >= 0) {
@@ -105,11 +145,45 @@ PLY_NO_INLINE u64 OutPipe_FD_seek(OutPipe* outPipe_, s64 pos, SeekDir seekDir) {
     return rc;
 }
 
+PLY_NO_INLINE bool OutPipe_FD_writeVectored(OutPipe* outPipe_,
+                                           ArrayView<const ConstBufferView> bufs) {
+    OutPipe_FD* outPipe = static_cast<OutPipe_FD*>(outPipe_);
+    PLY_ASSERT(outPipe->fd >= 0);
+    struct iovec iov[MaxIOVecs];
+    while (bufs.numItems > 0) {
+        u32 numIOVecs = min(bufs.numItems, MaxIOVecs);
+        for (u32 i = 0; i < numIOVecs; i++) {
+            iov[i].iov_base = (void*) bufs[i].bytes;
+            iov[i].iov_len = bufs[i].numBytes;
+        }
+        bufs.offsetHead(numIOVecs);
+
+        // Resubmit the remainder after a partial write:
+        struct iovec* curIOVec = iov;
+        while (numIOVecs > 0) {
+            sreg sent = ::writev(outPipe->fd, curIOVec, (int) numIOVecs);
+            if (sent <= 0)
+                return false;
+            while (numIOVecs > 0 && (ureg) sent >= curIOVec->iov_len) {
+                sent -= curIOVec->iov_len;
+                curIOVec++;
+                numIOVecs--;
+            }
+            if (numIOVecs > 0) {
+                curIOVec->iov_base = (u8*) curIOVec->iov_base + sent;
+                curIOVec->iov_len -= sent;
+            }
+        }
+    }
+    return true;
+}
+
 OutPipe::Funcs OutPipe_FD::Funcs_ = {
     OutPipe_FD_destroy,
     OutPipe_FD_write,
     OutPipe_FD_flush,
     OutPipe_FD_seek,
+    OutPipe_FD_writeVectored,
 };
 
 PLY_NO_INLINE OutPipe_FD::OutPipe_FD(int fd) : OutPipe{&Funcs_}, fd{fd} {
@@ -9,6 +9,8 @@
 #include <errno.h>
 #include <sys/stat.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <fcntl.h>
 
 namespace ply {
 
@@ -20,6 +22,8 @@ struct InPipe_FD : InPipe {
     int fd = -1;
 
     PLY_DLL_ENTRY InPipe_FD(int fd);
+    // In non-blocking mode, readSome() returns 0 and sets wouldBlock when no data is available.
+    PLY_DLL_ENTRY bool setNonBlocking(bool nonBlocking);
 };
 
 //------------------------------------------------------------------
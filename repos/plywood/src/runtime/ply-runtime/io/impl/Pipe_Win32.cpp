@@ -44,6 +44,7 @@ InPipe::Funcs InPipe_Win32::Funcs_ = {
     InPipe_Win32_destroy,
     InPipe_Win32_readSome,
     InPipe_Win32_getFileSize,
+    InPipe::readSomeVectored_Default,
 };
 
 PLY_NO_INLINE InPipe_Win32::InPipe_Win32(HANDLE handle) : InPipe{&Funcs_}, handle{handle} {
@@ -127,6 +128,7 @@ OutPipe::Funcs OutPipe_Win32::Funcs_ = {
     OutPipe_Win32_write,
     OutPipe_Win32_flush,
     OutPipe_Win32_seek,
+    OutPipe::writeVectored_Default,
 };
 
 PLY_NO_INLINE OutPipe_Win32::OutPipe_Win32(HANDLE handle) : OutPipe{&Funcs_}, handle{handle} {
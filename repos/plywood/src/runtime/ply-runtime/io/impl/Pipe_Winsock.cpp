@@ -32,6 +32,7 @@ InPipe::Funcs InPipe_Winsock::Funcs_ = {
     InPipe_Winsock_destroy,
     InPipe_Winsock_readSome,
     InPipe::getFileSize_Unsupported,
+    InPipe::readSomeVectored_Default,
 };
 
 PLY_NO_INLINE InPipe_Winsock::InPipe_Winsock(SOCKET socket) : InPipe{&Funcs_}, socket{socket} {
@@ -73,6 +74,7 @@ OutPipe::Funcs OutPipe_Winsock::Funcs_ = {
     OutPipe_Winsock_write,
     OutPipe_Winsock_flush,
     OutPipe::seek_Empty,
+    OutPipe::writeVectored_Default,
 };
 
 PLY_NO_INLINE OutPipe_Winsock::OutPipe_Winsock(SOCKET socket) : OutPipe{&Funcs_}, socket{socket} {
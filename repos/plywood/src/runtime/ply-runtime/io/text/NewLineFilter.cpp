@@ -4,9 +4,46 @@
 ------------------------------------*/
 #include <ply-runtime/Precomp.h>
 #include <ply-runtime/io/text/NewLineFilter.h>
+#if PLY_CPU_X64 || PLY_CPU_X86
+#include <emmintrin.h>
+#elif PLY_CPU_ARM64
+#include <arm_neon.h>
+#endif
 
 namespace ply {
 
+// Returns a pointer to the first byte in [cur, end) that NewLineFilter must translate: '\r', or
+// '\n' if writing CRLF. Returns end if there is no such byte.
+static PLY_INLINE const u8* findNewLineByte(const u8* cur, const u8* end, bool crlf) {
+#if PLY_CPU_X64 || PLY_CPU_X86
+    __m128i vCR = _mm_set1_epi8('\r');
+    __m128i vLF = _mm_set1_epi8(crlf ? '\n' : '\r');
+    for (; end - cur >= 16; cur += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) cur);
+        __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v, vCR), _mm_cmpeq_epi8(v, vLF));
+        u32 bits = (u32) _mm_movemask_epi8(eq);
+        if (bits != 0)
+            return cur + countTrailingZeros(bits);
+    }
+#elif PLY_CPU_ARM64
+    uint8x16_t vCR = vdupq_n_u8('\r');
+    uint8x16_t vLF = vdupq_n_u8(crlf ? '\n' : '\r');
+    for (; end - cur >= 16; cur += 16) {
+        uint8x16_t v = vld1q_u8(cur);
+        uint8x16_t eq = vorrq_u8(vceqq_u8(v, vCR), vceqq_u8(v, vLF));
+        // Narrow each byte of the comparison result to 4 bits of a u64
+        u64 bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        if (bits != 0)
+            return cur + (countTrailingZeros(bits) >> 2);
+    }
+#endif
+    for (; cur < end; cur++) {
+        if (*cur == '\r' || (crlf && *cur == '\n'))
+            break;
+    }
+    return cur;
+}
+
 struct NewLineFilter {
     struct Params {
         const u8* srcByte = nullptr;
@@ -21,27 +58,34 @@ struct NewLineFilter {
 
     void process(Params* params) {
         while (params->dstByte < params->dstEndByte) {
-            u8 c = 0;
             if (this->needsLF) {
-                c = '\n';
+                *params->dstByte++ = '\n';
                 this->needsLF = false;
-            } else {
-                for (;;) {
-                    if (params->srcByte >= params->srcEndByte)
-                        return; // src has been consumed
-                    c = *params->srcByte++;
-                    if (c == '\r') {
-                        // Output nothing
-                    } else {
-                        if (c == '\n' && this->crlf) {
-                            c = '\r';
-                            this->needsLF = true;
-                        }
-                        break;
-                    }
-                }
+                continue;
+            }
+            if (params->srcByte >= params->srcEndByte)
+                return; // src has been consumed
+
+            // Copy bytes that don't need to be translated in bulk
+            u32 maxRunBytes = safeDemote<u32>(min(params->srcEndByte - params->srcByte,
+                                                  params->dstEndByte - params->dstByte));
+            const u8* found =
+                findNewLineByte(params->srcByte, params->srcByte + maxRunBytes, this->crlf);
+            u32 runBytes = safeDemote<u32>(found - params->srcByte);
+            memcpy(params->dstByte, params->srcByte, runBytes);
+            params->srcByte += runBytes;
+            params->dstByte += runBytes;
+            if (runBytes == maxRunBytes)
+                continue;
+
+            // There's room for at least one more byte in dst
+            u8 c = *params->srcByte++;
+            if (c == '\n') {
+                // Only happens when writing CRLF
+                *params->dstByte++ = '\r';
+                this->needsLF = true;
             }
-            *params->dstByte++ = c;
+            // '\r' outputs nothing
         }
     }
 };
@@ -87,6 +131,7 @@ InPipe::Funcs InPipe_NewLineFilter::Funcs_ = {
     InPipe_NewLineFilter_destroy,
     InPipe_NewLineFilter_readSome,
     InPipe::getFileSize_Unsupported,
+    InPipe::readSomeVectored_Default,
 };
 
 PLY_NO_INLINE InPipe_NewLineFilter::InPipe_NewLineFilter() : InPipe{&Funcs_} {
@@ -149,6 +194,7 @@ OutPipe::Funcs OutPipe_NewLineFilter::Funcs_ = {
     OutPipe_NewLineFilter_write,
     OutPipe_NewLineFilter_flush,
     OutPipe::seek_Empty,
+    OutPipe::writeVectored_Default,
 };
 
 PLY_NO_INLINE OutPipe_NewLineFilter::OutPipe_NewLineFilter() : OutPipe{&Funcs_} {
@@ -6,7 +6,15 @@
 #include <ply-runtime/io/text/StringReader.h>
 #include <ply-runtime/container/Tuple.h>
 #include <ply-runtime/io/OutStream.h>
+#include <ply-runtime/io/text/details/FloatConversion.h>
 #include <math.h> // for pow
+#include <float.h>
+#include <stdlib.h> // for strtod
+#if PLY_CPU_X64 || PLY_CPU_X86
+#include <emmintrin.h>
+#elif PLY_CPU_ARM64
+#include <arm_neon.h>
+#endif
 
 namespace ply {
 
@@ -38,23 +46,170 @@ PLY_INLINE bool match(u8 c, const u32* mask) {
     return (bitValue != 0);
 }
 
-PLY_NO_INLINE void fmt::scanUsingMask(InStream* ins, const u32* mask, bool invert) {
+//----------------------------------------------------------
+// Vectorized mask scanning
+//----------------------------------------------------------
+// The set bits of a 256-bit mask, converted to a short list of byte ranges so that 16 bytes at a
+// time can be tested using SIMD instructions. A byte c is in range r if (u8) (c - lo[r]) <=
+// width[r]; with unsigned saturating arithmetic, that's a subtract followed by a compare with zero.
+#if PLY_CPU_X64 || PLY_CPU_X86 || PLY_CPU_ARM64
+#define PLY_SIMD_SCAN 1
+#if PLY_CPU_ARM64
+typedef uint8x16_t SIMDBytes;
+#else
+typedef __m128i SIMDBytes;
+#endif
+
+struct ByteRanges {
+    static constexpr u32 MaxRanges = 8;
+    u32 numRanges;
+    SIMDBytes lo[MaxRanges];
+    SIMDBytes width[MaxRanges];
+};
+
+PLY_INLINE SIMDBytes splatByte(u8 v) {
+#if PLY_CPU_ARM64
+    return vdupq_n_u8(v);
+#else
+    return _mm_set1_epi8((char) v);
+#endif
+}
+
+// Returns false if the mask has too many ranges to be worth scanning this way.
+static PLY_NO_INLINE bool getByteRanges(ByteRanges* ranges, const u32* mask) {
+    ranges->numRanges = 0;
+    u32 prevBit = 0;
+    u32 lo = 0;
+    for (u32 i = 0; i < 8; i++) {
+        // Each set bit in transitions marks the start or end of a range
+        u32 transitions = mask[i] ^ ((mask[i] << 1) | prevBit);
+        while (transitions != 0) {
+            u32 c = i * 32 + countTrailingZeros(transitions);
+            if (match((u8) c, mask)) {
+                lo = c;
+            } else {
+                if (ranges->numRanges >= ByteRanges::MaxRanges)
+                    return false;
+                ranges->lo[ranges->numRanges] = splatByte((u8) lo);
+                ranges->width[ranges->numRanges] = splatByte((u8)(c - 1 - lo));
+                ranges->numRanges++;
+            }
+            transitions &= transitions - 1;
+        }
+        prevBit = mask[i] >> 31;
+    }
+    if (prevBit != 0) {
+        if (ranges->numRanges >= ByteRanges::MaxRanges)
+            return false;
+        ranges->lo[ranges->numRanges] = splatByte((u8) lo);
+        ranges->width[ranges->numRanges] = splatByte((u8)(255 - lo));
+        ranges->numRanges++;
+    }
+    return true;
+}
+
+// Most scans reuse one of a few masks, so remember the ranges for the last mask used on each
+// thread. Zero-initialized; isValid is false if the mask had too many ranges.
+struct ByteRangesCache {
+    u32 mask[8];
+    bool isValid;
+    ByteRanges ranges;
+};
+static PLY_THREAD_LOCAL ByteRangesCache lastByteRanges;
+
+static PLY_NO_INLINE const ByteRanges* getCachedByteRanges(const u32* mask) {
+    ByteRangesCache* cache = &lastByteRanges;
+    if (memcmp(cache->mask, mask, sizeof(cache->mask)) != 0) {
+        memcpy(cache->mask, mask, sizeof(cache->mask));
+        cache->isValid = getByteRanges(&cache->ranges, mask);
+    }
+    return cache->isValid ? &cache->ranges : nullptr;
+}
+
+// Returns a pointer to the first byte in [cur, end) whose membership in ranges equals stopIfIn, or
+// the start of the final partial 16-byte block if there is no such byte before it.
+static PLY_NO_INLINE const u8* scanRanges(const u8* cur, const u8* end, const ByteRanges& ranges,
+                                          bool stopIfIn) {
+    while (end - cur >= 16) {
+#if PLY_CPU_ARM64
+        uint8x16_t v = vld1q_u8(cur);
+        uint8x16_t inRanges = vdupq_n_u8(0);
+        for (u32 r = 0; r < ranges.numRanges; r++) {
+            uint8x16_t d = vqsubq_u8(vsubq_u8(v, ranges.lo[r]), ranges.width[r]);
+            inRanges = vorrq_u8(inRanges, vceqzq_u8(d));
+        }
+        uint8x16_t stop = stopIfIn ? inRanges : vmvnq_u8(inRanges);
+        // Narrow each byte of the comparison result to 4 bits of a u64
+        u64 bits =
+            vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(stop), 4)), 0);
+        if (bits != 0)
+            return cur + (countTrailingZeros(bits) >> 2);
+#else
+        __m128i v = _mm_loadu_si128((const __m128i*) cur);
+        __m128i inRanges = _mm_setzero_si128();
+        for (u32 r = 0; r < ranges.numRanges; r++) {
+            __m128i d = _mm_subs_epu8(_mm_sub_epi8(v, ranges.lo[r]), ranges.width[r]);
+            inRanges = _mm_or_si128(inRanges, _mm_cmpeq_epi8(d, _mm_setzero_si128()));
+        }
+        u32 bits = (u32) _mm_movemask_epi8(inRanges);
+        if (!stopIfIn) {
+            bits ^= 0xffff;
+        }
+        if (bits != 0)
+            return cur + countTrailingZeros(bits);
+#endif
+        cur += 16;
+    }
+    return cur;
+}
+#endif // PLY_CPU_X64 || PLY_CPU_X86 || PLY_CPU_ARM64
+
+// Advances ins past every byte whose membership in mask differs from invert.
+static PLY_NO_INLINE void scanMask(InStream* ins, const u32* mask, bool invert) {
     for (;;) {
         if (!ins->tryMakeBytesAvailable())
             break;
-        if (match(ins->peekByte(), mask) == invert)
+        const u8* cur = ins->curByte;
+        const u8* end = ins->endByte;
+        // Short runs are common (such as a single space between tokens), so test the first few
+        // bytes one at a time before setting up the vectorized scan.
+        const u8* scalarEnd = cur + min<uptr>(end - cur, 4);
+        while (cur < scalarEnd && match(*cur, mask) != invert) {
+            cur++;
+        }
+#if PLY_SIMD_SCAN
+        if (cur == scalarEnd && cur < end) {
+            if (const ByteRanges* ranges = getCachedByteRanges(mask)) {
+                cur = scanRanges(cur, end, *ranges, invert);
+            }
+        }
+#endif
+        while (cur < end && match(*cur, mask) != invert) {
+            cur++;
+        }
+        ins->curByte = (u8*) cur;
+        if (cur < end)
             break;
-        ins->advanceByte();
     }
 }
 
+PLY_NO_INLINE void fmt::scanUsingMask(InStream* ins, const u32* mask, bool invert) {
+    scanMask(ins, mask, invert);
+}
+
 PLY_NO_INLINE void fmt::scanUsingCallback(InStream* ins, const LambdaView<bool(char)>& callback) {
     for (;;) {
         if (!ins->tryMakeBytesAvailable())
             break;
-        if (!callback(ins->peekByte()))
+        // Walk the buffered bytes directly instead of going through the stream for each one
+        const u8* cur = ins->curByte;
+        const u8* end = ins->endByte;
+        while (cur < end && callback(*cur)) {
+            cur++;
+        }
+        ins->curByte = (u8*) cur;
+        if (cur < end)
             break;
-        ins->advanceByte();
     }
 }
 
@@ -65,15 +220,34 @@ PLY_NO_INLINE bool fmt::scanUpToAndIncludingSpecial(InStream* ins, StringView sp
     for (;;) {
         if (!ins->tryMakeBytesAvailable())
             break;
-        u8 c = ins->peekByte();
-        ins->advanceByte();
-        if (c == (u8) special.bytes[matchedUnits]) {
-            matchedUnits++;
-            if (matchedUnits >= special.numBytes)
+        const u8* cur = ins->curByte;
+        const u8* end = ins->endByte;
+        while (cur < end) {
+            if (matchedUnits == 0) {
+                // Use memchr to skip ahead to the next occurrence of the first letter. memchr is
+                // vectorized by every major C runtime.
+                cur = (const u8*) memchr(cur, special.bytes[0], end - cur);
+                if (!cur) {
+                    cur = end;
+                    break;
+                }
+                cur++;
+                matchedUnits = 1;
+            } else if (*cur == (u8) special.bytes[matchedUnits]) {
+                cur++;
+                matchedUnits++;
+            } else {
+                // Partial match failed. Since the first letter doesn't reoccur in special, the
+                // current byte can only start a new match, so let memchr look at it again.
+                matchedUnits = 0;
+                continue;
+            }
+            if (matchedUnits >= special.numBytes) {
+                ins->curByte = (u8*) cur;
                 return true;
-        } else {
-            matchedUnits = 0;
+            }
         }
+        ins->curByte = (u8*) cur;
     }
     // special wasn't found
     ins->status.parseError = 1;
@@ -88,20 +262,30 @@ PLY_NO_INLINE u64 fmt::TypeParser<u64>::parse(InStream* ins, Radix radix) {
     u64 result = 0;
     bool anyDigits = false;
     bool overflow = false;
-    for (;;) {
-        if (!ins->tryMakeBytesAvailable())
-            break;
-        u8 digit = fmt::DigitTable[(u8) ins->peekByte()];
-        if (digit >= radix.base)
-            break;
-        ins->advanceByte();
-        u64 withNextDigit = result * radix.base + digit;
-        if (withNextDigit < result) {
-            // overflow error
-            overflow = true;
+    const u64 maxBeforeMultiply =
+        (radix.base == 10) ? Limits<u64>::Max / 10 : Limits<u64>::Max / radix.base;
+    while (ins->tryMakeBytesAvailable()) {
+        // Consume as many digits as possible directly from the input buffer
+        const u8* start = ins->curByte;
+        const u8* cur = start;
+        const u8* end = ins->endByte;
+        for (; cur < end; cur++) {
+            u8 digit = fmt::DigitTable[*cur];
+            if (digit >= radix.base)
+                break;
+            if (result > maxBeforeMultiply) {
+                overflow = true;
+            }
+            u64 multiplied = result * radix.base;
+            result = multiplied + digit;
+            if (result < multiplied) {
+                overflow = true;
+            }
         }
-        result = withNextDigit;
-        anyDigits = true;
+        ins->curByte = (u8*) cur;
+        anyDigits |= (cur != start);
+        if (cur < end)
+            break;
     }
     if (!anyDigits || overflow) {
         ins->status.parseError = 1;
@@ -155,8 +339,250 @@ PLY_NO_INLINE void readDoubleComponent(DoubleComponentOut* compOut, InStream* in
     compOut->result = value;
 }
 
+PLY_INLINE bool isDecimalDigit(u8 c) {
+    return u8(c - '0') < 10;
+}
+
+#if !PLY_IS_BIG_ENDIAN
+// Checks whether 8 bytes loaded from memory are all ASCII digits.
+PLY_INLINE bool isEightDigits(u64 v) {
+    return (((v & 0xf0f0f0f0f0f0f0f0) | (((v + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) ==
+            0x3333333333333333);
+}
+
+// Converts 8 ASCII digits loaded from memory to an integer using SWAR arithmetic, which avoids a
+// long chain of dependent multiplies.
+PLY_INLINE u32 parseEightDigits(u64 v) {
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8); // combine adjacent digits into pairs
+    v = (((v & 0x000000ff000000ff) * (100 + (1000000ull << 32))) +
+         (((v >> 16) & 0x000000ff000000ff) * (1 + (10000ull << 32)))) >>
+        32;
+    return u32(v);
+}
+#endif
+
+// Accumulates the digits in [cur, end) into mantissa. There must be at most 19 digits in total.
+PLY_INLINE u64 accumulateDigits(u64 mantissa, const u8* cur, const u8* end) {
+#if !PLY_IS_BIG_ENDIAN
+    for (; end - cur >= 8; cur += 8) {
+        u64 v;
+        memcpy(&v, cur, 8);
+        mantissa = mantissa * 100000000 + parseEightDigits(v);
+    }
+#endif
+    for (; cur < end; cur++) {
+        mantissa = mantissa * 10 + u32(*cur - '0');
+    }
+    return mantissa;
+}
+
+static const double ExactPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Converts mantissa * 10^exp10 to a correctly rounded double, using an exact floating-point
+// multiply or divide when possible and the Eisel-Lemire algorithm otherwise. If truncated is true,
+// nonzero digits were dropped from the end of mantissa. text contains the original input, and is
+// passed to strtod if neither method can decide the result.
+static PLY_NO_INLINE double convertDecimal(u64 mantissa, s32 exp10, bool truncated,
+                                           ConstBufferView text) {
+    double value = 0;
+    if (mantissa == 0)
+        return value;
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+    if (!truncated && mantissa <= (u64(1) << 53) && exp10 >= -22 && exp10 <= 22) {
+        // Both operands are exact, so the result is correctly rounded
+        value = (double) mantissa;
+        return (exp10 < 0) ? value / ExactPowersOfTen[-exp10] : value * ExactPowersOfTen[exp10];
+    }
+#endif
+    bool ok = details::decimalToDouble(&value, mantissa, exp10);
+    if (ok && truncated) {
+        // The dropped digits put the exact value between mantissa and mantissa + 1
+        double upper = 0;
+        ok = details::decimalToDouble(&upper, mantissa + 1, exp10) && (upper == value);
+    }
+    char nullTerminated[128];
+    if (!ok && text.numBytes < PLY_STATIC_ARRAY_SIZE(nullTerminated)) {
+        memcpy(nullTerminated, text.bytes, text.numBytes);
+        nullTerminated[text.numBytes] = 0;
+        value = fabs(strtod(nullTerminated, nullptr));
+    }
+    return value;
+}
+
+// General version of parseDecimalDouble that reads one byte at a time, for numbers that span
+// multiple chunks of input or that have more than 19 significant digits.
+static PLY_NO_INLINE double parseDecimalDoubleSlowPath(InStream* ins) {
+    char text[128]; // consumed characters, for the strtod fallback
+    u32 textLength = 0;
+    auto consume = [&](char c) {
+        if (textLength < PLY_STATIC_ARRAY_SIZE(text)) {
+            text[textLength] = c;
+        }
+        textLength++;
+        ins->advanceByte();
+    };
+
+    // Parse the optional minus sign
+    bool negate = false;
+    if (ins->tryMakeBytesAvailable() && ins->peekByte() == '-') {
+        consume('-');
+        negate = true;
+    }
+
+    // Parse the mantissa and optional fractional part, keeping up to 19 significant digits
+    u64 mantissa = 0;
+    u32 numSignificantDigits = 0;
+    s32 exp10 = 0;
+    bool truncated = false;
+    bool anyDigits = false;
+    bool fractional = false;
+    while (ins->tryMakeBytesAvailable()) {
+        char c = ins->peekByte();
+        if (!isDecimalDigit(c)) {
+            if (c == '.' && !fractional) {
+                consume(c);
+                fractional = true;
+                continue;
+            }
+            break;
+        }
+        consume(c);
+        u32 digit = u32(c - '0');
+        anyDigits |= !fractional;
+        if (numSignificantDigits < 19) {
+            mantissa = mantissa * 10 + digit;
+            numSignificantDigits += (mantissa != 0);
+            exp10 -= fractional;
+        } else {
+            truncated |= (digit != 0);
+            exp10 += !fractional;
+        }
+    }
+
+    // Parse optional exponent suffix
+    if (anyDigits && ins->tryMakeBytesAvailable() && (ins->peekByte() | 0x20) == 'e') {
+        consume(ins->peekByte());
+        bool negateExp = false;
+        if (ins->tryMakeBytesAvailable()) {
+            if (ins->peekByte() == '+') {
+                consume('+');
+            } else if (ins->peekByte() == '-') {
+                consume('-');
+                negateExp = true;
+            }
+        }
+        anyDigits = false;
+        s32 exponent = 0;
+        while (ins->tryMakeBytesAvailable() && isDecimalDigit(ins->peekByte())) {
+            char c = ins->peekByte();
+            consume(c);
+            anyDigits = true;
+            if (exponent < 100000) {
+                exponent = exponent * 10 + (c - '0');
+            }
+        }
+        exp10 += negateExp ? -exponent : exponent;
+    }
+
+    if (!anyDigits) {
+        ins->status.parseError = true;
+    }
+    double value = convertDecimal(mantissa, exp10, truncated, {text, textLength});
+    return negate ? -value : value;
+}
+
+// Parses a base 10 number with correct rounding. When the entire number is already in the input
+// buffer, it's first scanned to find the extent of each part, then the digits are converted.
+static PLY_NO_INLINE double parseDecimalDouble(InStream* ins) {
+    const u8* start = ins->curByte;
+    const u8* end = ins->endByte;
+    const u8* cur = start;
+
+    // Scan the optional minus sign, mantissa and fractional part
+    bool negate = (cur < end && *cur == '-');
+    cur += negate;
+    const u8* intStart = cur;
+    while (cur < end && isDecimalDigit(*cur)) {
+        cur++;
+    }
+    const u8* intEnd = cur;
+    const u8* fracStart = cur;
+    if (cur < end && *cur == '.') {
+        cur++;
+        fracStart = cur;
+        while (cur < end && isDecimalDigit(*cur)) {
+            cur++;
+        }
+    }
+    const u8* fracEnd = cur;
+
+    // Scan optional exponent suffix
+    bool anyDigits = (intEnd != intStart);
+    s32 exponent = 0;
+    if (anyDigits && cur < end && (*cur | 0x20) == 'e') {
+        cur++;
+        bool negateExp = false;
+        if (cur < end && (*cur == '+' || *cur == '-')) {
+            negateExp = (*cur == '-');
+            cur++;
+        }
+        const u8* expStart = cur;
+        for (; cur < end && isDecimalDigit(*cur); cur++) {
+            if (exponent < 100000) {
+                exponent = exponent * 10 + (*cur - '0');
+            }
+        }
+        anyDigits = (cur != expStart);
+        exponent = negateExp ? -exponent : exponent;
+    }
+
+    // Skip leading zeros, which aren't significant
+    const u8* sigStart = intStart;
+    while (sigStart < intEnd && *sigStart == '0') {
+        sigStart++;
+    }
+    bool intIsZero = (sigStart == intEnd);
+    if (intIsZero) {
+        sigStart = fracStart;
+        while (sigStart < fracEnd && *sigStart == '0') {
+            sigStart++;
+        }
+    }
+    uptr numSignificantDigits =
+        intIsZero ? fracEnd - sigStart : (intEnd - sigStart) + (fracEnd - fracStart);
+
+    if ((cur == end && !ins->isView()) || numSignificantDigits > 19) {
+        // The number might continue in the next chunk, or has too many digits for a u64
+        return parseDecimalDoubleSlowPath(ins);
+    }
+
+    u64 mantissa;
+    if (intIsZero) {
+        mantissa = accumulateDigits(0, sigStart, fracEnd);
+    } else {
+        mantissa = accumulateDigits(0, sigStart, intEnd);
+        mantissa = accumulateDigits(mantissa, fracStart, fracEnd);
+    }
+    ins->curByte = (u8*) cur;
+    if (cur == end) {
+        ins->tryMakeBytesAvailable(); // sets EOF flag, as the slow path would
+    }
+    if (!anyDigits) {
+        ins->status.parseError = true;
+    }
+    double value = convertDecimal(mantissa, exponent - s32(fracEnd - fracStart), false,
+                                  ConstBufferView::fromRange(start, cur));
+    return negate ? -value : value;
+}
+
 PLY_NO_INLINE double fmt::TypeParser<double>::parse(InStream* ins, Radix radix) {
     PLY_ASSERT(radix.base > 0 && radix.base <= 36);
+    if (radix.base == 10)
+        return parseDecimalDouble(ins);
+
     DoubleComponentOut comp;
 
     // Parse the optional minus sign
@@ -378,23 +804,14 @@ bool fmt::FormatParser<fmt::Identifier>::parse(InStream* ins, const fmt::Identif
         mask[1] |= 0x2000; // '-'
     }
 
-    bool first = true;
-    for (;;) {
-        if (!ins->tryMakeBytesAvailable())
-            break;
-        if (!match(ins->peekByte(), mask))
-            break;
-        if (first) {
-            mask[1] |= 0x3ff0000; // accept digits after first unit
-            first = false;
-        };
-        ins->advanceByte();
-    }
-
-    if (mask[1] == 0) {
+    // The first unit can't be a digit
+    if (!ins->tryMakeBytesAvailable() || !match(ins->peekByte(), mask)) {
         ins->status.parseError = 1;
         return false;
     }
+    ins->advanceByte();
+    mask[1] |= 0x3ff0000; // accept digits after first unit
+    scanMask(ins, mask, false);
     return true;
 }
 
@@ -233,6 +233,7 @@ struct StringViewReader : StringReader {
         // By setting this flag, the compiler is able to optimize out the call to the InStream
         // destructor:
         this->status.type = (u32) InStream::Type::View;
+        this->status.isMapped = 0;
     }
 
     PLY_INLINE ViewInStream::SavePoint savePoint() const {
@@ -5,6 +5,7 @@
 #include <ply-runtime/Precomp.h>
 #include <ply-runtime/io/text/StringWriter.h>
 #include <ply-runtime/string/TextEncoding.h>
+#include <ply-runtime/io/text/details/FloatConversion.h>
 #include <math.h>
 
 namespace ply {
@@ -16,12 +17,37 @@ PLY_INLINE u8 toDigit(u32 d) {
     return (d <= 35) ? "0123456789abcdefghijklmnopqrstuvwxyz"[d] : '?';
 }
 
+static const char DecimalDigitPairs[] = "00010203040506070809"
+                                       "10111213141516171819"
+                                       "20212223242526272829"
+                                       "30313233343536373839"
+                                       "40414243444546474849"
+                                       "50515253545556575859"
+                                       "60616263646566676869"
+                                       "70717273747576777879"
+                                       "80818283848586878889"
+                                       "90919293949596979899";
+
 PLY_NO_INLINE void printString(OutStream* outs, u64 value, u32 radix) {
     PLY_ASSERT(radix >= 2);
     u8 digitBuffer[64];
     s32 digitIndex = PLY_STATIC_ARRAY_SIZE(digitBuffer);
 
-    if (value == 0) {
+    if (radix == 10) {
+        // Emit two digits per division
+        while (value >= 100) {
+            u32 pair = u32(value % 100);
+            value /= 100;
+            digitIndex -= 2;
+            memcpy(digitBuffer + digitIndex, DecimalDigitPairs + pair * 2, 2);
+        }
+        if (value >= 10) {
+            digitIndex -= 2;
+            memcpy(digitBuffer + digitIndex, DecimalDigitPairs + value * 2, 2);
+        } else {
+            digitBuffer[--digitIndex] = u8('0' + value);
+        }
+    } else if (value == 0) {
         digitBuffer[--digitIndex] = '0';
     } else {
         while (value > 0) {
@@ -45,8 +71,67 @@ PLY_NO_INLINE void printString(OutStream* outs, s64 value, u32 radix) {
     }
 }
 
+// Writes digits * 10^exp10 using fixed-point notation when the decimal point falls within a
+// reasonable range, and scientific notation otherwise. The output always contains a '.' or 'e'.
+static void printDecimalDigits(OutStream* outs, const details::DecimalDigits& dd) {
+    s32 numDigits = (s32) dd.numDigits;
+    s32 pointPos = numDigits + dd.exp10; // position of the decimal point relative to digits
+    if (pointPos > 0 && pointPos <= 21) {
+        if (dd.exp10 >= 0) {
+            outs->write({dd.digits, dd.numDigits});
+            for (s32 i = 0; i < dd.exp10; i++) {
+                outs->writeByte('0');
+            }
+            outs->write({".0", 2});
+        } else {
+            outs->write({dd.digits, (u32) pointPos});
+            outs->writeByte('.');
+            outs->write({dd.digits + pointPos, u32(numDigits - pointPos)});
+        }
+    } else if (pointPos > -6 && pointPos <= 0) {
+        outs->write({"0.", 2});
+        for (s32 i = pointPos; i < 0; i++) {
+            outs->writeByte('0');
+        }
+        outs->write({dd.digits, dd.numDigits});
+    } else {
+        // Scientific notation
+        outs->writeByte(dd.digits[0]);
+        if (numDigits > 1) {
+            outs->writeByte('.');
+            outs->write({dd.digits + 1, u32(numDigits - 1)});
+        }
+        outs->writeByte('e');
+        printString(outs, (s64) pointPos - 1, 10);
+    }
+}
+
+// Prints the shortest decimal representation that reads back as the same value.
+template <typename Float>
+static void printShortest(OutStream* outs, Float value) {
+    if (signbit(value)) {
+        value = -value;
+        outs->writeByte('-');
+    }
+    if (isnan(value)) {
+        *outs->strWriter() << "nan";
+    } else if (isinf(value)) {
+        *outs->strWriter() << "inf";
+    } else if (value == 0) {
+        outs->write({"0.0", 3});
+    } else {
+        details::DecimalDigits dd;
+        details::getShortestDigits(&dd, value);
+        printDecimalDigits(outs, dd);
+    }
+}
+
 PLY_NO_INLINE void printString(OutStream* outs, double value, u32 radix) {
     PLY_ASSERT(radix >= 2);
+    if (radix == 10) {
+        printShortest(outs, value);
+        return;
+    }
 
 #if PLY_COMPILER_GCC
 #pragma GCC diagnostic push
@@ -188,7 +273,11 @@ PLY_NO_INLINE void fmt::TypePrinter<s64>::print(StringWriter* sw, s64 value) {
 }
 
 PLY_NO_INLINE void fmt::TypePrinter<double>::print(StringWriter* sw, double value) {
-    printString(sw, value, 10);
+    printShortest(sw, value);
+}
+
+PLY_NO_INLINE void fmt::TypePrinter<float>::print(StringWriter* sw, float value) {
+    printShortest(sw, value);
 }
 
 PLY_NO_INLINE void fmt::TypePrinter<bool>::print(StringWriter* sw, bool value) {
@@ -15,8 +15,83 @@ namespace ply {
 namespace fmt {
 template <typename T>
 struct TypePrinter;
+template <typename Str, u32 Pos>
+struct CompiledFormat;
+
+//------------------------------------------------------------------
+// fmt::FormatString
+//------------------------------------------------------------------
+// A format string whose contents are known at compile time. Don't use this type directly; create
+// one using the PLY_FMT macro instead. Str is a local class with static constexpr functions
+// chars() and numBytes().
+template <typename Str>
+struct FormatString {};
+
+namespace details {
+enum class FormatSegment {
+    End,
+    Arg,
+    EscapedBrace,
+};
+
+// Returns the offset of the first '{' or '}' at or after pos, or numBytes if there is none.
+constexpr u32 findFormatSpecial(const char* chars, u32 pos, u32 numBytes) {
+    while (pos < numBytes && chars[pos] != '{' && chars[pos] != '}') {
+        pos++;
+    }
+    return pos;
+}
+
+// pos is the offset of a '{' or '}', or numBytes.
+constexpr FormatSegment getFormatSegment(const char* chars, u32 pos, u32 numBytes) {
+    return (pos >= numBytes)
+               ? FormatSegment::End
+               : (chars[pos] == '{' && chars[pos + 1] == '}') ? FormatSegment::Arg
+                                                               : FormatSegment::EscapedBrace;
+}
+
+// Returns the number of {} placeholders in the format string, or -1 if it's invalid.
+constexpr s32 countFormatArgs(const char* chars, u32 numBytes) {
+    s32 numArgs = 0;
+    for (u32 i = 0; i < numBytes; i++) {
+        if (chars[i] == '{' || chars[i] == '}') {
+            if (i + 1 >= numBytes)
+                return -1;
+            if (chars[i] == '{' && chars[i + 1] == '}') {
+                numArgs++;
+            } else if (chars[i + 1] != chars[i]) {
+                return -1;
+            }
+            i++;
+        }
+    }
+    return numArgs;
+}
+} // namespace details
 } // namespace fmt
 
+/*!
+Creates a format string that is parsed at compile time. Pass it to `StringWriter::format()` or
+`String::format()` in place of an ordinary string literal:
+
+    sw.format(PLY_FMT("The answer is {}.\n"), 42);
+
+An invalid format string, or a mismatch between the number of `{}` placeholders and the number of
+arguments, results in a compile error.
+*/
+#define PLY_FMT(str) \
+    ([] { \
+        struct PlyFormatString { \
+            static constexpr const char* chars() { \
+                return str; \
+            } \
+            static constexpr ::ply::u32 numBytes() { \
+                return sizeof(str) - 1; \
+            } \
+        }; \
+        return ::ply::fmt::FormatString<PlyFormatString>{}; \
+    }())
+
 //------------------------------------------------------------------------------------------------
 /*!
 `StringWriter` is a subclass of `OutStream` with additional member functions for writing text.
@@ -105,6 +180,15 @@ public:
         return ((MemOutStream*) this)->moveToString();
     }
 
+    /*!
+    If the `StringWriter` writes to a chunk list in memory, this function returns a `ChunkString`
+    that takes ownership of the chunk list. Unlike `moveToString()`, no data is copied, even for
+    large strings. The `StringWriter` is reset to a null stream as result of this call.
+    */
+    PLY_INLINE ChunkString moveToChunks() {
+        return ((MemOutStream*) this)->moveToChunks();
+    }
+
     /*!
     Template function that expands the format string `fmt` using the given arguments and writes the
     result to the output stream.
@@ -122,6 +206,25 @@ public:
         this->formatInternal(fmt, argList.view());
     }
 
+    /*!
+    Overload that accepts a format string created by `PLY_FMT`. The format string is parsed at
+    compile time, so the output is written by a sequence of calls specialized for the format string
+    and argument types. An invalid format string, or the wrong number of arguments, results in a
+    compile error.
+
+        StringWriter sw;
+        sw.format(PLY_FMT("The answer is {}.\n"), 42);
+        return sw.moveToString();
+    */
+    template <typename Str, typename... Args>
+    PLY_NO_INLINE void format(fmt::FormatString<Str>, const Args&... args) {
+        constexpr s32 numArgs = fmt::details::countFormatArgs(Str::chars(), Str::numBytes());
+        static_assert(numArgs >= 0, "Invalid format string");
+        static_assert(numArgs < 0 || (u32) numArgs == sizeof...(Args),
+                      "Wrong number of arguments for format string");
+        fmt::CompiledFormat<Str, 0>::write(this, args...);
+    }
+
     /*!
     Template function that writes the the default text representation of `value` to the output
     stream.
@@ -171,7 +274,7 @@ struct WithRadix {
               typename std::enable_if_t<std::is_floating_point<SrcType>::value, int> = 0>
     inline WithRadix(SrcType v, u32 radix) {
         this->double_ = v;
-        this->type = U64;
+        this->type = Double;
         this->radix = radix;
     }
     template <typename SrcType,
@@ -249,8 +352,6 @@ struct TypePrinter<s16> : TypePrinter_Cast<s64, s16> {};
 template <>
 struct TypePrinter<s8> : TypePrinter_Cast<s64, s8> {};
 template <>
-struct TypePrinter<float> : TypePrinter_Cast<double, float> {};
-template <>
 struct TypePrinter<String> : TypePrinter_Cast<StringView, String> {};
 template <>
 struct TypePrinter<HybridString> : TypePrinter_Cast<StringView, HybridString> {};
@@ -307,6 +408,10 @@ struct TypePrinter<double> {
     static PLY_DLL_ENTRY void print(StringWriter* sw, double value);
 };
 template <>
+struct TypePrinter<float> {
+    static PLY_DLL_ENTRY void print(StringWriter* sw, float value);
+};
+template <>
 struct TypePrinter<bool> {
     static PLY_DLL_ENTRY void print(StringWriter* sw, bool value);
 };
@@ -327,6 +432,54 @@ struct TypePrinter<CmdLineArg_WinCrt> {
     static PLY_DLL_ENTRY void print(StringWriter* sw, const CmdLineArg_WinCrt& value);
 };
 
+//-----------------------------------------------------------
+// fmt::CompiledFormat
+//-----------------------------------------------------------
+// Writes the compile-time format string Str starting at offset Pos. Each run of literal text is
+// written with a single call to write(), and each placeholder calls the TypePrinter directly.
+template <typename Str, u32 Pos, details::FormatSegment Segment>
+struct CompiledFormatSegment;
+
+template <typename Str, u32 Pos>
+struct CompiledFormat {
+    static constexpr u32 SpecialPos =
+        details::findFormatSpecial(Str::chars(), Pos, Str::numBytes());
+
+    template <typename... Args>
+    static PLY_INLINE void write(StringWriter* sw, const Args&... args) {
+        if (SpecialPos > Pos) {
+            sw->write({Str::chars() + Pos, SpecialPos - Pos});
+        }
+        CompiledFormatSegment<Str, SpecialPos,
+                              details::getFormatSegment(Str::chars(), SpecialPos,
+                                                        Str::numBytes())>::write(sw, args...);
+    }
+};
+
+template <typename Str, u32 Pos>
+struct CompiledFormatSegment<Str, Pos, details::FormatSegment::End> {
+    static PLY_INLINE void write(StringWriter*) {
+    }
+};
+
+template <typename Str, u32 Pos>
+struct CompiledFormatSegment<Str, Pos, details::FormatSegment::Arg> {
+    template <typename Arg, typename... Rest>
+    static PLY_INLINE void write(StringWriter* sw, const Arg& arg, const Rest&... rest) {
+        TypePrinter<Arg>::print(sw, arg);
+        CompiledFormat<Str, Pos + 2>::write(sw, rest...);
+    }
+};
+
+template <typename Str, u32 Pos>
+struct CompiledFormatSegment<Str, Pos, details::FormatSegment::EscapedBrace> {
+    template <typename... Args>
+    static PLY_INLINE void write(StringWriter* sw, const Args&... args) {
+        sw->writeByte(Str::chars()[Pos]);
+        CompiledFormat<Str, Pos + 2>::write(sw, args...);
+    }
+};
+
 } // namespace fmt
 
 //-----------------------------------------------------------
@@ -339,6 +492,13 @@ PLY_INLINE String String::format(StringView fmt, const Args&... args) {
     return sw.moveToString();
 }
 
+template <typename Str, typename... Args>
+PLY_INLINE String String::format(fmt::FormatString<Str> fmt, const Args&... args) {
+    StringWriter sw;
+    sw.format(fmt, args...);
+    return sw.moveToString();
+}
+
 template <typename T>
 PLY_INLINE String String::from(const T& value) {
     StringWriter sw;
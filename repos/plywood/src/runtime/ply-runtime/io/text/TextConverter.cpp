@@ -5,15 +5,161 @@
 #include <ply-runtime/Precomp.h>
 #include <ply-runtime/io/text/TextConverter.h>
 #include <ply-runtime/io/OutStream.h>
+#if PLY_CPU_X64 || PLY_CPU_X86
+#include <emmintrin.h>
+#elif PLY_CPU_ARM64
+#include <arm_neon.h>
+#endif
 
 namespace ply {
 
+//-----------------------------------------------------------------------
+// Bulk conversion
+//-----------------------------------------------------------------------
+// Copies a run of ASCII characters from src to dst. The generic version copies nothing; the
+// specializations below convert 16 characters at a time.
+template <typename DstEnc, typename SrcEnc>
+struct AsciiRun {
+    static PLY_INLINE void copy(u8*&, const u8*, const u8*&, const u8*) {
+    }
+};
+
+template <bool BigEndian>
+struct AsciiRun<UTF16<BigEndian>, UTF8> {
+    static PLY_INLINE void copy(u8*& dst, const u8* dstEnd, const u8*& src, const u8* srcEnd) {
+#if PLY_CPU_X64 || PLY_CPU_X86
+        while (srcEnd - src >= 16 && dstEnd - dst >= 32) {
+            __m128i v = _mm_loadu_si128((const __m128i*) src);
+            if (_mm_movemask_epi8(v) != 0)
+                break;
+            __m128i zero = _mm_setzero_si128();
+            if (BigEndian) {
+                _mm_storeu_si128((__m128i*) dst, _mm_unpacklo_epi8(zero, v));
+                _mm_storeu_si128((__m128i*) (dst + 16), _mm_unpackhi_epi8(zero, v));
+            } else {
+                _mm_storeu_si128((__m128i*) dst, _mm_unpacklo_epi8(v, zero));
+                _mm_storeu_si128((__m128i*) (dst + 16), _mm_unpackhi_epi8(v, zero));
+            }
+            src += 16;
+            dst += 32;
+        }
+#elif PLY_CPU_ARM64
+        while (srcEnd - src >= 16 && dstEnd - dst >= 32) {
+            uint8x16_t v = vld1q_u8(src);
+            if (vmaxvq_u8(v) >= 0x80)
+                break;
+            uint8x16x2_t units;
+            units.val[BigEndian ? 0 : 1] = vdupq_n_u8(0);
+            units.val[BigEndian ? 1 : 0] = v;
+            vst2q_u8(dst, units); // Interleaves the zero bytes
+            src += 16;
+            dst += 32;
+        }
+#endif
+        while (src < srcEnd && *src < 0x80 && dstEnd - dst >= 2) {
+            UTF16<BigEndian>::putUnit(dst, *src);
+            src++;
+            dst += 2;
+        }
+    }
+};
+
+template <bool BigEndian>
+struct AsciiRun<UTF8, UTF16<BigEndian>> {
+    static PLY_INLINE void copy(u8*& dst, const u8* dstEnd, const u8*& src, const u8* srcEnd) {
+#if PLY_CPU_X64 || PLY_CPU_X86
+        while (srcEnd - src >= 32 && dstEnd - dst >= 16) {
+            __m128i v0 = _mm_loadu_si128((const __m128i*) src);
+            __m128i v1 = _mm_loadu_si128((const __m128i*) (src + 16));
+            if (BigEndian) {
+                v0 = _mm_or_si128(_mm_slli_epi16(v0, 8), _mm_srli_epi16(v0, 8));
+                v1 = _mm_or_si128(_mm_slli_epi16(v1, 8), _mm_srli_epi16(v1, 8));
+            }
+            // Every unit must be less than 0x80
+            __m128i high = _mm_and_si128(_mm_or_si128(v0, v1), _mm_set1_epi16((short) 0xff80));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xffff)
+                break;
+            _mm_storeu_si128((__m128i*) dst, _mm_packus_epi16(v0, v1));
+            src += 32;
+            dst += 16;
+        }
+#elif PLY_CPU_ARM64
+        while (srcEnd - src >= 32 && dstEnd - dst >= 16) {
+            uint8x16x2_t units = vld2q_u8(src); // Deinterleaves low and high bytes
+            uint8x16_t lo = units.val[BigEndian ? 1 : 0];
+            uint8x16_t hi = units.val[BigEndian ? 0 : 1];
+            if (vmaxvq_u8(vorrq_u8(hi, vandq_u8(lo, vdupq_n_u8(0x80)))) != 0)
+                break;
+            vst1q_u8(dst, lo);
+            src += 32;
+            dst += 16;
+        }
+#endif
+        while (srcEnd - src >= 2 && dst < dstEnd) {
+            char16_t unit = UTF16<BigEndian>::getUnit(src);
+            if (unit >= 0x80)
+                break;
+            *dst = (u8) unit;
+            src += 2;
+            dst++;
+        }
+    }
+};
+
+// Performs the same conversion as the per-point loop in TextConverter::convert, but calls the
+// encoding functions directly, and copies ASCII runs and (for UTF-8 to UTF-8) well-formed text in
+// bulk. Like the per-point loop, it only decodes when at least 4 source bytes are available, and
+// only encodes when there's room for any point, so that TextConverter::convert can finish the
+// tails.
+template <typename DstEnc, typename SrcEnc>
+PLY_NO_INLINE void convertBulk(BufferView* dstBuf, ConstBufferView* srcBuf) {
+    u8* dst = dstBuf->bytes;
+    u8* dstEnd = dstBuf->bytes + dstBuf->numBytes;
+    const u8* src = srcBuf->bytes;
+    const u8* srcEnd = srcBuf->bytes + srcBuf->numBytes;
+    for (;;) {
+        if (std::is_same<DstEnc, UTF8>::value && std::is_same<SrcEnc, UTF8>::value) {
+            // Well-formed UTF-8 is unchanged by the conversion
+            u32 numBytes = min<u32>(safeDemote<u32>(dstEnd - dst), safeDemote<u32>(srcEnd - src));
+            numBytes = UTF8::numValidBytes({src, numBytes});
+            memcpy(dst, src, numBytes);
+            src += numBytes;
+            dst += numBytes;
+        } else {
+            AsciiRun<DstEnc, SrcEnc>::copy(dst, dstEnd, src, srcEnd);
+        }
+        if (srcEnd - src < 4 || dstEnd - dst < 4)
+            break;
+        DecodeResult decoded = SrcEnc::decodePoint({src, safeDemote<u32>(srcEnd - src)});
+        src += decoded.numBytes;
+        dst += DstEnc::encodePoint({dst, safeDemote<u32>(dstEnd - dst)}, decoded.point);
+    }
+    *dstBuf = BufferView::fromRange(dst, dstEnd);
+    *srcBuf = ConstBufferView::fromRange(src, srcEnd);
+}
+
 //-----------------------------------------------------------------------
 // TextConverter
 //-----------------------------------------------------------------------
+template <typename DstEnc, typename SrcEnc>
+PLY_INLINE bool isPair(const TextEncoding* dstEncoding, const TextEncoding* srcEncoding) {
+    return dstEncoding == TextEncoding::get<DstEnc>() && srcEncoding == TextEncoding::get<SrcEnc>();
+}
+
 PLY_NO_INLINE TextConverter::TextConverter(const TextEncoding* dstEncoding,
                                            const TextEncoding* srcEncoding)
     : dstEncoding{dstEncoding}, srcEncoding{srcEncoding} {
+    if (isPair<UTF8, UTF8>(dstEncoding, srcEncoding)) {
+        this->bulkConvert = convertBulk<UTF8, UTF8>;
+    } else if (isPair<UTF16_LE, UTF8>(dstEncoding, srcEncoding)) {
+        this->bulkConvert = convertBulk<UTF16_LE, UTF8>;
+    } else if (isPair<UTF16_BE, UTF8>(dstEncoding, srcEncoding)) {
+        this->bulkConvert = convertBulk<UTF16_BE, UTF8>;
+    } else if (isPair<UTF8, UTF16_LE>(dstEncoding, srcEncoding)) {
+        this->bulkConvert = convertBulk<UTF8, UTF16_LE>;
+    } else if (isPair<UTF8, UTF16_BE>(dstEncoding, srcEncoding)) {
+        this->bulkConvert = convertBulk<UTF8, UTF16_BE>;
+    }
 }
 
 PLY_NO_INLINE bool TextConverter::convert(BufferView* dstBuf, ConstBufferView* srcBuf, bool flush) {
@@ -33,6 +179,16 @@ PLY_NO_INLINE bool TextConverter::convert(BufferView* dstBuf, ConstBufferView* s
                 break; // Output buf has been filled.
         }
 
+        if (this->bulkConvert) {
+            const u8* srcBefore = srcBuf->bytes;
+            this->bulkConvert(dstBuf, srcBuf);
+            if (srcBuf->bytes != srcBefore) {
+                didWork = true;
+                if (dstBuf->numBytes == 0)
+                    break;
+            }
+        }
+
         // Don't attempt to decode unless there are at least 4 bytes (unless we're flushing the
         // src).
         if (srcBuf->numBytes < 4) {
@@ -42,8 +198,14 @@ PLY_NO_INLINE bool TextConverter::convert(BufferView* dstBuf, ConstBufferView* s
 
         // Decode one point from the input.
         DecodeResult decoded = this->srcEncoding->decodePoint(*srcBuf);
-        srcBuf->offsetHead(decoded.numBytes);
         didWork = true;
+        if (decoded.numBytes == 0) {
+            // The source ends with an incomplete code unit (eg. an odd number of bytes in UTF-16).
+            // Discard it, otherwise we'd loop forever.
+            srcBuf->offsetHead(srcBuf->numBytes);
+            break;
+        }
+        srcBuf->offsetHead(decoded.numBytes);
 
         if (dstBuf->numBytes >= 4) {
             // There's enough room in the output buffer for *any* encoded point.
@@ -134,6 +296,7 @@ InPipe::Funcs InPipe_TextConverter::Funcs_ = {
     InPipe_TextConverter_destroy,
     InPipe_TextConverter_readSome,
     InPipe::getFileSize_Unsupported,
+    InPipe::readSomeVectored_Default,
 };
 
 PLY_NO_INLINE InPipe_TextConverter::InPipe_TextConverter(OptionallyOwned<InStream>&& ins,
@@ -166,6 +329,7 @@ OutPipe::Funcs OutPipe_TextConverter::Funcs_ = {
     OutPipe_TextConverter_write,
     OutPipe_TextConverter_flush,
     OutPipe::seek_Empty,
+    OutPipe::writeVectored_Default,
 };
 
 PLY_NO_INLINE OutPipe_TextConverter::OutPipe_TextConverter(OptionallyOwned<OutStream>&& outs,
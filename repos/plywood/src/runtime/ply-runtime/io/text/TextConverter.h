@@ -33,6 +33,9 @@ struct TextConverter {
     const TextEncoding* dstEncoding = nullptr;
     const TextEncoding* srcEncoding = nullptr;
     SmallBuffer smallBuf;
+    // Converts as much as possible without going through the dstEncoding/srcEncoding function
+    // tables. Selected by the constructor for common encoding pairs; otherwise nullptr.
+    void (*bulkConvert)(BufferView* dstBuf, ConstBufferView* srcBuf) = nullptr;
 
     PLY_DLL_ENTRY TextConverter(const TextEncoding* dstEncoding, const TextEncoding* srcEncoding);
     template <typename DstEnc, typename SrcEnc>
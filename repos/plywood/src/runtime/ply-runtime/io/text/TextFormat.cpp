@@ -285,6 +285,13 @@ TextFormat::createImporter(OptionallyOwned<InStream>&& ins) const {
         }
     }
 
+    // Fast path: If the input is already in memory (typically a memory-mapped file) and contains
+    // no '\r' characters, UTF-8 text doesn't need to pass through any filters. Read it directly.
+    if ((this->encoding == Enc::UTF8 || this->encoding == Enc::Bytes) && ins->isView() &&
+        ins.isOwned() && !memchr(ins->curByte, '\r', ins->numBytesAvailable())) {
+        return ins.release()->asStringReader();
+    }
+
     // Install converter from UTF-16 if needed
     OptionallyOwned<InStream> importer;
     switch (this->encoding) {
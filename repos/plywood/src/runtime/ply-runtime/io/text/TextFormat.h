@@ -73,6 +73,10 @@ struct TextFormat {
     described by the provided `TextFormat` object. Conversion is performed on-the-fly while data is
     being read.
 
+    If `ins` is an owned, in-memory `InStream`, such as one returned by
+    `FileSystem::openMappedStreamForRead()`, and its UTF-8 contents contain no `'\r'` characters,
+    no conversion is needed, and `ins` itself is returned as the `StringReader`.
+
     [FIXME: Say something here about OptionallyOwned.]
     */
     PLY_DLL_ENTRY Owned<StringReader> createImporter(OptionallyOwned<InStream>&& ins) const;
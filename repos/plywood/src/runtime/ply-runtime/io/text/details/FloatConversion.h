@@ -0,0 +1,34 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+
+namespace ply {
+namespace details {
+
+//---------------------------------------------------
+// Decimal <-> binary floating-point conversion
+//---------------------------------------------------
+// The value represented is digits[0..numDigits) * 10^exp10. There are no leading or trailing
+// zeros in digits, and digits are stored as ASCII characters.
+struct DecimalDigits {
+    char digits[20];
+    u32 numDigits = 0;
+    s32 exp10 = 0;
+};
+
+// Computes the shortest sequence of decimal digits that reads back as exactly value, using the Ryu
+// algorithm. When there's more than one such sequence, the one closest to value is chosen. value
+// must be finite and greater than zero.
+PLY_DLL_ENTRY void getShortestDigits(DecimalDigits* out, double value);
+PLY_DLL_ENTRY void getShortestDigits(DecimalDigits* out, float value);
+
+// Converts mantissa * 10^exp10 to the nearest double using the Eisel-Lemire algorithm. Returns
+// false in the rare cases where the result can't be determined from a 128-bit product; the caller
+// should then fall back to a slower, exact conversion.
+PLY_DLL_ENTRY bool decimalToDouble(double* result, u64 mantissa, s32 exp10);
+
+} // namespace details
+} // namespace ply
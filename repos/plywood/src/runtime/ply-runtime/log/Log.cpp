@@ -15,7 +15,7 @@ PLY_NO_INLINE LogChannel::LineHandler::LineHandler(StringView channelName) {
     CPUTimer::Point now = CPUTimer::get();
     TID::TID tid = TID::getCurrentThreadID();
     this->sw << (now - startTime); // Timestamp
-    this->sw.format(" 0x{}[{}] ", String::from(fmt::Hex(tid)), channelName);
+    this->sw.format(PLY_FMT(" 0x{}[{}] "), fmt::Hex(tid), channelName);
 }
 
 PLY_NO_INLINE LogChannel::LineHandler::~LineHandler() {
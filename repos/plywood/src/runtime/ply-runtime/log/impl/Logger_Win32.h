@@ -11,7 +11,8 @@ namespace ply {
 class Logger_Win32 {
 public:
     static void log(StringView strWithOptionalNullTerminator) {
-        OutputDebugStringA((LPCSTR) strWithOptionalNullTerminator.withNullTerminator().bytes);
+        OutputDebugStringA(
+            (LPCSTR) strWithOptionalNullTerminator.withNullTerminator().view().bytes);
     }
 };
 
@@ -38,6 +38,15 @@ public:
         munmap(ptr, size);
         return true;
     }
+
+    static bool mapFileForRead(void*& result, int fd, ureg size) {
+        result = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        return (result != MAP_FAILED);
+    }
+
+    static bool unmapFile(void* ptr, ureg size) {
+        return munmap(ptr, size) == 0;
+    }
 };
 
 } // namespace ply
@@ -51,6 +51,20 @@ public:
         }
         return true;
     }
+
+    static bool mapFileForRead(void*& result, HANDLE handle, ureg size) {
+        HANDLE mapping = CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL)
+            return false;
+        result = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T) size);
+        // The view keeps the file mapping object alive until it's unmapped:
+        CloseHandle(mapping);
+        return (result != NULL);
+    }
+
+    static bool unmapFile(void* ptr, ureg) {
+        return UnmapViewOfFile(ptr) != 0;
+    }
 };
 
 } // namespace ply
@@ -261,7 +261,7 @@ PLY_NO_INLINE IPAddress Socket_Winsock::resolveHostName(StringView hostName,
     }
 #endif
     struct addrinfo* res = nullptr;
-    int rc = getaddrinfo(hostName.withNullTerminator().bytes, nullptr, &hints, &res);
+    int rc = getaddrinfo(hostName.withNullTerminator().view().bytes, nullptr, &hints, &res);
     PLY_ASSERT(rc == 0);
     PLY_UNUSED(rc);
     struct addrinfo* best = nullptr;
@@ -0,0 +1,82 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#include <ply-runtime/Precomp.h>
+#include <ply-runtime/string/Label.h>
+
+namespace ply {
+
+LabelStorage g_labelStorage;
+
+PLY_NO_INLINE LabelStorage::LabelStorage() {
+    // Label 0 is the empty string
+    this->segments[0] = (StringView*) PLY_HEAP.alloc(sizeof(StringView) << SegmentBits);
+    this->segments[0][0] = {};
+    this->numLabels = 1;
+}
+
+PLY_NO_INLINE LabelStorage::~LabelStorage() {
+    for (StringView* segment : this->segments) {
+        if (segment) {
+            PLY_HEAP.free(segment);
+        }
+    }
+    for (u8* block : this->blocks) {
+        PLY_HEAP.free(block);
+    }
+}
+
+PLY_NO_INLINE StringView LabelStorage::storeBytes(StringView str) {
+    if (str.numBytes > BlockSize / 4) {
+        // Long strings get their own allocation
+        u8* bytes = (u8*) PLY_HEAP.alloc(str.numBytes);
+        this->blocks.append(bytes);
+        memcpy(bytes, str.bytes, str.numBytes);
+        return {(const char*) bytes, str.numBytes};
+    }
+    if ((uptr) (this->endByte - this->curByte) < str.numBytes) {
+        // The rest of the current block is wasted, but it's less than a quarter of the block
+        this->curByte = (u8*) PLY_HEAP.alloc(BlockSize);
+        this->endByte = this->curByte + BlockSize;
+        this->blocks.append(this->curByte);
+    }
+    memcpy(this->curByte, str.bytes, str.numBytes);
+    StringView result = {(const char*) this->curByte, str.numBytes};
+    this->curByte += str.numBytes;
+    return result;
+}
+
+PLY_NO_INLINE Label LabelStorage::insert(StringView str) {
+    if (str.isEmpty())
+        return {};
+
+    LockGuard<Mutex> guard{this->mutex};
+    auto cursor = this->strToIndex.insertOrFind(str, this);
+    if (!cursor.wasFound()) {
+        u32 idx = this->numLabels;
+        u32 segmentIdx = idx >> SegmentBits;
+        PLY_ASSERT(segmentIdx < MaxSegments);
+        if (!this->segments[segmentIdx]) {
+            this->segments[segmentIdx] =
+                (StringView*) PLY_HEAP.alloc(sizeof(StringView) << SegmentBits);
+        }
+        this->segments[segmentIdx][idx & ((1 << SegmentBits) - 1)] = this->storeBytes(str);
+        this->numLabels = idx + 1;
+        *cursor = idx;
+    }
+    return Label{*cursor};
+}
+
+PLY_NO_INLINE Label LabelStorage::find(StringView str) const {
+    if (str.isEmpty())
+        return {};
+
+    LockGuard<Mutex> guard{this->mutex};
+    auto cursor = this->strToIndex.find(str, this);
+    if (!cursor.wasFound())
+        return {};
+    return Label{*cursor};
+}
+
+} // namespace ply
@@ -0,0 +1,109 @@
+/*------------------------------------
+  ///\  Plywood C++ Framework
+  \\\/  https://plywood.arc80.com/
+------------------------------------*/
+#pragma once
+#include <ply-runtime/Core.h>
+#include <ply-runtime/string/String.h>
+#include <ply-runtime/container/Array.h>
+#include <ply-runtime/container/HashMap.h>
+#include <ply-runtime/thread/Mutex.h>
+
+namespace ply {
+
+//------------------------------------------------------------------------------------------------
+/*!
+A `Label` is a compact handle to a string that was interned in a `LabelStorage`. Each distinct
+string is stored only once, and two `Label`s from the same `LabelStorage` are equal if and only if
+their strings are equal. As a result, comparing and hashing `Label`s only involves a single
+integer.
+
+A default-constructed `Label` refers to the empty string.
+*/
+struct Label {
+    u32 idx = 0;
+
+    PLY_INLINE Label() = default;
+    PLY_INLINE explicit Label(u32 idx) : idx{idx} {
+    }
+    /*!
+    Returns `true` if the `Label` refers to a non-empty string.
+    */
+    PLY_INLINE explicit operator bool() const {
+        return this->idx != 0;
+    }
+    PLY_INLINE bool operator==(Label other) const {
+        return this->idx == other.idx;
+    }
+    PLY_INLINE bool operator!=(Label other) const {
+        return this->idx != other.idx;
+    }
+    PLY_INLINE void appendTo(Hasher& hasher) const {
+        hasher.append(this->idx);
+    }
+};
+
+//------------------------------------------------------------------------------------------------
+/*!
+A `LabelStorage` interns strings and assigns a `Label` to each distinct one.
+
+The bytes of each string are copied into large blocks of memory that are never moved or freed
+until the `LabelStorage` is destroyed, so the `StringView` returned by `view()` remains valid for
+the lifetime of the `LabelStorage`. `insert()` and `find()` are thread-safe. `view()` doesn't lock
+anything, and can be called from any thread that obtained the `Label`.
+
+Most code uses the global `g_labelStorage`.
+*/
+class LabelStorage {
+private:
+    static const u32 BlockSize = 65536;
+    static const u32 SegmentBits = 12;
+    static const u32 MaxSegments = 4096; // Allows up to 16M distinct labels
+
+    struct Traits {
+        using Key = StringView;
+        using Item = u32;
+        using Context = LabelStorage;
+        static PLY_INLINE StringView comparand(u32 item, const LabelStorage& storage) {
+            return storage.view(Label{item});
+        }
+    };
+
+    mutable Mutex mutex;
+    HashMap<Traits> strToIndex;
+    // Views are stored in fixed-size segments that never move, so that view() doesn't need to
+    // lock the mutex:
+    StringView* segments[MaxSegments] = {};
+    u32 numLabels = 0;
+    Array<u8*> blocks;
+    u8* curByte = nullptr;
+    u8* endByte = nullptr;
+
+    StringView storeBytes(StringView str);
+
+public:
+    PLY_DLL_ENTRY LabelStorage();
+    PLY_DLL_ENTRY ~LabelStorage();
+
+    /*!
+    Returns the `Label` for `str`, adding `str` to the storage if it isn't there already.
+    */
+    PLY_DLL_ENTRY Label insert(StringView str);
+
+    /*!
+    Returns the `Label` for `str` if it was previously inserted. Otherwise, returns an empty
+    `Label`.
+    */
+    PLY_DLL_ENTRY Label find(StringView str) const;
+
+    /*!
+    Returns the string that `label` refers to.
+    */
+    PLY_INLINE StringView view(Label label) const {
+        return this->segments[label.idx >> SegmentBits][label.idx & ((1 << SegmentBits) - 1)];
+    }
+};
+
+PLY_DLL_ENTRY extern LabelStorage g_labelStorage;
+
+} // namespace ply
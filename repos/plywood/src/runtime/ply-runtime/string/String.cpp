@@ -12,17 +12,28 @@ PLY_NO_INLINE String::String(StringView other)
     memcpy(this->bytes, other.bytes, other.numBytes);
 }
 
-PLY_NO_INLINE String::String(HybridString&& other) : bytes{other.bytes}, numBytes{other.numBytes} {
-    if (!other.isOwner) {
-        this->bytes = (char*) PLY_HEAP.alloc(other.numBytes);
-        memcpy(this->bytes, other.bytes, other.numBytes);
+PLY_NO_INLINE String::String(HybridString&& other) {
+    if (other.isOwner()) {
+        this->bytes = other.getExternalBytes();
+        this->numBytes = other.getExternalNumBytes();
+        other.setExternal(nullptr, 0, 0);
     } else {
-        other.bytes = nullptr;
-        other.isOwner = 0;
-        other.numBytes = 0;
+        StringView view = other.view();
+        this->bytes = (char*) PLY_HEAP.alloc(view.numBytes);
+        this->numBytes = view.numBytes;
+        memcpy(this->bytes, view.bytes, view.numBytes);
     }
 }
 
+PLY_NO_INLINE HybridString HybridString::copy(StringView view) {
+    if (view.numBytes > MaxInlineBytes)
+        return String{view};
+    HybridString result;
+    memcpy(result.storage, view.bytes, view.numBytes);
+    result.flags = u8(InlineFlag | (view.numBytes << InlineLengthShift));
+    return result;
+}
+
 PLY_NO_INLINE String String::allocate(u32 numBytes) {
     String result;
     result.bytes = (char*) PLY_HEAP.alloc(numBytes);
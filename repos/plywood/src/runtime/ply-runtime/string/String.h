@@ -11,6 +11,10 @@ namespace ply {
 
 struct HybridString;
 struct ChunkCursor;
+namespace fmt {
+template <typename Str>
+struct FormatString;
+} // namespace fmt
 
 //------------------------------------------------------------------------------------------------
 /*!
@@ -204,6 +208,15 @@ struct String : StringMixin<String> {
     template <typename... Args>
     static PLY_INLINE String format(StringView fmt, const Args&... args);
 
+    /*!
+    Overload that accepts a format string created by `PLY_FMT`. The format string is parsed and
+    checked against the number of arguments at compile time.
+
+        String str = String::format(PLY_FMT("The answer is {}.\n"), 42);
+    */
+    template <typename Str, typename... Args>
+    static PLY_INLINE String format(fmt::FormatString<Str> fmt, const Args&... args);
+
     /*!
     Template function that converts the provided argument to a string.
 
@@ -314,41 +327,65 @@ PLY_INLINE String StringMixin<Derived>::filterBytes(char (*filterFunc)(char)) co
 /*!
 A `HybridString` is a cross between a `String` and a `StringView`. It references a range of memory
 that is generally intended (but not required) to contain UTF-8-encoded text. The `HybridString` may
-or may not own the memory it points to, as determined by the `isOwner` flag. If `isOwner` is
-non-zero, the memory block owned by the `HybridString` will be freed from heap when the
-`HybridString` is destroyed. If `isOwner` is zero, the `HybridString` does not own the memory it
-points to, and the caller must ensure that the memory remains valid for the lifetime of the
-`HybridString`.
+or may not own the memory it points to, as determined by `isOwner()`. If `isOwner()` returns
+`true`, the memory block owned by the `HybridString` will be freed from heap when the
+`HybridString` is destroyed. If `isOwner()` returns `false`, the `HybridString` does not own the
+memory it points to, and the caller must ensure that the memory remains valid for the lifetime of
+the `HybridString`.
+
+Short strings of up to `MaxInlineBytes` bytes can also be stored inline, inside the `HybridString`
+object itself, by calling `HybridString::copy()`. No memory is allocated for inline strings. Since
+the inline bytes move with the object, use `view()` to access the bytes of a `HybridString`, and
+don't keep the resulting `StringView` after the `HybridString` is moved or destroyed.
 */
 struct HybridString : StringMixin<HybridString> {
     /*!
-    The bytes. Should be treated as const if isOwner == 0.
+    The maximum number of bytes that can be stored inline.
     */
-    char* bytes;
+    static const u32 MaxInlineBytes = 23;
 
-    /*!
-    \beginGroup
-    Number of bytes and owner flag.
-    */
-    u32 isOwner : 1;
-    u32 numBytes : 31;
-    /*!
-    \endGroup
-    */
+private:
+    static const u8 OwnerFlag = 1;
+    static const u8 InlineFlag = 2;
+    static const u32 InlineLengthShift = 3;
 
+    // If InlineFlag is set, storage contains the bytes themselves, and their length is stored in
+    // the upper bits of flags. Otherwise, storage contains a pointer followed by a u32 length.
+    // Either way, the object never points to itself, so it remains relocatable using memmove like
+    // other Plywood types.
+    char storage[MaxInlineBytes];
+    u8 flags;
+
+    PLY_INLINE char* getExternalBytes() const {
+        char* bytes;
+        memcpy(&bytes, this->storage, sizeof(bytes));
+        return bytes;
+    }
+    PLY_INLINE u32 getExternalNumBytes() const {
+        u32 numBytes;
+        memcpy(&numBytes, this->storage + sizeof(char*), sizeof(numBytes));
+        return numBytes;
+    }
+    PLY_INLINE void setExternal(const char* bytes, u32 numBytes, u8 flags) {
+        memcpy(this->storage, &bytes, sizeof(bytes));
+        memcpy(this->storage + sizeof(char*), &numBytes, sizeof(numBytes));
+        this->flags = flags;
+    }
+
+public:
     /*!
     Constructs an empty `HybridString`.
     */
-    PLY_INLINE HybridString() : bytes{nullptr}, isOwner{0}, numBytes{0} {
+    PLY_INLINE HybridString() {
+        this->setExternal(nullptr, 0, 0);
     }
 
     /*!
     Constructs a `HybridString` that views the same memory block as `view`. `view` is expected to
     remain valid for the lifetime of the `HybridString`. No new memory is allocated.
     */
-    PLY_INLINE HybridString(StringView view)
-        : bytes{const_cast<char*>(view.bytes)}, isOwner{0}, numBytes{view.numBytes} {
-        PLY_ASSERT(view.numBytes < (1u << 30));
+    PLY_INLINE HybridString(StringView view) {
+        this->setExternal(view.bytes, view.numBytes, 0);
     }
 
     /*!
@@ -356,38 +393,59 @@ struct HybridString : StringMixin<HybridString> {
     reset to an empty string.
     */
     PLY_INLINE HybridString(String&& str) {
-        this->isOwner = 1;
-        PLY_ASSERT(str.numBytes < (1u << 30));
-        this->numBytes = str.numBytes;
-        this->bytes = str.release();
+        u32 numBytes = str.numBytes;
+        this->setExternal(str.release(), numBytes, OwnerFlag);
+    }
+
+    /*!
+    Copy constructor. If `other` owns its memory block, the bytes are copied using `copy()`.
+    Otherwise, the new `HybridString` views the same memory as `other`.
+    */
+    PLY_INLINE HybridString(const HybridString& other) {
+        if (other.flags & OwnerFlag) {
+            new (this) HybridString{copy(other.view())};
+        } else {
+            memcpy((void*) this, (const void*) &other, sizeof(HybridString));
+        }
     }
 
     /*!
     Move constructor.
     */
-    PLY_INLINE HybridString(HybridString&& other)
-        : bytes{other.bytes}, isOwner{other.isOwner}, numBytes{other.numBytes} {
-        other.bytes = nullptr;
-        other.isOwner = 0;
-        other.numBytes = 0;
+    PLY_INLINE HybridString(HybridString&& other) {
+        memcpy((void*) this, (const void*) &other, sizeof(HybridString));
+        other.setExternal(nullptr, 0, 0);
     }
 
     /*!
     Construct a `HybridString` from a string literal. Compilers seem able to calculate its length at
     compile time (if optimization is enabled).
     */
-    PLY_INLINE HybridString(const char* s)
-        : bytes{const_cast<char*>(s)}, isOwner{0}, numBytes{
-                                                       (u32) std::char_traits<char>::length(s)} {
-        PLY_ASSERT(s[this->numBytes] == 0); // Sanity check; numBytes must fit in 31-bit field
+    PLY_INLINE HybridString(const char* s) {
+        this->setExternal(s, (u32) std::char_traits<char>::length(s), 0);
     }
 
     PLY_INLINE ~HybridString() {
-        if (this->isOwner) {
-            PLY_HEAP.free(this->bytes);
+        if (this->flags & OwnerFlag) {
+            PLY_HEAP.free(this->getExternalBytes());
         }
     }
 
+    /*!
+    Returns a `HybridString` that contains a copy of the bytes in `view`. If `view` fits in
+    `MaxInlineBytes` bytes, the bytes are stored inline and no memory is allocated. Otherwise, the
+    returned `HybridString` owns a new memory block.
+    */
+    static PLY_DLL_ENTRY HybridString copy(StringView view);
+
+    /*!
+    Copy assignment operator.
+    */
+    PLY_INLINE void operator=(const HybridString& other) {
+        this->~HybridString();
+        new (this) HybridString(other);
+    }
+
     /*!
     Move assignment operator.
     */
@@ -396,11 +454,18 @@ struct HybridString : StringMixin<HybridString> {
         new (this) HybridString(std::move(other));
     }
 
+    /*!
+    Returns `true` if the `HybridString` owns a memory block on the heap.
+    */
+    PLY_INLINE bool isOwner() const {
+        return (this->flags & OwnerFlag) != 0;
+    }
+
     /*!
     Conversion operator. Makes `HybridString` implicitly convertible to `StringView`.
     */
     PLY_INLINE operator StringView() const {
-        return {this->bytes, this->numBytes};
+        return this->view();
     }
 
     /*!
@@ -408,8 +473,14 @@ struct HybridString : StringMixin<HybridString> {
     function.
     */
     PLY_INLINE StringView view() const {
-        return {this->bytes, this->numBytes};
+        if (this->flags & InlineFlag) {
+            return {this->storage, u32(this->flags >> InlineLengthShift)};
+        }
+        return {this->getExternalBytes(), this->getExternalNumBytes()};
     }
+
+    // String needs to take ownership of the memory block in String(HybridString&&).
+    friend struct String;
 };
 
 template <typename Derived>
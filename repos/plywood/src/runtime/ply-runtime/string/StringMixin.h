@@ -171,6 +171,14 @@ struct StringMixin {
     \endGroup
     */
 
+    /*!
+    Returns the offset of the first occurence of `substr` in the string, or `-1` if not found. The
+    search begins at the offset specified by `startPos`. An empty `substr` is found at `startPos`.
+    */
+    PLY_INLINE s32 findSubStr(StringView substr, u32 startPos = 0) const {
+        return static_cast<const Derived*>(this)->view().findSubStr(substr, startPos);
+    }
+
     /*!
     Returns `true` if the string starts with `arg`.
     */
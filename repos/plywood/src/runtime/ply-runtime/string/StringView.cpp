@@ -7,9 +7,37 @@
 #include <ply-runtime/string/TextEncoding.h>
 #include <ply-runtime/memory/MemPage.h>
 #include <ply-runtime/io/OutStream.h>
+#if PLY_CPU_X64 || PLY_CPU_X86
+#include <immintrin.h>
+#elif PLY_CPU_ARM64
+#include <arm_neon.h>
+#endif
 
 namespace ply {
 
+#if PLY_CPU_X64 || PLY_CPU_X86
+// SSE2 is always available on x86/x64 targets. The AVX2 code paths below are only taken when this
+// function returns true.
+static PLY_NO_INLINE bool detectAVX2() {
+#if PLY_COMPILER_MSVC
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    // The OS must save the upper halves of the YMM registers on context switches
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static const bool HasAVX2 = detectAVX2();
+#endif
+
 PLY_NO_INLINE bool StringView::startsWith(StringView other) const {
     if (other.numBytes > numBytes)
         return false;
@@ -62,28 +90,158 @@ PLY_NO_INLINE Array<StringView> StringView::splitByte(char sep) const {
     return result;
 }
 
-PLY_NO_INLINE String StringView::upperAsc() const {
-    String result = String::allocate(this->numBytes);
-    for (u32 i = 0; i < this->numBytes; i++) {
-        char c = this->bytes[i];
-        if (c >= 'a' && c <= 'z') {
-            c += 'A' - 'a';
+#if PLY_CPU_X64 || PLY_CPU_X86
+// numBytes must be a multiple of 32.
+static PLY_ENABLE_AVX2 PLY_NO_INLINE void toggleCaseAsc_AVX2(char* dst, const char* src,
+                                                             u32 numBytes, char lo) {
+    __m256i vLo = _mm256_set1_epi8(lo);
+    __m256i vWidth = _mm256_set1_epi8(25);
+    __m256i vToggle = _mm256_set1_epi8(0x20);
+    for (const char* srcEnd = src + numBytes; src < srcEnd; src += 32, dst += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) src);
+        __m256i d = _mm256_subs_epu8(_mm256_sub_epi8(v, vLo), vWidth);
+        __m256i inRange = _mm256_cmpeq_epi8(d, _mm256_setzero_si256());
+        _mm256_storeu_si256((__m256i*) dst,
+                            _mm256_xor_si256(v, _mm256_and_si256(inRange, vToggle)));
+    }
+}
+#endif
+
+// Toggles the case of every byte in the range [lo, lo + 25]. Used by upperAsc() and lowerAsc().
+static PLY_NO_INLINE void toggleCaseAsc(char* dst, const char* src, u32 numBytes, char lo) {
+    const char* srcEnd = src + numBytes;
+#if PLY_CPU_X64 || PLY_CPU_X86
+    if (numBytes >= 32 && HasAVX2) {
+        u32 numBytesAVX2 = numBytes & ~31u;
+        toggleCaseAsc_AVX2(dst, src, numBytesAVX2, lo);
+        src += numBytesAVX2;
+        dst += numBytesAVX2;
+    }
+    __m128i vLo = _mm_set1_epi8(lo);
+    __m128i vWidth = _mm_set1_epi8(25);
+    __m128i vToggle = _mm_set1_epi8(0x20);
+    for (; srcEnd - src >= 16; src += 16, dst += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) src);
+        __m128i d = _mm_subs_epu8(_mm_sub_epi8(v, vLo), vWidth);
+        __m128i inRange = _mm_cmpeq_epi8(d, _mm_setzero_si128());
+        _mm_storeu_si128((__m128i*) dst, _mm_xor_si128(v, _mm_and_si128(inRange, vToggle)));
+    }
+#elif PLY_CPU_ARM64
+    uint8x16_t vLo = vdupq_n_u8((u8) lo);
+    uint8x16_t vWidth = vdupq_n_u8(25);
+    uint8x16_t vToggle = vdupq_n_u8(0x20);
+    for (; srcEnd - src >= 16; src += 16, dst += 16) {
+        uint8x16_t v = vld1q_u8((const u8*) src);
+        uint8x16_t inRange = vcleq_u8(vsubq_u8(v, vLo), vWidth);
+        vst1q_u8((u8*) dst, veorq_u8(v, vandq_u8(inRange, vToggle)));
+    }
+#endif
+    for (; src < srcEnd; src++, dst++) {
+        char c = *src;
+        if ((u8)(c - lo) <= 25) {
+            c ^= 0x20;
         }
-        result.bytes[i] = c;
+        *dst = c;
     }
+}
+
+PLY_NO_INLINE String StringView::upperAsc() const {
+    String result = String::allocate(this->numBytes);
+    toggleCaseAsc(result.bytes, this->bytes, this->numBytes, 'a');
     return result;
 }
 
 PLY_NO_INLINE String StringView::lowerAsc() const {
     String result = String::allocate(this->numBytes);
-    for (u32 i = 0; i < this->numBytes; i++) {
-        char c = this->bytes[i];
-        if (c >= 'A' && c <= 'Z') {
-            c += 'a' - 'A';
+    toggleCaseAsc(result.bytes, this->bytes, this->numBytes, 'A');
+    return result;
+}
+
+#if PLY_CPU_X64 || PLY_CPU_X86
+// Like the SSE2 loop in findSubStr(), but tests 32 candidates at a time. Returns the first match, or
+// nullptr if there's none before the final 31 candidates, with cur advanced to the first candidate
+// that remains to be tested.
+static PLY_ENABLE_AVX2 PLY_NO_INLINE const char*
+findSubStr_AVX2(const char*& cur, const char* lastStart, StringView substr) {
+    u32 lastOfs = substr.numBytes - 1;
+    __m256i vFirst = _mm256_set1_epi8(substr.bytes[0]);
+    __m256i vLast = _mm256_set1_epi8(substr.bytes[lastOfs]);
+    for (; lastStart - cur >= 31; cur += 32) {
+        __m256i eq = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) cur), vFirst),
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (cur + lastOfs)), vLast));
+        u32 bits = (u32) _mm256_movemask_epi8(eq);
+        while (bits != 0) {
+            const char* candidate = cur + countTrailingZeros(bits);
+            if (memcmp(candidate + 1, substr.bytes + 1, substr.numBytes - 2) == 0)
+                return candidate;
+            bits &= bits - 1;
         }
-        result.bytes[i] = c;
     }
-    return result;
+    return nullptr;
+}
+#endif
+
+PLY_NO_INLINE s32 StringView::findSubStr(StringView substr, u32 startPos) const {
+    if (substr.numBytes == 0)
+        return startPos <= this->numBytes ? (s32) startPos : -1;
+    if (startPos >= this->numBytes || substr.numBytes > this->numBytes - startPos)
+        return -1;
+    if (substr.numBytes == 1)
+        return this->findByte(substr.bytes[0], startPos);
+
+    // Candidate positions must match both the first and last byte of substr. Test 16 candidates at
+    // a time, then compare the middle bytes of each candidate that passes.
+    const char* cur = this->bytes + startPos;
+    const char* lastStart = this->bytes + this->numBytes - substr.numBytes;
+    u32 lastOfs = substr.numBytes - 1;
+#if PLY_CPU_X64 || PLY_CPU_X86
+    if (HasAVX2) {
+        if (const char* match = findSubStr_AVX2(cur, lastStart, substr))
+            return safeDemote<s32>(match - this->bytes);
+    }
+#endif
+#if PLY_CPU_X64 || PLY_CPU_X86 || PLY_CPU_ARM64
+#if PLY_CPU_ARM64
+    uint8x16_t vFirst = vdupq_n_u8((u8) substr.bytes[0]);
+    uint8x16_t vLast = vdupq_n_u8((u8) substr.bytes[lastOfs]);
+#else
+    __m128i vFirst = _mm_set1_epi8(substr.bytes[0]);
+    __m128i vLast = _mm_set1_epi8(substr.bytes[lastOfs]);
+#endif
+    for (; lastStart - cur >= 15; cur += 16) {
+#if PLY_CPU_ARM64
+        uint8x16_t eq = vandq_u8(vceqq_u8(vld1q_u8((const u8*) cur), vFirst),
+                                 vceqq_u8(vld1q_u8((const u8*) cur + lastOfs), vLast));
+        // Narrow each byte of the comparison result to 4 bits of a u64
+        u64 bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0) &
+                   0x1111111111111111ull;
+        u32 shift = 2;
+#else
+        __m128i eq =
+            _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) cur), vFirst),
+                          _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (cur + lastOfs)), vLast));
+        u32 bits = (u32) _mm_movemask_epi8(eq);
+        u32 shift = 0;
+#endif
+        while (bits != 0) {
+            const char* candidate = cur + (countTrailingZeros(bits) >> shift);
+            if (memcmp(candidate + 1, substr.bytes + 1, substr.numBytes - 2) == 0)
+                return safeDemote<s32>(candidate - this->bytes);
+            bits &= bits - 1;
+        }
+    }
+#endif
+    // Remaining candidates
+    while (cur <= lastStart) {
+        cur = (const char*) memchr(cur, substr.bytes[0], lastStart + 1 - cur);
+        if (!cur)
+            break;
+        if (memcmp(cur + 1, substr.bytes + 1, substr.numBytes - 1) == 0)
+            return safeDemote<s32>(cur - this->bytes);
+        cur++;
+    }
+    return -1;
 }
 
 PLY_NO_INLINE String StringView::reversedBytes() const {
@@ -158,6 +316,13 @@ PLY_NO_INLINE HybridString StringView::withNullTerminator() const {
     if (this->includesNullTerminator()) {
         return *this;
     }
+    if (this->numBytes < HybridString::MaxInlineBytes) {
+        // Short strings are stored inline, so no memory is allocated
+        char buf[HybridString::MaxInlineBytes];
+        memcpy(buf, this->bytes, this->numBytes);
+        buf[this->numBytes] = 0;
+        return HybridString::copy({buf, this->numBytes + 1});
+    }
     String result = String::allocate(this->numBytes + 1);
     memcpy(result.bytes, this->bytes, this->numBytes);
     result.bytes[this->numBytes] = 0;
@@ -177,16 +342,10 @@ PLY_NO_INLINE s32 compare(StringView str0, StringView str1) {
     // 0 if str0 == str1
     // 1 if str0 > str1
     u32 compareBytes = min(str0.numBytes, str1.numBytes);
-    const u8* u0 = (const u8*) str0.bytes;
-    const u8* u1 = (const u8*) str1.bytes;
-    const u8* uEnd0 = u0 + compareBytes;
-    while (u0 < uEnd0) {
-        s32 diff = *u0 - *u1;
-        if (diff != 0)
-            return diff;
-        u0++;
-        u1++;
-    }
+    // memcmp compares bytes as unsigned values, and is vectorized by every major C runtime.
+    s32 diff = memcmp(str0.bytes, str1.bytes, compareBytes);
+    if (diff != 0)
+        return diff;
     return str0.numBytes - str1.numBytes;
 }
 
@@ -312,11 +312,11 @@ struct StringView {
     UTF-8 encoded strings, since ASCII codes are always encoded as a single byte in UTF-8.
     */
     PLY_INLINE s32 findByte(char matchByte, u32 startPos = 0) const {
-        for (u32 i = startPos; i < this->numBytes; i++) {
-            if (this->bytes[i] == matchByte)
-                return i;
-        }
-        return -1;
+        if (startPos >= this->numBytes)
+            return -1;
+        const char* found =
+            (const char*) memchr(this->bytes + startPos, matchByte, this->numBytes - startPos);
+        return found ? safeDemote<s32>(found - this->bytes) : -1;
     }
 
     /*!
@@ -364,6 +364,12 @@ struct StringView {
         return this->rfindByte(matchFuncOrByte, this->numBytes - 1);
     }
 
+    /*!
+    Returns the offset of the first occurence of `substr` in the string, or `-1` if not found. The
+    search begins at the offset specified by `startPos`. An empty `substr` is found at `startPos`.
+    */
+    PLY_DLL_ENTRY s32 findSubStr(StringView substr, u32 startPos = 0) const;
+
     /*!
     Returns `true` if the string starts with `arg`.
     */
@@ -4,6 +4,11 @@
 ------------------------------------*/
 #include <ply-runtime/Precomp.h>
 #include <ply-runtime/string/TextEncoding.h>
+#if PLY_CPU_X64 || PLY_CPU_X86
+#include <emmintrin.h>
+#elif PLY_CPU_ARM64
+#include <arm_neon.h>
+#endif
 
 namespace ply {
 
@@ -81,6 +86,63 @@ consume1Byte:
     return result;
 }
 
+PLY_NO_INLINE u32 UTF8::numValidBytes(ConstBufferView view) {
+    const u8* cur = view.bytes;
+    const u8* end = view.bytes + view.numBytes;
+    for (;;) {
+        // Skip ASCII 16 bytes at a time
+#if PLY_CPU_X64 || PLY_CPU_X86
+        while (end - cur >= 16) {
+            u32 highBits = (u32) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) cur));
+            if (highBits != 0) {
+                cur += countTrailingZeros(highBits);
+                break;
+            }
+            cur += 16;
+        }
+#elif PLY_CPU_ARM64
+        while (end - cur >= 16 && vmaxvq_u8(vld1q_u8(cur)) < 0x80) {
+            cur += 16;
+        }
+#endif
+        while (cur < end && *cur < 0x80) {
+            cur++;
+        }
+        if (cur >= end)
+            break;
+
+        // Validate one multibyte sequence. lo and hi are the bounds of the second byte, which
+        // exclude overlong sequences, surrogates and points above U+10FFFF.
+        u8 first = *cur;
+        u32 seqLen = 0;
+        u8 lo = 0x80;
+        u8 hi = 0xbf;
+        if (first < 0xc2) {
+            break; // Unexpected continuation byte or overlong 2-byte sequence
+        } else if (first < 0xe0) {
+            seqLen = 2;
+        } else if (first < 0xf0) {
+            seqLen = 3;
+            lo = (first == 0xe0) ? 0xa0 : lo;
+            hi = (first == 0xed) ? 0x9f : hi;
+        } else if (first < 0xf5) {
+            seqLen = 4;
+            lo = (first == 0xf0) ? 0x90 : lo;
+            hi = (first == 0xf4) ? 0x8f : hi;
+        } else {
+            break;
+        }
+        if ((u32)(end - cur) < seqLen || cur[1] < lo || cur[1] > hi)
+            break;
+        if (seqLen >= 3 && (cur[2] & 0xc0) != 0x80)
+            break;
+        if (seqLen >= 4 && (cur[3] & 0xc0) != 0x80)
+            break;
+        cur += seqLen;
+    }
+    return safeDemote<u32>(cur - view.bytes);
+}
+
 PLY_NO_INLINE u32 UTF8::backNumBytesSlowPath(ConstBufferView view) {
     if (view.numBytes == 0) {
         return 0;
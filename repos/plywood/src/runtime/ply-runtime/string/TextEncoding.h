@@ -72,6 +72,10 @@ struct UTF8 {
         return decodePointSlowPath(view);
     }
 
+    // Returns the number of bytes at the start of view that form complete, well-formed UTF-8
+    // sequences. Overlong sequences, surrogates and points above U+10FFFF are not well-formed.
+    static PLY_DLL_ENTRY u32 numValidBytes(ConstBufferView view);
+
     static PLY_DLL_ENTRY u32 backNumBytesSlowPath(ConstBufferView view);
 
     static PLY_INLINE u32 backNumBytes(ConstBufferView view) {
@@ -84,7 +84,7 @@ void Trace_MemLog::dumpEntireLog(const char* path, ureg startPage) {
         ureg limit = ply::min<ureg>(EventsPerPage, page->index.load(ply::Relaxed));
         for (ureg i = 0; i < limit; i++) {
             const Event& evt = page->events[i];
-            sw->format("[{}] {} {} {}\n", (u64) evt.tid, evt.param1, evt.param2, evt.msg);
+            sw->format(PLY_FMT("[{}] {} {} {}\n"), (u64) evt.tid, evt.param1, evt.param2, evt.msg);
         }
     }
 }
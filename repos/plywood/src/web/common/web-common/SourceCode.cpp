@@ -59,8 +59,8 @@ window.onhashchange = function() {
 )#";
     u32 lineNumber = 1;
     while (String line = sr->readString<fmt::Line>()) {
-        sw->format("<tr><td id=\"L{}\">{}</td><td id=\"LC{}\">{}</td></tr>", lineNumber, lineNumber,
-                   lineNumber, fmt::XMLEscape{line});
+        sw->format(PLY_FMT("<tr><td id=\"L{}\">{}</td><td id=\"LC{}\">{}</td></tr>"), lineNumber,
+                   lineNumber, lineNumber, fmt::XMLEscape{line});
         lineNumber++;
     }
     *sw << R"#(</tbody>
@@ -4,6 +4,7 @@
 ------------------------------------*/
 #include <ply-web-cook-docs/Core.h>
 #include <ply-cook/CookJob.h>
+#include <ply-runtime/io/AsyncIO.h>
 
 namespace ply {
 namespace docs {
@@ -35,9 +36,6 @@ void cook_CopyStatic(cook::CookResult* cookResult, TypedPtr) {
         return;
     }
 
-    // Allocate temporary storage
-    Buffer buf = Buffer::allocate(32768);
-
     // Open destination file
     // FIXME: Copy to temporary file first, then rename it
     Owned<OutPipe> outPipe = FileSystem::native()->openPipeForWrite(dstPath);
@@ -47,13 +45,68 @@ void cook_CopyStatic(cook::CookResult* cookResult, TypedPtr) {
         return;
     }
 
-    // Copy in chunks
+    // Allocate temporary storage
+    Buffer bufs[2] = {Buffer::allocate(32768), Buffer::allocate(32768)};
+    AsyncIO aio;
+    aio.registerBuffers({bufs[0].view(), bufs[1].view()});
+
+    // Copy in chunks, reading the next chunk into bufs[w ^ 1] while bufs[w] is being written
+    u32 w = 1;
+    u32 writeOffset = 0;   // Number of bytes in bufs[w] that have been written
+    u32 writeEnd = 0;      // Number of bytes in bufs[w] to write
+    bool readDone = false; // Whether the read into bufs[w ^ 1] has completed
+    u32 numBytesRead = 0;
     for (;;) {
-        u32 numBytes = inPipe->readSome(buf);
-        // FIXME: Distinguish failed read from EOF
-        if (numBytes == 0)
-            break;
-        outPipe->write(buf.view().subView(0, numBytes));
+        u32 numQueued = 0;
+        if (writeOffset < writeEnd) {
+            // A short write leaves bytes behind, so this can be the remainder of an earlier write
+            if (!aio.write(outPipe, bufs[w].view().subView(writeOffset, writeEnd - writeOffset),
+                           outPipe.get())) {
+                cookResult->addError(String::format("unable to queue write to '{}'", dstPath));
+                return;
+            }
+            numQueued++;
+        }
+        if (!readDone) {
+            if (!aio.read(inPipe, bufs[w ^ 1], inPipe.get())) {
+                cookResult->addError(String::format("unable to queue read from '{}'", srcPath));
+                return;
+            }
+            numQueued++;
+        }
+        aio.submit();
+        AsyncIOCompletion completions[2];
+        u32 numCompletions = aio.waitCompletions({completions, numQueued}, numQueued);
+        if (numCompletions != numQueued) {
+            cookResult->addError(String::format("unable to copy '{}'", srcPath));
+            return;
+        }
+        for (u32 c = 0; c < numCompletions; c++) {
+            const AsyncIOCompletion& completion = completions[c];
+            if (completion.result < 0) {
+                // FIXME: add reason
+                if (completion.userData == inPipe.get()) {
+                    cookResult->addError(String::format("unable to read '{}'", srcPath));
+                } else {
+                    cookResult->addError(String::format("unable to write '{}'", dstPath));
+                }
+                return;
+            }
+            if (completion.userData == inPipe.get()) {
+                readDone = true;
+                numBytesRead = (u32) completion.result;
+            } else {
+                writeOffset += (u32) completion.result;
+            }
+        }
+        if (readDone && writeOffset == writeEnd) {
+            if (numBytesRead == 0)
+                break; // End of file
+            w ^= 1;
+            writeOffset = 0;
+            writeEnd = numBytesRead;
+            readDone = false;
+        }
     }
 }
 
@@ -365,6 +365,8 @@ void Page_cook(cook::CookResult* cookResult_, TypedPtr) {
     // Extract liquid tags
     StringWriter sw;
     StringWriter htmlWriter;
+    // The saved page html begins with a single line title header
+    htmlWriter << extractMetaResult->title << '\n';
     Array<String> childPageNames;
     String classScopeText;
     // FIXME: don't hardcode classScope
@@ -471,10 +473,10 @@ void Page_cook(cook::CookResult* cookResult_, TypedPtr) {
         }
     });
 
-    // Save page html with single line title header
+    // Save page html
     // FIXME: Implement strategy to delete orphaned HTML files
     flushMarkdown();
-    String finalHtml = String::format("{}\n", extractMetaResult->title) + htmlWriter.moveToString();
+    ChunkString finalHtml = htmlWriter.moveToChunks();
     PLY_ASSERT(pageResult->job->id.desc.startsWith("/"));
     String htmlPath = NativePath::join(PLY_WORKSPACE_FOLDER, "data/docsite/pages",
                                        pageResult->job->id.desc.subStr(1) + ".html");
@@ -19,7 +19,8 @@ void StyleSheet_cook(cook::CookResult* cookResult, TypedPtr) {
     PLY_UNUSED(fdScope);
 
     // FIXME: Get names of any included files, too!
-    web::SassResult result = web::convertSassToStylesheet(filePath.withNullTerminator().bytes);
+    web::SassResult result =
+        web::convertSassToStylesheet(filePath.withNullTerminator().view().bytes);
     int error_status = sass_context_get_error_status((Sass_Context*) result.context);
     if (error_status != 0) {
         StringView errorMessage = sass_context_get_error_message((Sass_Context*) result.context);
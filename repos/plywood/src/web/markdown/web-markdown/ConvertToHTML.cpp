@@ -20,7 +20,7 @@ void convertToHTML(StringWriter* sw, const Node* node) {
         case Node::List: {
             if (node->isOrderedList()) {
                 if (node->listStartNumber != 1) {
-                    sw->format("<ol start=\"{}\">\n", node->listStartNumber);
+                    sw->format(PLY_FMT("<ol start=\"{}\">\n"), node->listStartNumber);
                 } else {
                     *sw << "<ol>\n";
                 }
@@ -65,16 +65,16 @@ void convertToHTML(StringWriter* sw, const Node* node) {
             break;
         }
         case Node::Heading: {
-            sw->format("<h{}", node->indentOrLevel);
+            sw->format(PLY_FMT("<h{}"), node->indentOrLevel);
             if (node->id) {
-                sw->format(" id=\"{}\"", fmt::XMLEscape{node->id});
+                sw->format(PLY_FMT(" id=\"{}\""), fmt::XMLEscape{node->id});
             }
             *sw << '>';
             PLY_ASSERT(node->rawLines.isEmpty());
             for (const Node* child : node->children) {
                 convertToHTML(sw, child);
             }
-            sw->format("</h{}>\n", node->indentOrLevel);
+            sw->format(PLY_FMT("</h{}>\n"), node->indentOrLevel);
             break;
         }
         case Node::Paragraph: {
@@ -107,7 +107,7 @@ void convertToHTML(StringWriter* sw, const Node* node) {
             break;
         }
         case Node::Link: {
-            sw->format("<a href=\"{}\">", fmt::XMLEscape{node->text});
+            sw->format(PLY_FMT("<a href=\"{}\">"), fmt::XMLEscape{node->text});
             for (const Node* child : node->children) {
                 convertToHTML(sw, child);
             }
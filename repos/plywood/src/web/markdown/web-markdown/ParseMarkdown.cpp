@@ -615,16 +615,17 @@ Array<Owned<Node>> processEmphasis(Array<Delimiter>& delimiters, u32 bottomPos)
             for (u32 j = pos; j > openerPos;) {
                 --j;
                 if (delimiters[j].type == type && delimiters[j].leftFlanking) {
-                    u32 spanLength =
-                        min(delimiters[j].text.numBytes, delimiters[pos].text.numBytes);
+                    u32 spanLength = min(delimiters[j].text.view().numBytes,
+                                         delimiters[pos].text.view().numBytes);
                     PLY_ASSERT(spanLength > 0);
                     Owned<Node> elem =
                         new Node{nullptr, spanLength >= 2 ? Node::Strong : Node::Emphasis};
                     elem->addChildren(
                         convertToInlineElems(delimiters.subView(j + 1, pos - j - 1)).view());
                     u32 delimsToSubtract = min(spanLength, 2u);
-                    delimiters[j].text.numBytes -= delimsToSubtract;
-                    delimiters[pos].text.numBytes -= delimsToSubtract;
+                    delimiters[j].text = delimiters[j].text.view().shortenedBy(delimsToSubtract);
+                    delimiters[pos].text =
+                        delimiters[pos].text.view().shortenedBy(delimsToSubtract);
                     // We're going to delete from j to pos inclusive, so leave remaining delimiters
                     // if any
                     if (!delimiters[j].text.view().isEmpty()) {